@@ -161,27 +161,6 @@ void FGenericStructCustomization::OnVarTypeChanged(const FEdGraphPinType& NewPin
 	ForceRebuildDetails();
 }
 
-uint32 GetTypeHash(const FEdGraphPinType& Struct)
-{
-	return HashCombine(
-		HashCombine(
-			HashCombine(
-				HashCombine(GetTypeHash(Struct.PinCategory), GetTypeHash(Struct.PinSubCategory)),
-				HashCombine(GetTypeHash(Struct.PinSubCategoryObject.Get()), GetTypeHash(Struct.PinSubCategoryMemberReference.MemberGuid))
-			),
-			HashCombine(
-				GetTypeHash((int32)Struct.ContainerType),
-				GetTypeHash(((int32)Struct.bIsReference) | ((int32)Struct.bIsConst << 1) | ((int32)Struct.bIsWeakPointer << 2) | ((int32)Struct.bIsUObjectWrapper << 3))
-			)
-		),
-		HashCombine(
-			HashCombine(GetTypeHash(Struct.PinValueType.TerminalCategory), GetTypeHash(Struct.PinValueType.TerminalSubCategory)),
-			HashCombine(GetTypeHash(Struct.PinValueType.TerminalSubCategoryObject.Get()),
-				GetTypeHash(((int32)Struct.PinValueType.bTerminalIsConst) | ((int32)Struct.PinValueType.bTerminalIsWeakPointer << 1) | ((int32)Struct.PinValueType.bTerminalIsUObjectWrapper << 2)))
-		)
-	);
-}
-
 void FGenericStructCustomization::ForceRebuildDetails()
 {
 	if (LastChildBuilder && LastChildBuilder->GetParentCategory().IsParentLayoutValid())
@@ -222,54 +201,43 @@ void FGenericStructCustomization::CreateChildrenInternal(IDetailChildrenBuilder&
 
 	FProperty* EditProperty = nullptr;
 	const FName EditPropertyName = FName("Value");
-	UUserDefinedStruct*& EditorStruct = LeadGenericVar.EditorStruct;
+	UUserDefinedStruct* EditorStruct = nullptr;
 	TArray<FStructVariableDescription> StructLayout;
 
-	auto TryRetrieveEditProperty = [&]()
+	// Auxiliary structs are shared by every customization editing the same pin type
+	static TMap<FEdGraphPinType, TWeakObjectPtr<UUserDefinedStruct>> StructCache;
+	if (auto* CachedStruct = StructCache.Find(TargetPinType))
+	{
+		EditorStruct = CachedStruct->Get();
+		if (EditorStruct)
 		{
-			if (EditorStruct)
-			{
-				StructLayout = FStructureEditorUtils::GetVarDesc(EditorStruct);
-				EditProperty = EditorStruct->PropertyLink;
-			}
-		};
-
-	TryRetrieveEditProperty();
+			StructLayout = FStructureEditorUtils::GetVarDesc(EditorStruct);
+			EditProperty = EditorStruct->PropertyLink;
+		}
+	}
 
 	// Check if we need to regenerate the struct property
 	if (EditProperty == nullptr
 		|| StructLayout.Num() != 1
 		|| !IsEquivalent(StructLayout[0], TargetPinType))
 	{
-		EditorStruct = nullptr;
-		EditProperty = nullptr;
-		StructLayout.Reset();
-
-		static TMap<FEdGraphPinType, TWeakObjectPtr<UUserDefinedStruct>> StructCache;
-		if (auto* CachedStruct = StructCache.Find(TargetPinType))
-		{
-			EditorStruct = CachedStruct->Get();
-			TryRetrieveEditProperty();
-		}
-
-		if (EditProperty == nullptr)
-		{
-			EditorStruct = FStructureEditorUtils::CreateUserDefinedStruct(
-				GetTransientPackage(),
-				(FName)*FString::Printf(TEXT("GENERIC_DUMMY_%s"), *FGuid::NewGuid().ToString(EGuidFormats::Base36Encoded)),
-				EObjectFlags::RF_Transient
-			);
-			EditorStruct->SetMetaData(FBlueprintMetadata::MD_NotAllowableBlueprintVariableType, TEXT("true"));
-			// We don't need to call FStructureEditorUtils::AddVariable since there's already a default var in the field.
-			StructLayout = FStructureEditorUtils::GetVarDesc(EditorStruct);
-			FStructureEditorUtils::ChangeVariableType(EditorStruct, StructLayout[0].VarGuid, TargetPinType);
-			FStructureEditorUtils::RenameVariable(EditorStruct, StructLayout[0].VarGuid, EditPropertyName.ToString());
-			EditProperty = EditorStruct->PropertyLink;
-
-			StructCache.Add(TargetPinType, EditorStruct);
-		}
+		EditorStruct = FStructureEditorUtils::CreateUserDefinedStruct(
+			GetTransientPackage(),
+			(FName)*FString::Printf(TEXT("GENERIC_DUMMY_%s"), *FGuid::NewGuid().ToString(EGuidFormats::Base36Encoded)),
+			EObjectFlags::RF_Transient
+		);
+		EditorStruct->SetMetaData(FBlueprintMetadata::MD_NotAllowableBlueprintVariableType, TEXT("true"));
+		// We don't need to call FStructureEditorUtils::AddVariable since there's already a default var in the field.
+		StructLayout = FStructureEditorUtils::GetVarDesc(EditorStruct);
+		FStructureEditorUtils::ChangeVariableType(EditorStruct, StructLayout[0].VarGuid, TargetPinType);
+		FStructureEditorUtils::RenameVariable(EditorStruct, StructLayout[0].VarGuid, EditPropertyName.ToString());
+		EditProperty = EditorStruct->PropertyLink;
+
+		StructCache.Add(TargetPinType, EditorStruct);
 	}
 
+	EditedStruct.Reset(EditorStruct);
+
 	// Generate an instance struct for reflection
 	if (EditorStruct && ensure(EditProperty))
 	{
@@ -293,6 +261,8 @@ void FGenericStructCustomization::CreateChildrenInternal(IDetailChildrenBuilder&
 			{
 				check(EditProperty && StructOnScope->GetStructMemory());
 				LeadGenericVar.Set(StructOnScope->GetStructMemory(), EditProperty);
+				// Edited values live in assets, the copies below share the interned payload
+				LeadGenericVar.Intern();
 				for (void* Data : RawData)
 				{
 					if (Data == &LeadGenericVar) continue;
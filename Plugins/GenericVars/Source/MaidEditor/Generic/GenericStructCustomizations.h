@@ -7,6 +7,7 @@
 #include "SGraphPin.h"
 #include "IDetailPropertyRow.h"
 #include "Generic/Generic.h"
+#include "UObject/StrongObjectPtr.h"
 
 class MAIDEDITOR_API FGenericStructCustomization : public IStructCustomization
 {
@@ -28,4 +29,7 @@ private:
 	void CreateChildrenInternal(IDetailChildrenBuilder& ChildBuilder);
 
 	FDelegateHandle UndoHandle;
+
+	/** Auxiliary struct describing the edited value, kept alive while it is displayed */
+	TStrongObjectPtr<UUserDefinedStruct> EditedStruct;
 };
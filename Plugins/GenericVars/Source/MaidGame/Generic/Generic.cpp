@@ -1,55 +1,209 @@
 // Copyright Liquid Fish. All Rights Reserved.
 
 #include "Generic/Generic.h"
+#include "Generic/GenericInternPool.h"
+#include "Generic/GenericArena.h"
+#include "Generic/GenericNested.h"
+#include "Generic/GenericFieldPath.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/StructOnScope.h"
 
-#if WITH_EDITOR
-#include "EdGraphSchema_K2.h"
+#if UE_VERSION_NEWER_THAN(5, 0, 0)
+LLM_DEFINE_TAG(GenericVars);
 #endif
 
 const FGeneric FGeneric::Null = FGeneric();
 
+#if GENERIC_ALLOC_TRACKING
+static thread_local FGenericAllocCounts GGenericThreadAllocCounts;
+
+FGeneric::FAllocProbe::FAllocProbe(const FGeneric& InOwner, int32 FGenericAllocCounts::* InCounter, const FGeneric* InSource)
+	: Owner(InOwner)
+	, Counter(InCounter)
+{
+	Capture(Owner, Buffers);
+	if (InSource)
+	{
+		Capture(*InSource, SourceBuffers);
+	}
+	else
+	{
+		FMemory::Memzero(SourceBuffers);
+	}
+}
+
+FGeneric::FAllocProbe::~FAllocProbe()
+{
+	const void* NewBuffers[NumBuffers];
+	Capture(Owner, NewBuffers);
+	for (int32 i = 0; i < NumBuffers; ++i)
+	{
+		if (NewBuffers[i] && NewBuffers[i] != Buffers[i] && NewBuffers[i] != SourceBuffers[i])
+		{
+			++(GGenericThreadAllocCounts.*Counter);
+		}
+	}
+}
+
+void FGeneric::FAllocProbe::Capture(const FGeneric& Generic, const void* (&OutBuffers)[NumBuffers])
+{
+	OutBuffers[0] = Generic.PlainData.GetData();
+	OutBuffers[1] = Generic.Data.GetCharArray().GetData();
+#if WITH_EDITORONLY_DATA
+	OutBuffers[2] = Generic.ReferencedObjects.GetData();
+#else
+	OutBuffers[2] = nullptr;
+#endif
+#if GENERIC_USING_CACHE
+	const FDataCache* Cache = Generic.FindDataCache();
+	OutBuffers[3] = Cache;
+	OutBuffers[4] = Cache && Cache->ArenaEpoch == 0 ? Cache->Storage : nullptr;
+#else
+	OutBuffers[3] = nullptr;
+	OutBuffers[4] = nullptr;
+#endif
+}
+#endif
+
+FGenericAllocCounts FGeneric::GetThreadAllocCounts()
+{
+#if GENERIC_ALLOC_TRACKING
+	return GGenericThreadAllocCounts;
+#else
+	return FGenericAllocCounts();
+#endif
+}
+
 void FGeneric::Set(const void* SrcPropertyAddress, const FProperty* SrcProperty)
 {
+	GENERIC_MEMORY_SCOPE(Set, nullptr);
+	GENERIC_TRACE_SCOPE(Set);
+	GENERIC_TRACE_TYPE_SCOPE(Set, SrcProperty);
+	if (SrcProperty && SrcPropertyAddress && ValueProperty && IsSameType(SrcProperty, ValueProperty))
+	{
+		Overwrite(SrcPropertyAddress, SrcProperty);
+		return;
+	}
+
 	Clear();
 	if (!(SrcProperty && SrcPropertyAddress)) return;
-	if (IsPlain(SrcProperty))
+	ValueProperty = IsPersistentProperty(SrcProperty) ? SrcProperty : nullptr;
+	if (IsPackedArgs(SrcProperty))
+	{
+		// Clear kept the plain data buffer, the packed bytes are copied without export
+		PlainData.Append(static_cast<const FGenericArgs*>(SrcPropertyAddress)->GetBuffer());
+#if WITH_EDITORONLY_DATA && WITH_EDITOR
+		SetEditPinType(SrcProperty);
+#endif
+	}
+	else if (IsNested(SrcProperty))
+	{
+		SetNested(SrcPropertyAddress, SrcProperty);
+#if WITH_EDITORONLY_DATA && WITH_EDITOR
+		SetEditPinType(SrcProperty);
+#endif
+	}
+	else if (IsPlain(SrcProperty))
 	{
 		SetPlainSize(SrcProperty->GetSize());
 		SrcProperty->CopyCompleteValue(PlainData.GetData(), SrcPropertyAddress);
 #if WITH_EDITORONLY_DATA && WITH_EDITOR
-		const UEdGraphSchema_K2* K2Schema = GetDefault<UEdGraphSchema_K2>();
-		K2Schema->ConvertPropertyToPinType(SrcProperty, EditPinType);
+		SetEditPinType(SrcProperty);
 #endif
 	}
 	else
 	{
 		FString ExportedText;
-		SrcProperty->ExportText_Direct(ExportedText, SrcPropertyAddress, 
-			/*Src as delta to force full export*/ SrcPropertyAddress, nullptr, PPF_None);
+		{
+			GENERIC_TRACE_SCOPE(ExportText);
+			SrcProperty->ExportText_Direct(ExportedText, SrcPropertyAddress, 
+				/*Src as delta to force full export*/ SrcPropertyAddress, nullptr, PPF_None);
+		}
 #if WITH_EDITORONLY_DATA && WITH_EDITOR
 		if (ExportedText != Data)
 #endif
 		{
 			Data = MoveTemp(ExportedText);
 #if WITH_EDITORONLY_DATA && WITH_EDITOR
-			const UEdGraphSchema_K2* K2Schema = GetDefault<UEdGraphSchema_K2>();
-			K2Schema->ConvertPropertyToPinType(SrcProperty, EditPinType);
+			SetEditPinType(SrcProperty);
+#endif
+		}
+#if WITH_EDITOR
+		CacheReferencedObjects(SrcProperty, SrcPropertyAddress);
+#endif
+
+#if GENERIC_USING_CACHE
+		// Only values with a persistent property are cached, see FDataCache::Set
+		if (ValueProperty)
+		{
+			GetDataCache().Set(SrcPropertyAddress, SrcProperty);
+		}
 #endif
+	}
+	GENERIC_STATS_RECORD_SET(SrcProperty, GetPayloadSize());
+}
+
+void FGeneric::Overwrite(const void* SrcPropertyAddress, const FProperty* SrcProperty)
+{
+	// The pin type is unchanged and the storage already has the right shape, only the value is replaced
+	++Version;
+	const bool bWasInterned = IsInterned();
+	Payload.SetInterned(nullptr);
+	if (IsPackedArgs(SrcProperty))
+	{
+		PlainData.Reset();
+		PlainData.Append(static_cast<const FGenericArgs*>(SrcPropertyAddress)->GetBuffer());
+	}
+	else if (IsNested(SrcProperty))
+	{
+		SetNested(SrcPropertyAddress, SrcProperty);
+	}
+	else if (IsPlain(SrcProperty))
+	{
+		if (bWasInterned || PlainData.Num() * PlainData.GetTypeSize() < SrcProperty->GetSize())
+		{
+			SetPlainSize(SrcProperty->GetSize());
+		}
+		SrcProperty->CopyCompleteValue(PlainData.GetData(), SrcPropertyAddress);
+	}
+	else
+	{
+		// Reset keeps the text buffer, so exporting a value of similar length does not reallocate
+		Data.Reset();
+		{
+			GENERIC_TRACE_SCOPE(ExportText);
+			SrcProperty->ExportText_Direct(Data, SrcPropertyAddress,
+				/*Src as delta to force full export*/ SrcPropertyAddress, nullptr, PPF_None);
 		}
 #if WITH_EDITOR
 		CacheReferencedObjects(SrcProperty, SrcPropertyAddress);
 #endif
 
 #if GENERIC_USING_CACHE
-		DataCache.Set(SrcPropertyAddress, SrcProperty);
+		GetDataCache().Overwrite(SrcPropertyAddress, SrcProperty);
 #endif
 	}
+	GENERIC_STATS_RECORD_SET(SrcProperty, GetPayloadSize());
 }
 
 void FGeneric::Get(void* DestPropertyAddress, const FProperty* DestProperty) const
 {
+	GENERIC_MEMORY_SCOPE(Get, nullptr);
+	GENERIC_TRACE_SCOPE(Get);
+	GENERIC_TRACE_TYPE_SCOPE(Get, DestProperty);
 	if (!(DestPropertyAddress && DestProperty)) return;
-	if (IsPlain(DestProperty))
+	if (IsPackedArgs(DestProperty))
+	{
+		static_cast<FGenericArgs*>(DestPropertyAddress)->SetBuffer((const uint8*)GetPlainData(), GetPlainSize());
+		GENERIC_STATS_RECORD_GET(DestProperty, 0, EGenericCacheResult::None);
+	}
+	else if (IsNested(DestProperty) && GetNested(DestPropertyAddress, DestProperty))
+	{
+		// Generics nested before they were stored as records are still exported text, read below
+		GENERIC_STATS_RECORD_GET(DestProperty, 0, EGenericCacheResult::None);
+	}
+	else if (IsPlain(DestProperty))
 	{
 		static constexpr const auto CASTCLASS_FInt32Property = CASTCLASS_FIntProperty;
 		static constexpr const auto CASTCLASS_FUInt8Property = CASTCLASS_FByteProperty;
@@ -75,48 +229,554 @@ void FGeneric::Get(void* DestPropertyAddress, const FProperty* DestProperty) con
 #pragma pop_macro("GENERIC_PROPERTY_FLOAT")
 #pragma pop_macro("GENERIC_PROPERTY_INT")
 		else if (GetPlainSize() >= DestProperty->GetSize())
-			DestProperty->CopyCompleteValue(DestPropertyAddress, PlainData.GetData());
+			DestProperty->CopyCompleteValue(DestPropertyAddress, GetPlainData());
 		else
 			DestProperty->ClearValue(DestPropertyAddress);
+		GENERIC_STATS_RECORD_GET(DestProperty, 0, EGenericCacheResult::None);
 	}
 	else
 	{
 #if GENERIC_USING_CACHE
-		if (DataCache.ConditionalGet(DestPropertyAddress, DestProperty)) return;
+		if (const FDataCache* Cache = FindDataCache(); Cache && Cache->ConditionalGet(DestPropertyAddress, DestProperty))
+		{
+			GENERIC_STAT_INC(CacheHits);
+			GENERIC_STATS_RECORD_GET(DestProperty, 0, EGenericCacheResult::Hit);
+			return;
+		}
+		GENERIC_STAT_INC(CacheMisses);
 #endif
 		DestProperty->ClearValue(DestPropertyAddress);
-		if (!Data.IsEmpty())
+		const FString& Text = GetStringData();
+		if (!Text.IsEmpty())
 		{
+			GENERIC_TRACE_SCOPE(ImportText);
 #if UE_VERSION_NEWER_THAN(5, 1, 0)
-			DestProperty->ImportText_Direct(*Data, DestPropertyAddress, nullptr, PPF_None, nullptr);
+			DestProperty->ImportText_Direct(*Text, DestPropertyAddress, nullptr, PPF_None, nullptr);
 #else
-			DestProperty->ImportText(*Data, DestPropertyAddress, PPF_None, nullptr, nullptr);
+			DestProperty->ImportText(*Text, DestPropertyAddress, PPF_None, nullptr, nullptr);
 #endif
 		}
 		else
 		{
 			DestProperty->InitializeValue(DestPropertyAddress);
 		}
+#if GENERIC_USING_CACHE
+		GENERIC_STATS_RECORD_GET(DestProperty, Text.Len() * sizeof(TCHAR), EGenericCacheResult::Miss);
+#else
+		GENERIC_STATS_RECORD_GET(DestProperty, Text.Len() * sizeof(TCHAR), EGenericCacheResult::None);
+#endif
 	}
 }
 
 void FGeneric::Clear()
 {
 #if WITH_EDITORONLY_DATA
-	EditPinType = FEdGraphPinType();
+	EditPinType.Reset();
 #endif
 	Data.Reset();
 	PlainData.Reset();
+	Payload.SetInterned(nullptr);
+	ValueProperty = nullptr;
+	++Version;
 #if GENERIC_USING_CACHE
-	DataCache.Clear();
+	if (FDataCache* Cache = FindDataCache()) Cache->Clear();
 #endif
 #if WITH_EDITOR
 	ClearReferencedObjects();
 #endif
 }
 
+void FGeneric::Intern()
+{
+	if (IsInterned() || !FGenericInternPool::IsEnabled()) return;
+	if (Data.Len() * sizeof(TCHAR) + PlainData.Num() < (SIZE_T)FGenericInternPool::GetMinPayloadSize()) return;
+
+	Payload.SetInterned(FGenericInternPool::Get().Intern(Data, PlainData));
+	Data.Empty();
+	PlainData.Empty();
+}
+
+void FGeneric::Detach()
+{
+	const FGenericSharedPayload* Shared = GetInterned();
+	if (!Shared) return;
+	GENERIC_LLM_SCOPE();
+	Data = Shared->Data;
+	PlainData = Shared->PlainData;
+	Payload.SetInterned(nullptr);
+}
+
+bool FGeneric::Serialize(FArchive& Ar)
+{
+	// Tagged serialization only sees Data and PlainData, so materialize a shared payload first
+	if (Ar.IsLoading() || Ar.IsSaving())
+	{
+		Detach();
+	}
+	if (Ar.IsSaving() && Ar.IsPersistent())
+	{
+		ensureMsgf(!FGenericArgsView(*this).IsValid(), TEXT("FGeneric: packed arguments hold runtime name and object handles and are not meant to be saved"));
+	}
+	if (Ar.IsLoading())
+	{
+		ValueProperty = nullptr;
+		++Version;
+#if GENERIC_USING_CACHE
+		if (FDataCache* Cache = FindDataCache()) Cache->Clear();
+#endif
+	}
+	return false;
+}
+
+void FGeneric::PostSerialize(const FArchive& Ar)
+{
+	// Loading and saving are the asset boundaries, saving shares again what Serialize detached
+	if (Ar.IsLoading() || Ar.IsSaving())
+	{
+		Intern();
+	}
+}
+
+const void* FGeneric::FindCachedValue(const FProperty* Property) const
+{
+#if GENERIC_USING_CACHE
+	if (const FDataCache* Cache = FindDataCache())
+	{
+		return Cache->FindValue(Property);
+	}
+#endif
+	return nullptr;
+}
+
+SIZE_T FGeneric::GetAllocatedSize() const
+{
+	SIZE_T Size = Data.GetAllocatedSize() + PlainData.GetAllocatedSize();
+#if WITH_EDITORONLY_DATA
+	Size += ReferencedObjects.GetAllocatedSize();
+#endif
+#if GENERIC_USING_CACHE
+	if (const FDataCache* Cache = FindDataCache())
+	{
+		Size += sizeof(FDataCache) + Cache->GetAllocatedSize();
+	}
+#endif
+	return Size;
+}
+
+void FGeneric::FPayloadSlot::SetInterned(FGenericSharedPayload* InInterned)
+{
+#if GENERIC_USING_CACHE
+	if (FDataCache* Cache = GetCache())
+	{
+		Cache->Interned = InInterned;
+		return;
+	}
+#endif
+	if (InInterned) InInterned->AddRef();
+	if (FGenericSharedPayload* Previous = reinterpret_cast<FGenericSharedPayload*>(Bits)) Previous->Release();
+	Bits = reinterpret_cast<UPTRINT>(InInterned);
+}
+
+void FGeneric::FPayloadSlot::Reset()
+{
+#if GENERIC_USING_CACHE
+	if (FDataCache* Cache = GetCache())
+	{
+		delete Cache;
+		Bits = 0;
+		return;
+	}
+#endif
+	SetInterned(nullptr);
+}
+
+#if GENERIC_USING_CACHE
+FGeneric::FDataCache& FGeneric::GetDataCache()
+{
+	return Payload.GetOrCreateCache();
+}
+
+void FGeneric::AssignDataCache(const FGeneric& Other)
+{
+	// Only arena caches survive a copy, avoid creating a cache object just to leave it empty
+	const FDataCache* OtherCache = Other.FindDataCache();
+	if (OtherCache && OtherCache->ArenaEpoch != 0)
+	{
+		GetDataCache().Assign(*OtherCache);
+	}
+	else if (FDataCache* Cache = FindDataCache())
+	{
+		Cache->Clear();
+	}
+}
+
+void FGeneric::AssignDataCache(FGeneric&& Other)
+{
+	FDataCache* OtherCache = Other.FindDataCache();
+	if (!OtherCache)
+	{
+		if (FDataCache* Cache = FindDataCache()) Cache->Clear();
+	}
+	else if (!FindDataCache() && OtherCache->ArenaEpoch == 0)
+	{
+		Payload.StealCache(Other.Payload);
+	}
+	else
+	{
+		GetDataCache().Assign(MoveTemp(*OtherCache));
+	}
+}
+
+FGeneric::FDataCache& FGeneric::FPayloadSlot::GetOrCreateCache()
+{
+	if (FDataCache* Cache = GetCache()) return *Cache;
+
+	// The cache takes over the reference to the payload held by the slot
+	FDataCache* Cache = new FDataCache();
+	Cache->Interned = reinterpret_cast<FGenericSharedPayload*>(Bits);
+	if (Cache->Interned) Cache->Interned->Release();
+	Bits = reinterpret_cast<UPTRINT>(Cache) | CacheTag;
+	return *Cache;
+}
+
+void FGeneric::FPayloadSlot::StealCache(FPayloadSlot& Other)
+{
+	check(!GetCache() && Other.GetCache());
+	FDataCache* Cache = Other.GetCache();
+	FGenericSharedPayload* OwnPayload = reinterpret_cast<FGenericSharedPayload*>(Bits);
+
+	// Other keeps the payload the cache held, the cache now holds ours
+	Other.Bits = reinterpret_cast<UPTRINT>(Cache->Interned.GetReference());
+	if (Other.Bits) Cache->Interned->AddRef();
+	Cache->Interned = OwnPayload;
+	if (OwnPayload) OwnPayload->Release();
+	Bits = reinterpret_cast<UPTRINT>(Cache) | CacheTag;
+}
+
+bool FGeneric::FDataCache::IsAccessible() const
+{
+	return ArenaEpoch == 0 || ArenaEpoch == FGenericArena::GetActiveEpoch();
+}
+
+void FGeneric::FDataCache::Forget()
+{
+	// Arena storage of a closed scope was already destroyed and rewound by the arena
+	Prop = nullptr;
+	Storage = nullptr;
+	Capacity = 0;
+	ArenaEpoch = 0;
+	ArenaRecord = INDEX_NONE;
+}
+
+void FGeneric::FDataCache::Free()
+{
+	if (ArenaEpoch == 0 && Storage)
+	{
+		FMemory::Free(Storage);
+	}
+	Forget();
+}
+
+void FGeneric::FDataCache::Clear()
+{
+	if (!IsAccessible())
+	{
+		Forget();
+		return;
+	}
+	if (Prop)
+	{
+		Prop->DestroyValue(Storage);
+		if (ArenaEpoch != 0)
+		{
+			FGenericArena::GetActive()->ReleaseValue(ArenaRecord);
+			ArenaRecord = INDEX_NONE;
+		}
+		Prop = nullptr;
+	}
+}
+
+void FGeneric::FDataCache::Reserve(int32 Size, int32 Alignment, bool bAllowArena)
+{
+	Size = FMath::Max(Size, 1);
+	if (Storage && Capacity >= Size && IsAligned(Storage, Alignment) && (bAllowArena || ArenaEpoch == 0)) return;
+	GENERIC_LLM_SCOPE();
+
+	Free();
+	if (FGenericArena* Arena = bAllowArena ? FGenericArena::GetActive() : nullptr)
+	{
+		if (void* ArenaStorage = Arena->Allocate(Size, Alignment))
+		{
+			Storage = (uint8*)ArenaStorage;
+			Capacity = Size;
+			ArenaEpoch = FGenericArena::GetActiveEpoch();
+			return;
+		}
+	}
+	Storage = (uint8*)FMemory::Malloc(Size, Alignment);
+	Capacity = Size;
+}
+
+void FGeneric::FDataCache::Set(const void* SrcPropertyAddress, const FProperty* SrcProperty, bool bAllowArena)
+{
+	Clear();
+	if (!IsPersistentProperty(SrcProperty)) return;
+
+	Reserve(SrcProperty->GetSize(), SrcProperty->GetMinAlignment(), bAllowArena);
+	SrcProperty->InitializeValue(Storage);
+	if (SrcPropertyAddress)
+	{
+		SrcProperty->CopyCompleteValue(Storage, SrcPropertyAddress);
+	}
+	Prop = SrcProperty;
+	if (ArenaEpoch != 0)
+	{
+		ArenaRecord = FGenericArena::GetActive()->RegisterValue(Prop, Storage);
+	}
+}
+
+void FGeneric::FDataCache::Overwrite(const void* SrcPropertyAddress, const FProperty* SrcProperty)
+{
+	if (Prop && IsAccessible() && IsSameType(Prop, SrcProperty))
+	{
+		// Assignment reuses the allocations held by the cached value (string buffers, array storage)
+		Prop->CopyCompleteValue(Storage, SrcPropertyAddress);
+		return;
+	}
+	Set(SrcPropertyAddress, SrcProperty);
+}
+
+bool FGeneric::FDataCache::ConditionalGet(void* DestPropertyAddress, const FProperty* DestProperty) const
+{
+	if (Prop && DestPropertyAddress && DestProperty && IsAccessible() && DestProperty->SameType(Prop) && Capacity >= DestProperty->GetSize())
+	{
+		DestProperty->CopyCompleteValue(DestPropertyAddress, Storage);
+		return true;
+	}
+	return false;
+}
+
+const uint8* FGeneric::FDataCache::FindValue(const FProperty* Property) const
+{
+	return Prop && IsAccessible() && IsSameType(Prop, Property) ? Storage : nullptr;
+}
+
+uint8* FGeneric::FDataCache::FindStruct(const UScriptStruct* Struct) const
+{
+	const FStructProperty* StructProp = CastField<FStructProperty>(Prop);
+	return StructProp && StructProp->Struct == Struct && IsAccessible() ? Storage : nullptr;
+}
+
+void FGeneric::FDataCache::Assign(const FDataCache& Other)
+{
+	Clear();
+	if (Other.ArenaEpoch != 0 && Other.Prop && Other.IsAccessible())
+	{
+		// Copies are how values leave the scope, so the copy never takes arena storage
+		Set(Other.Storage, Other.Prop, false);
+	}
+}
+
+void FGeneric::FDataCache::Assign(FDataCache&& Other)
+{
+	if (Other.ArenaEpoch != 0)
+	{
+		Assign(static_cast<const FDataCache&>(Other));
+		return;
+	}
+	Clear();
+	Free();
+	Prop = Other.Prop;
+	Storage = Other.Storage;
+	Capacity = Other.Capacity;
+	Other.Forget();
+}
+#endif
+
+bool FGeneric::IsSameType(const FProperty* A, const FProperty* B)
+{
+	return A == B || (A && B && A->SameType(B) && A->GetSize() == B->GetSize());
+}
+
+bool FGeneric::IsPersistentProperty(const FProperty* Prop)
+{
+	const UObject* Owner = Prop ? Prop->GetOwnerUObject() : nullptr;
+	return Owner && Owner->GetOutermost()->HasAnyPackageFlags(PKG_CompiledIn);
+}
+
+bool FGeneric::IsPackedArgs(const FProperty* Prop)
+{
+	const FStructProperty* StructProp = CastField<FStructProperty>(Prop);
+	return StructProp && StructProp->Struct == FGenericArgs::StaticStruct();
+}
+
+bool FGeneric::GetField(const FGenericFieldPath& Path, void* DestPropertyAddress, const FProperty* DestProperty) const
+{
+	GENERIC_MEMORY_SCOPE(Get, nullptr);
+	GENERIC_TRACE_SCOPE(GetField);
+	if (!(Path.IsValid() && DestPropertyAddress && DestProperty && MayHoldStruct(Path.GetStruct()))) return false;
+
+	const UScriptStruct* Struct = Path.GetStruct();
+	if (IsPlainStruct(Struct))
+	{
+		if (GetPlainSize() < Struct->GetStructureSize()) return false;
+		GENERIC_STATS_RECORD_GET(Path.GetProperty(), 0, EGenericCacheResult::None);
+		return FGenericFieldPath::CopyValue(DestPropertyAddress, DestProperty, Path.GetFieldAddress(GetPlainData()), Path.GetProperty());
+	}
+
+	const FString& Text = GetStringData();
+	if (Text.IsEmpty()) return false;
+#if GENERIC_USING_CACHE
+	const FDataCache* Cache = FindDataCache();
+	if (const uint8* Cached = Cache ? Cache->FindStruct(Struct) : nullptr)
+	{
+		GENERIC_STAT_INC(CacheHits);
+		GENERIC_STATS_RECORD_GET(Path.GetProperty(), 0, EGenericCacheResult::Hit);
+		return FGenericFieldPath::CopyValue(DestPropertyAddress, DestProperty, Path.GetFieldAddress(Cached), Path.GetProperty());
+	}
+	GENERIC_STAT_INC(CacheMisses);
+#endif
+
+	// Get never writes the cache, the struct is decoded into a temporary
+	FStructOnScope Value(Struct);
+	{
+		GENERIC_TRACE_SCOPE(ImportText);
+		Struct->ImportText(*Text, Value.GetStructMemory(), nullptr, 0, nullptr, Struct->GetName());
+	}
+#if GENERIC_USING_CACHE
+	GENERIC_STATS_RECORD_GET(Path.GetProperty(), Text.Len() * sizeof(TCHAR), EGenericCacheResult::Miss);
+#else
+	GENERIC_STATS_RECORD_GET(Path.GetProperty(), Text.Len() * sizeof(TCHAR), EGenericCacheResult::None);
+#endif
+	return FGenericFieldPath::CopyValue(DestPropertyAddress, DestProperty, Path.GetFieldAddress(Value.GetStructMemory()), Path.GetProperty());
+}
+
+bool FGeneric::SetField(const FGenericFieldPath& Path, const void* SrcPropertyAddress, const FProperty* SrcProperty)
+{
+	GENERIC_MEMORY_SCOPE(Set, nullptr);
+	GENERIC_TRACE_SCOPE(SetField);
+	if (!(Path.IsValid() && SrcPropertyAddress && SrcProperty && MayHoldStruct(Path.GetStruct()))) return false;
+
+	const UScriptStruct* Struct = Path.GetStruct();
+	if (IsPlainStruct(Struct))
+	{
+		if (GetPlainSize() < Struct->GetStructureSize()) return false;
+		Detach();
+		++Version;
+		const bool bCopied = FGenericFieldPath::CopyValue(Path.GetFieldAddress(PlainData.GetData()), Path.GetProperty(), SrcPropertyAddress, SrcProperty);
+		GENERIC_STATS_RECORD_SET(Path.GetProperty(), GetPayloadSize());
+		return bCopied;
+	}
+
+	if (GetStringData().IsEmpty()) return false;
+#if GENERIC_USING_CACHE
+	// Patch the decoded cache when it holds the struct, so later reads keep hitting it
+	FDataCache* Cache = FindDataCache();
+	if (uint8* Cached = Cache ? Cache->FindStruct(Struct) : nullptr)
+	{
+		if (!FGenericFieldPath::CopyValue(Path.GetFieldAddress(Cached), Path.GetProperty(), SrcPropertyAddress, SrcProperty)) return false;
+		ExportStruct(Struct, Cached);
+		return true;
+	}
+#endif
+
+	FStructOnScope Value(Struct);
+	{
+		GENERIC_TRACE_SCOPE(ImportText);
+		Struct->ImportText(*GetStringData(), Value.GetStructMemory(), nullptr, 0, nullptr, Struct->GetName());
+	}
+	if (!FGenericFieldPath::CopyValue(Path.GetFieldAddress(Value.GetStructMemory()), Path.GetProperty(), SrcPropertyAddress, SrcProperty)) return false;
+	ExportStruct(Struct, Value.GetStructMemory());
+	return true;
+}
+
+bool FGeneric::MayHoldStruct(const UScriptStruct* Struct) const
+{
+	// Values loaded or assigned from a struct type have no property, their payload is trusted
+	if (!ValueProperty) return true;
+	const FStructProperty* StructProp = CastField<FStructProperty>(ValueProperty);
+	return StructProp && StructProp->Struct == Struct;
+}
+
+void FGeneric::ExportStruct(const UScriptStruct* Struct, const void* Value)
+{
+	Detach();
+	++Version;
+	Data.Reset();
+	{
+		GENERIC_TRACE_SCOPE(ExportText);
+		Struct->ExportText(Data, Value, nullptr, nullptr, PPF_None, nullptr);
+	}
+#if WITH_EDITOR
+	CacheReferencedObjects(Struct, Value);
+#endif
+	GENERIC_STATS_RECORD_SET(Struct, GetPayloadSize());
+}
+
+bool FGeneric::IsNested(const FProperty* Prop)
+{
+	if (const FArrayProperty* ArrayProp = CastField<FArrayProperty>(Prop))
+	{
+		Prop = ArrayProp->Inner;
+	}
+	const FStructProperty* StructProp = CastField<FStructProperty>(Prop);
+	return StructProp && StructProp->Struct == FGeneric::StaticStruct();
+}
+
+const FProperty* FGeneric::GetNestedProperty(bool bArray)
+{
+	return FGenericNestedPropJunkPrivate::GetProperty(bArray);
+}
+
+void FGeneric::SetNested(const void* SrcPropertyAddress, const FProperty* SrcProperty)
+{
+	const FGeneric* Values = static_cast<const FGeneric*>(SrcPropertyAddress);
+	int32 NumValues = 1;
+	if (SrcProperty->IsA<FArrayProperty>())
+	{
+		const TArray<FGeneric>& Array = *static_cast<const TArray<FGeneric>*>(SrcPropertyAddress);
+		Values = Array.GetData();
+		NumValues = Array.Num();
+	}
+	FGenericNestedView::Write(PlainData, Values, NumValues);
+
+#if WITH_EDITOR
+	// Inner values already hold their references, the records are not walked again
+	ClearReferencedObjects();
+	for (int32 Index = 0; Index < NumValues; ++Index)
+	{
+		for (const TSoftObjectPtr<UObject>& Ref : Values[Index].ReferencedObjects)
+		{
+			ReferencedObjects.AddUnique(Ref);
+		}
+	}
+#endif
+}
+
+bool FGeneric::GetNested(void* DestPropertyAddress, const FProperty* DestProperty) const
+{
+	if (!FGenericNestedView::IsNestedPayload((const uint8*)GetPlainData(), GetPlainSize())) return false;
+
+	const FGenericNestedView View(*this);
+	if (DestProperty->IsA<FArrayProperty>())
+	{
+		TArray<FGeneric>& Array = *static_cast<TArray<FGeneric>*>(DestPropertyAddress);
+		Array.SetNum(View.Num());
+		for (int32 Index = 0; Index < View.Num(); ++Index)
+		{
+			View.Get(Index, Array[Index]);
+		}
+	}
+	else
+	{
+		View.Get(0, *static_cast<FGeneric*>(DestPropertyAddress));
+	}
+	return true;
+}
+
 const bool FGeneric::IsPlain(const FProperty* Prop)
 {
+	GENERIC_TRACE_SCOPE(IsPlain);
 	static constexpr auto NonPlainCastFlags =
 		EClassCastFlags::CASTCLASS_FObjectProperty |
 		EClassCastFlags::CASTCLASS_FObjectPropertyBase |
@@ -148,6 +808,21 @@ const bool FGeneric::IsPlain(const FProperty* Prop)
 	static constexpr auto StructCastFlags =
 		EClassCastFlags::CASTCLASS_FStructProperty;
 
+	if (Prop)
+	{
+		const auto PropCastFlags = Prop->GetCastFlags();
+		if (PropCastFlags & NonPlainCastFlags) return false;
+		if (PropCastFlags & PlainCastFlags) return true;
+		if (PropCastFlags & StructCastFlags)
+		{
+			return IsPlainStruct(((FStructProperty*)Prop)->Struct);
+		}
+	}
+	return false;
+}
+
+bool FGeneric::IsPlainStruct(const UScriptStruct* Struct)
+{
 	static auto StaticGetBaseStructureInternal = [](const TCHAR* Package, const TCHAR* Name)
 		{
 			return FindObjectChecked<UScriptStruct>(nullptr, *FString::Printf(TEXT("/Script/%s.%s"), Package, Name));
@@ -206,18 +881,7 @@ const bool FGeneric::IsPlain(const FProperty* Prop)
 		StaticGetBaseStructureInternal(TEXT("CoreUObject"), TEXT("InterpCurvePointLinearColor")),
 	};
 
-	if (Prop)
-	{
-		const auto PropCastFlags = Prop->GetCastFlags();
-		if (PropCastFlags & NonPlainCastFlags) return false;
-		if (PropCastFlags & PlainCastFlags) return true;
-		if (PropCastFlags & StructCastFlags)
-		{
-			auto* StructProp = ((FStructProperty*)Prop);
-			if (PlainStructs.Contains(StructProp->Struct)) return true;
-		}
-	}
-	return false;
+	return PlainStructs.Contains(Struct);
 }
 
 #if WITH_EDITOR
@@ -288,6 +952,32 @@ void FGeneric::CacheReferencedObjects(const UScriptStruct* InProperty, const voi
 	}
 }
 
+void FGeneric::CacheReferencedObjectsFromText()
+{
+	ClearReferencedObjects();
+
+	// Exported references are object paths, bare, quoted or wrapped as Class'/Path', so every token starting
+	// at a root that parses as an object path is kept
+	auto IsDelimiter = [](TCHAR Char)
+		{
+			return FChar::IsWhitespace(Char) || Char == TEXT('"') || Char == TEXT('\'') || Char == TEXT('(') || Char == TEXT(')') || Char == TEXT(',') || Char == TEXT('=');
+		};
+	const FString& Text = GetStringData();
+	for (int32 Index = 0; Index < Text.Len(); ++Index)
+	{
+		if (Text[Index] != TEXT('/') || (Index > 0 && !IsDelimiter(Text[Index - 1]))) continue;
+
+		int32 End = Index + 1;
+		while (End < Text.Len() && !IsDelimiter(Text[End])) ++End;
+		const FString Token = Text.Mid(Index, End - Index);
+		if (FPackageName::IsValidObjectPath(Token))
+		{
+			ReferencedObjects.AddUnique(TSoftObjectPtr<UObject>(FSoftObjectPath(Token)));
+		}
+		Index = End;
+	}
+}
+
 void FGeneric::ClearReferencedObjects()
 {
 	ReferencedObjects.Reset();
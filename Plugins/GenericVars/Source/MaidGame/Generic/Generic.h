@@ -5,6 +5,11 @@
 #include "CoreMinimal.h"
 #include "Core/Traits/MaidCoreTraits.h"
 #include "Misc/EngineVersionComparison.h"
+#include "Generic/GenericArgs.h"
+#include "Generic/GenericPinType.h"
+#include "Generic/GenericStats.h"
+#include "Generic/GenericTrace.h"
+#include <atomic>
 
 #if UE_VERSION_NEWER_THAN(5, 5, 0)
 #include "StructUtils/UserDefinedStruct.h"
@@ -12,14 +17,66 @@
 #include "Engine/UserDefinedStruct.h"
 #endif
 
+#if UE_VERSION_NEWER_THAN(5, 0, 0)
+#include "HAL/LowLevelMemTracker.h"
+#endif
+
 #include "Generic.generated.h"
 
 #pragma warning(disable: 4499)
 
+class FGenericFieldPath;
+
 #ifndef GENERIC_USING_CACHE
 #define GENERIC_USING_CACHE 1
 #endif
 
+/** Count the heap buffers FGeneric operations allocate, see FGeneric::GetThreadAllocCounts */
+#ifndef GENERIC_ALLOC_TRACKING
+#define GENERIC_ALLOC_TRACKING !UE_BUILD_SHIPPING
+#endif
+
+/**
+ * LLM tag covering FGeneric payloads, value caches and referenced object lists
+ * Shows up as "GenericVars" with -llm, and as a memory tag in Unreal Insights with -trace=memory
+ */
+#if UE_VERSION_NEWER_THAN(5, 0, 0)
+LLM_DECLARE_TAG_API(GenericVars, MAIDGAME_API);
+#define GENERIC_LLM_SCOPE() LLM_SCOPE_BYTAG(GenericVars)
+#else
+#define GENERIC_LLM_SCOPE()
+#endif
+
+#if GENERIC_ALLOC_TRACKING
+#define GENERIC_ALLOC_PROBE(Op, Source) const FAllocProbe ANONYMOUS_VARIABLE(GenericAllocProbe)(*this, &FGenericAllocCounts::Op, Source)
+#else
+#define GENERIC_ALLOC_PROBE(Op, Source)
+#endif
+
+/** Tag the allocations of an FGeneric operation and count them under Op */
+#define GENERIC_MEMORY_SCOPE(Op, Source) GENERIC_LLM_SCOPE(); GENERIC_ALLOC_PROBE(Op, Source)
+
+/** Heap buffers allocated by FGeneric operations, per kind of operation */
+struct FGenericAllocCounts
+{
+	int32 Set = 0;
+	int32 Get = 0;
+	int32 Copy = 0;
+	int32 Move = 0;
+
+	FORCEINLINE int32 Total() const { return Set + Get + Copy + Move; }
+
+	FORCEINLINE FGenericAllocCounts operator-(const FGenericAllocCounts& Other) const
+	{
+		FGenericAllocCounts Delta;
+		Delta.Set = Set - Other.Set;
+		Delta.Get = Get - Other.Get;
+		Delta.Copy = Copy - Other.Copy;
+		Delta.Move = Move - Other.Move;
+		return Delta;
+	}
+};
+
 /**
  * Reflection Metadata Host for FGeneric
  *
@@ -104,6 +161,9 @@ struct FGenericPropJunkPrivate
 	UPROPERTY() TArray<UObject*> ObjectArray;
 	UPROPERTY() TArray<FVector> VectorArray;
 
+	// Packed argument lists, stored as raw bytes rather than through GenericProperties.inl
+	UPROPERTY() FGenericArgs Args;
+
 public:
 #if CPP
 #pragma push_macro("GENERIC_PROPERTY")
@@ -116,12 +176,51 @@ public:
 	// END DEFINE GENERIC_PROPERTY
 #include "GenericProperties.inl"
 #pragma pop_macro("GENERIC_PROPERTY")
+	static inline FProperty* Get(FGenericArgs&&)
+	{
+		static FProperty* Prop = StaticStruct()->FindPropertyByName(GET_MEMBER_NAME_CHECKED(FGenericPropJunkPrivate, Args));
+		return Prop;
+	}
 #endif // CPP
 };
 
 #pragma push_macro("GET_GENERIC_PROP_PRIVATE")
 #define GET_GENERIC_PROP_PRIVATE(CppType) FGenericPropJunkPrivate::Get(CppType())
 
+/**
+ * Immutable payload shared by interned FGeneric instances
+ * Mirrors FGeneric::Data and FGeneric::PlainData; owned by every FGeneric referencing it, and listed by
+ * FGenericInternPool until the last of them lets go.
+ * @see FGenericInternPool
+ */
+struct MAIDGAME_API FGenericSharedPayload
+{
+	FString Data;
+	TArray<uint8> PlainData;
+	uint64 Hash = 0;
+
+	FORCEINLINE uint32 AddRef() const { return (uint32)(RefCount.fetch_add(1) + 1); }
+	FORCEINLINE uint32 Release() const
+	{
+		// Only the last reference has to meet the pool, which may be handing the payload out at the same time
+		int32 Refs = RefCount.load(std::memory_order_relaxed);
+		while (Refs > 1)
+		{
+			if (RefCount.compare_exchange_weak(Refs, Refs - 1)) return (uint32)(Refs - 1);
+		}
+		return ReleaseLast();
+	}
+	FORCEINLINE uint32 GetRefCount() const { return (uint32)RefCount.load(); }
+
+private:
+	friend class FGenericInternPool;
+
+	/** Drop what may be the last reference, removing the payload from the pool with it */
+	uint32 ReleaseLast() const;
+
+	mutable std::atomic<int32> RefCount{ 0 };
+};
+
 /**
  * Universal container type supporting both Blueprint and C++ systems
  *
@@ -138,6 +237,12 @@ public:
  * Complex Types (serialized text storage):
  * - All non-plain types using UE property export/import system
  *
+ * Packed Argument Lists (FGenericArgs):
+ * - The packed buffer is copied into the plain data as is, see FGenericArgsView
+ *
+ * Nested Generics (FGeneric, TArray<FGeneric>):
+ * - Inner values are stored as binary records in the plain data and decoded lazily, see FGenericNestedView
+ *
  * Example usage:
  *   FGeneric foo = FLinearColor::White;
  *   float myFloat = foo;
@@ -158,25 +263,26 @@ private:
 	UPROPERTY(VisibleAnywhere)
 	TArray<uint8> PlainData;
 
+#if WITH_EDITORONLY_DATA
 	/**
 	 * Soft references to UObjects contained in the data for asset dependency tracking
-	 * Used by editor tools to ensure referenced assets are included during packaging
+	 * Used by editor tools to ensure referenced assets are included during packaging, so cooked builds drop it
 	 */
 	UPROPERTY(VisibleAnywhere)
 	TArray<TSoftObjectPtr<UObject>> ReferencedObjects;
 
-#if WITH_EDITORONLY_DATA
-	/** Pin type information for editor visualization */
+	/** Pin type information for editor visualization, interned through FGenericPinTypeHandle */
 	UPROPERTY(VisibleAnywhere)
-	FEdGraphPinType EditPinType;
+	FGenericPinTypeHandle EditPinType;
 #endif
 
 	friend class UGenericStatics;
+	friend class FGenericNestedView;
+	friend struct FGenericPatch;
+	friend class FGenericView;
+	friend class FGenericStreamReader;
 
 #if WITH_EDITORONLY_DATA
-	UPROPERTY(Transient)
-	UUserDefinedStruct* EditorStruct = nullptr;
-
 	friend class FGenericStructCustomization;
 #endif
 
@@ -185,67 +291,132 @@ private:
 	/**
 	 * Data cache for performance optimization
 	 * Stores deserialized values to avoid repeated text parsing
+	 * Held out of line and only created for non-plain values, sharing its pointer with the interned payload
 	 */
 	struct FDataCache
 	{
-		using FDataCacheStorageType = decltype(FGeneric::PlainData)::ElementType;
-		FProperty* Prop = nullptr;
-		TArray<FDataCacheStorageType> CacheData;
+		/** Property describing the cached value, null when nothing is cached; always a persistent property */
+		const FProperty* Prop = nullptr;
+		uint8* Storage = nullptr;
+		int32 Capacity = 0;
+		/** Arena scope session owning Storage, 0 when Storage comes from the heap */
+		uint32 ArenaEpoch = 0;
+		/** Record of the cached value in the owning arena */
+		int32 ArenaRecord = INDEX_NONE;
+		/** Interned payload of the owning value, kept here while the cache occupies its payload slot */
+		TRefCountPtr<FGenericSharedPayload> Interned;
+
+		FDataCache() = default;
+		FDataCache(const FDataCache&) = delete;
+		FDataCache& operator=(const FDataCache&) = delete;
+		~FDataCache() { Clear(); Free(); }
+
+		/** Destroy the cached value, keeping the storage for the next Set */
+		void Clear();
+
+		/**
+		 * Cache a copy of a value, nothing is cached for properties that are not persistent
+		 * Destroying the copy later needs its property, which Blueprint and user-defined structs free at any GC.
+		 */
+		void Set(const void* SrcPropertyAddress, const FProperty* SrcProperty, bool bAllowArena = true);
+
+		/** Copy over the cached value when it has the same type, keeping its storage and inner allocations */
+		void Overwrite(const void* SrcPropertyAddress, const FProperty* SrcProperty);
+		bool ConditionalGet(void* DestPropertyAddress, const FProperty* DestProperty) const;
+
+		/** Storage of the cached value if it is an instance of Struct, null otherwise */
+		uint8* FindStruct(const UScriptStruct* Struct) const;
+
+		/** Storage of the cached value if it has the type of Property, null otherwise */
+		const uint8* FindValue(const FProperty* Property) const;
+
+		/** Copy semantics of FGeneric: heap caches are dropped, arena caches are promoted to the heap */
+		void Assign(const FDataCache& Other);
+
+		/** Move semantics of FGeneric: heap caches are stolen, arena caches are promoted to the heap */
+		void Assign(FDataCache&& Other);
+
+		/** Heap bytes owned by the cache storage, arena storage is not counted */
+		SIZE_T GetAllocatedSize() const { return ArenaEpoch == 0 ? Capacity : 0; }
+
+	private:
+		/** Check if Storage may be touched, arena storage is only valid in its own scope session */
+		bool IsAccessible() const;
+		void Reserve(int32 Size, int32 Alignment, bool bAllowArena);
+		void Free();
+		void Forget();
+	};
 
-		~FDataCache() { Clear(); }
-		FORCEINLINE void SetSize(int32 NewSize)
-		{
-			NewSize = FMath::Max((NewSize / CacheData.GetTypeSize()), 1u);
-			NewSize = FMath::Max(NewSize, CacheData.Num());
-			CacheData.SetNumZeroed(NewSize);
-		}
-		FORCEINLINE int32 GetSize() const
-		{
-			return CacheData.Num() * CacheData.GetTypeSize();
-		}
-		FORCEINLINE FDataCacheStorageType* GetData() 
-		{ 
-			return CacheData.GetData();
-		}
-		FORCEINLINE const FDataCacheStorageType* GetData() const
-		{ 
-			return CacheData.GetData();
-		}
-		FORCEINLINE void Clear()
-		{
-			if (Prop && Prop->GetSize() <= GetSize())
-			{
-				Prop->ClearValue(GetData());
-			}
-			CacheData.Reset();
-			Prop = nullptr;
-		}
-		FORCEINLINE void Set(const void* SrcPropertyAddress, const FProperty* SrcProperty)
-		{
-			Clear();
-			if (SrcProperty)
-			{
-				SetSize(SrcProperty->GetSize());
-				if (SrcPropertyAddress)
-				{
-					SrcProperty->CopyCompleteValue(GetData(), SrcPropertyAddress);
-				}
-				else SrcProperty->InitializeValue(GetData());
-			}
-		}
-		FORCEINLINE bool ConditionalGet(void* DestPropertyAddress, const FProperty* DestProperty) const
+	/** Get the data cache, creating it on first use */
+	FDataCache& GetDataCache();
+
+	/** Get the data cache if one was created */
+	FORCEINLINE FDataCache* FindDataCache() const { return Payload.GetCache(); }
+
+	void AssignDataCache(const FGeneric& Other);
+	void AssignDataCache(FGeneric&& Other);
+#endif
+
+private:
+	/**
+	 * Interned payload and data cache behind a single tagged pointer
+	 * Points at the shared payload while the value has no cache, and at the cache otherwise, which then holds
+	 * the payload. Most values have neither, so the two do not pay a pointer each.
+	 */
+	class FPayloadSlot
+	{
+	public:
+		FPayloadSlot() = default;
+		FPayloadSlot(const FPayloadSlot&) = delete;
+		FPayloadSlot& operator=(const FPayloadSlot&) = delete;
+		~FPayloadSlot() { Reset(); }
+
+		/**
+		 * Shared immutable payload when interned through FGenericInternPool
+		 * While set, Data and PlainData are empty and every read resolves to the shared payload
+		 */
+		FORCEINLINE FGenericSharedPayload* GetInterned() const
 		{
-			if (Prop && DestPropertyAddress && DestProperty && DestProperty->SameType(Prop) && GetSize() >= DestProperty->GetSize())
-			{
-				DestProperty->ClearValue(DestPropertyAddress);
-				DestProperty->CopyCompleteValue(DestPropertyAddress, GetData());
-				return true;
-			}
-			return false;
+#if GENERIC_USING_CACHE
+			if (const FDataCache* Cache = GetCache()) return Cache->Interned.GetReference();
+#endif
+			return reinterpret_cast<FGenericSharedPayload*>(Bits);
 		}
-	} DataCache;
+		void SetInterned(FGenericSharedPayload* InInterned);
+
+#if GENERIC_USING_CACHE
+		FORCEINLINE FDataCache* GetCache() const { return (Bits & CacheTag) ? reinterpret_cast<FDataCache*>(Bits & ~CacheTag) : nullptr; }
+		FDataCache& GetOrCreateCache();
+
+		/** Take over the cache object of Other, each slot keeps its own payload; only valid while this slot has no cache */
+		void StealCache(FPayloadSlot& Other);
 #endif
 
+		/** Release the payload and delete the cache */
+		void Reset();
+
+	private:
+		static constexpr UPTRINT CacheTag = 1;
+		UPTRINT Bits = 0;
+	};
+	FPayloadSlot Payload;
+
+	/**
+	 * Property the current value was written from, null when unknown (empty, loaded or struct-assigned)
+	 * Lets Set overwrite a value of the same type in place instead of rebuilding its storage. Only properties
+	 * of compiled-in types are kept: Blueprint and user-defined struct properties are freed when their owner
+	 * is recompiled or collected, while copies of the value may live on in assets.
+	 */
+	const FProperty* ValueProperty = nullptr;
+
+	/** Increased by every write to this instance, see GetVersion */
+	uint32 Version = 0;
+
+	FORCEINLINE FGenericSharedPayload* GetInterned() const { return Payload.GetInterned(); }
+
+	void AssignInterned(const FGeneric& Other) { Payload.SetInterned(Other.GetInterned()); }
+	void AssignInterned(FGeneric&& Other) { Payload.SetInterned(Other.GetInterned()); Other.Payload.SetInterned(nullptr); }
+
 public:
 	/** Null instance representing an empty FGeneric value */
 	static const FGeneric Null;
@@ -256,23 +427,23 @@ public:
 #pragma push_macro("GENERIC_COPY_DATA_ED")
 #pragma push_macro("GENERIC_COPY_DATA_CACHE")
 #pragma push_macro("GENERIC_CTOR")
-#define GENERIC_COPY_DATA(DECORATE) do{ Data = DECORATE(Other.Data); PlainData = DECORATE(Other.PlainData); ReferencedObjects = DECORATE(Other.ReferencedObjects); } while(0);
+#define GENERIC_COPY_DATA(DECORATE) do{ Data = DECORATE(Other.Data); PlainData = DECORATE(Other.PlainData); AssignInterned(DECORATE(Other)); ValueProperty = Other.ValueProperty; } while(0);
 #if WITH_EDITORONLY_DATA
-#define GENERIC_COPY_DATA_ED(DECORATE) do{ EditPinType = DECORATE(Other.EditPinType); } while(0);
+#define GENERIC_COPY_DATA_ED(DECORATE) do{ ReferencedObjects = DECORATE(Other.ReferencedObjects); EditPinType = DECORATE(Other.EditPinType); } while(0);
 #else
 #define GENERIC_COPY_DATA_ED(...)
 #endif
-#if GENERIC_USING_CACHE && 0 // Ignore cache for faster copy
-#define GENERIC_COPY_DATA_CACHE(DECORATE) do{ DataCache = DECORATE(Other.DataCache); } while(0);
+#if GENERIC_USING_CACHE
+#define GENERIC_COPY_DATA_CACHE(DECORATE) do{ AssignDataCache(DECORATE(Other)); } while(0);
 #else
 #define GENERIC_COPY_DATA_CACHE(...)
 #endif
-#define GENERIC_CTOR(DECORATE, ...) { if(this != &Other) { GENERIC_COPY_DATA(DECORATE); GENERIC_COPY_DATA_ED(DECORATE); GENERIC_COPY_DATA_CACHE(DECORATE); } __VA_ARGS__; }
+#define GENERIC_CTOR(DECORATE, OP, ...) { GENERIC_MEMORY_SCOPE(OP, &Other); if(this != &Other) { GENERIC_COPY_DATA(DECORATE); GENERIC_COPY_DATA_ED(DECORATE); GENERIC_COPY_DATA_CACHE(DECORATE); ++Version; } __VA_ARGS__; }
 	FGeneric() = default;
-	FGeneric(const FGeneric& Other) GENERIC_CTOR(*&, );
-	FGeneric(FGeneric&& Other) GENERIC_CTOR(MoveTempIfPossible, );
-	FGeneric& operator=(const FGeneric& Other) GENERIC_CTOR(*&, return *this;);
-	FGeneric& operator=(FGeneric&& Other) GENERIC_CTOR(MoveTempIfPossible, return *this;);
+	FGeneric(const FGeneric& Other) GENERIC_CTOR(*&, Copy, );
+	FGeneric(FGeneric&& Other) GENERIC_CTOR(MoveTempIfPossible, Move, ++Other.Version;);
+	FGeneric& operator=(const FGeneric& Other) GENERIC_CTOR(*&, Copy, return *this;);
+	FGeneric& operator=(FGeneric&& Other) GENERIC_CTOR(MoveTempIfPossible, Move, ++Other.Version; return *this;);
 	FGeneric(EForceInit) {}
 #pragma pop_macro("GENERIC_COPY_DATA")
 #pragma pop_macro("GENERIC_COPY_DATA_ED")
@@ -287,14 +458,36 @@ public:
 	FGeneric(EForceInit) {}
 #endif
 public:
+	/** Get the address of PlainData to write to it directly, detaches from a shared interned payload and counts as a write */
+	void* GetMutablePlainData() { Detach(); ++Version; return PlainData.GetData(); }
+
 	/** Get the address of PlainData for direct memory access */
-	void* GetPlainData() { return PlainData.GetData(); }
+	const void* GetPlainData() const { return GetPlainArray().GetData(); }
 
-	/** Get the address of PlainData for direct memory access (const version) */
-	const void* GetPlainData() const { return PlainData.GetData(); }
+	/** Get the property the stored value was written from, null when unknown */
+	FORCEINLINE const FProperty* GetValueProperty() const { return ValueProperty; }
 
 	/** Get the serialized string data for non-plain types */
-	const FString& GetStringData() const { return Data; }
+	const FString& GetStringData() const { const FGenericSharedPayload* Shared = GetInterned(); return Shared ? Shared->Data : Data; }
+
+	/**
+	 * Stamp of the current value, increased by every write to this instance
+	 * Consumers caching anything derived from the value compare one integer instead of the whole value.
+	 * Each instance keeps its own count, so stamps of different instances are not comparable.
+	 */
+	FORCEINLINE uint32 GetVersion() const { return Version; }
+
+	/** Increase the version after writing through a pointer obtained earlier from GetMutablePlainData */
+	FORCEINLINE void MarkChanged() { ++Version; }
+
+	/** Check if the payload is shared through FGenericInternPool */
+	FORCEINLINE bool IsInterned() const { return GetInterned() != nullptr; }
+
+	/**
+	 * Move the payload into FGenericInternPool if interning is enabled
+	 * Loading interns on its own, call this after assigning a value that lives as long as an asset does.
+	 */
+	void Intern();
 
 	/**
 	 * Set the value from a source address and property description
@@ -313,13 +506,29 @@ public:
 	/** Clear the stored value and release resources */
 	void Clear();
 
+	/**
+	 * Read one field of the stored struct, without decoding the rest of it
+	 * Plain structs are read in place from the plain data, text is read through the decoded cache when it
+	 * holds the struct and decoded into a temporary otherwise.
+	 * @param Path - Compiled path into the struct the value was stored from
+	 * @return False if the value is not an instance of the struct or the field type does not convert
+	 */
+	bool GetField(const FGenericFieldPath& Path, void* DestPropertyAddress, const FProperty* DestProperty) const;
+
+	/**
+	 * Write one field of the stored struct, keeping the rest of it
+	 * Plain structs are patched in place, text is exported again from the patched value.
+	 */
+	bool SetField(const FGenericFieldPath& Path, const void* SrcPropertyAddress, const FProperty* SrcProperty);
+
 	/** Check if this instance contains no data */
-	bool IsEmpty() const { return Data.IsEmpty() && PlainData.Num() == 0; }
+	bool IsEmpty() const { return GetStringData().IsEmpty() && GetPlainArray().Num() == 0; }
 
 	/** Equality comparison operator */
 	FORCEINLINE bool operator== (const FGeneric& Other) const
 	{
-		return Data.Equals(Other.Data, ESearchCase::CaseSensitive) && PlainData == Other.PlainData;
+		if (IsInterned() && GetInterned() == Other.GetInterned()) return true;
+		return GetStringData().Equals(Other.GetStringData(), ESearchCase::CaseSensitive) && GetPlainArray() == Other.GetPlainArray();
 	}
 
 	/** Inequality comparison operator */
@@ -330,10 +539,14 @@ public:
 
 #if WITH_EDITORONLY_DATA
 	/** Check if the pin type is valid */
-	FORCEINLINE bool IsValidPinType() const { return EditPinType != FEdGraphPinType(); };
-	FORCEINLINE const FEdGraphPinType& GetEditPinType() const { return EditPinType; }
-	FORCEINLINE void SetEditPinType(const FEdGraphPinType& NewType) { EditPinType = NewType; }
-	FORCEINLINE void SetEditPinType(const FProperty* Property) { GetDefault<UEdGraphSchema_K2>()->ConvertPropertyToPinType(Property, EditPinType); }
+	FORCEINLINE bool IsValidPinType() const { return EditPinType.IsValid(); };
+	FORCEINLINE const FEdGraphPinType& GetEditPinType() const { return EditPinType.Get(); }
+	FORCEINLINE void SetEditPinType(const FEdGraphPinType& NewType) { EditPinType = FGenericPinTypeHandle(NewType); }
+#if WITH_EDITOR
+	FORCEINLINE void SetEditPinType(const FProperty* Property) { EditPinType = FGenericPinTypeHandle::FromProperty(Property); }
+#else
+	FORCEINLINE void SetEditPinType(const FProperty* Property) {}
+#endif
 #else
 	template <typename... Args> FORCEINLINE void SetEditPinType(Args&&...) {}
 #endif
@@ -346,16 +559,103 @@ public:
 	 */
 	static const bool IsPlain(const FProperty* Prop);
 
+	/** Check if a struct is stored as plain data */
+	static bool IsPlainStruct(const UScriptStruct* Struct);
+
+	/** Check if two properties describe the same type, so a value of one fits storage laid out for the other */
+	static bool IsSameType(const FProperty* A, const FProperty* B);
+
+	/** Check if a property lives as long as the process, which only holds for properties of compiled-in types */
+	static bool IsPersistentProperty(const FProperty* Prop);
+
 	/** Get the size of the plain data in bytes */
-	FORCEINLINE int32 GetPlainSize() const { return PlainData.Num() * PlainData.GetTypeSize(); }
+	FORCEINLINE int32 GetPlainSize() const { return GetPlainArray().Num() * PlainData.GetTypeSize(); }
+
+	/**
+	 * Get the number of heap buffers FGeneric operations allocated on the calling thread
+	 * Only buffers owned by FGeneric are counted, not allocations made inside the values themselves.
+	 * Always zero when GENERIC_ALLOC_TRACKING is disabled.
+	 */
+	static FGenericAllocCounts GetThreadAllocCounts();
+
+	/**
+	 * Get the decoded value held by the data cache, without copying it
+	 * @return Address of the value if one decoded with Property is cached, null otherwise; valid until the next write
+	 */
+	const void* FindCachedValue(const FProperty* Property) const;
+
+	/**
+	 * Get the heap memory owned by this instance, not including sizeof(FGeneric)
+	 * An interned payload is shared and reported by FGenericInternPool instead.
+	 */
+	SIZE_T GetAllocatedSize() const;
+
+	/** Serialization hooks keeping interned payloads out of the tagged property data */
+	bool Serialize(FArchive& Ar);
+	void PostSerialize(const FArchive& Ar);
 
 private:
 	/** Resize the plain data storage to the specified size */
 	FORCEINLINE void SetPlainSize(int32 NewSize) { PlainData.SetNumZeroed(FMath::Max((NewSize / PlainData.GetTypeSize()), 1u)); }
 
+	/** Bytes of plain data and text currently stored */
+	FORCEINLINE int64 GetPayloadSize() const { return GetPlainSize() + GetStringData().Len() * sizeof(TCHAR); }
+
+	/** Get the plain data array, resolving a shared interned payload */
+	FORCEINLINE const TArray<uint8>& GetPlainArray() const { const FGenericSharedPayload* Shared = GetInterned(); return Shared ? Shared->PlainData : PlainData; }
+
+	/** Copy a shared interned payload back into this instance */
+	void Detach();
+
+	/** Replace a value written from the same property, reusing the existing storage */
+	void Overwrite(const void* SrcPropertyAddress, const FProperty* SrcProperty);
+
+	/** Check if a property holds an FGenericArgs, whose buffer is stored as plain data */
+	static bool IsPackedArgs(const FProperty* Prop);
+
+	/** Check if the stored value may be an instance of a struct, false if it was written from another type */
+	bool MayHoldStruct(const UScriptStruct* Struct) const;
+
+	/** Replace the text with the export of a struct value */
+	void ExportStruct(const UScriptStruct* Struct, const void* Value);
+
+	/** Check if a property holds an FGeneric or TArray<FGeneric>, stored as nested records */
+	static bool IsNested(const FProperty* Prop);
+
+	/** Property of FGenericNestedPropJunkPrivate for a nested generic or array of them */
+	static const FProperty* GetNestedProperty(bool bArray);
+
+	/** Write nested generics as records into the plain data */
+	void SetNested(const void* SrcPropertyAddress, const FProperty* SrcProperty);
+
+	/** Decode nested records into a generic or array of them, false if the payload holds none */
+	bool GetNested(void* DestPropertyAddress, const FProperty* DestProperty) const;
+
+#if GENERIC_ALLOC_TRACKING
+	/** Counts the heap buffers of an instance that were replaced by new ones during its lifetime */
+	struct FAllocProbe
+	{
+		FAllocProbe(const FGeneric& InOwner, int32 FGenericAllocCounts::* InCounter, const FGeneric* InSource = nullptr);
+		~FAllocProbe();
+
+	private:
+		static constexpr int32 NumBuffers = 5;
+		static void Capture(const FGeneric& Generic, const void* (&OutBuffers)[NumBuffers]);
+
+		const FGeneric& Owner;
+		int32 FGenericAllocCounts::* Counter;
+		const void* Buffers[NumBuffers];
+		/** Buffers of a moved-from instance, stealing them is not an allocation */
+		const void* SourceBuffers[NumBuffers];
+	};
+#endif
+
 #if WITH_EDITOR
 	void CacheReferencedObjects(const FProperty* InProperty, const void* InData);
 	void CacheReferencedObjects(const UScriptStruct* InProperty, const void* InData);
+
+	/** Collect the object paths found in the stored text, for values whose type is unknown */
+	void CacheReferencedObjectsFromText();
 	void ClearReferencedObjects();
 #endif
 
@@ -412,19 +712,57 @@ public:
 	template<class CppType, typename std::enable_if_t<TIsUStruct<CppType>>* = nullptr>
 	FORCEINLINE FGeneric& operator=(const CppType& Other)
 	{
+		GENERIC_MEMORY_SCOPE(Set, nullptr);
 		Clear();
 		UScriptStruct* Struct = CppType::StaticStruct();
-		Struct->ExportText(Data, &Other, nullptr, nullptr, 0, nullptr);
+		{
+			GENERIC_TRACE_SCOPE(ExportText);
+			Struct->ExportText(Data, &Other, nullptr, nullptr, 0, nullptr);
+		}
 #if WITH_EDITOR
 		CacheReferencedObjects(Struct, &Other);
 #endif
 #if WITH_EDITORONLY_DATA
-		EditPinType.PinCategory = "struct";
-		EditPinType.PinSubCategoryObject = Struct;
+		EditPinType = FGenericPinTypeHandle::FromStruct(Struct);
 #endif
+		GENERIC_STATS_RECORD_SET(Struct, GetPayloadSize());
+		return *this;
+	}
+
+	/** Construct from a packed argument list, its buffer is copied as plain data */
+	FGeneric(const FGenericArgs& Other)
+	{
+		(*this) = Other;
+	}
+
+	/** Assign from a packed argument list, its buffer is copied as plain data */
+	FGeneric& operator=(const FGenericArgs& Other)
+	{
+		Set(&Other, GET_GENERIC_PROP_PRIVATE(FGenericArgs));
+		return *this;
+	}
+
+	/** Construct from generics, each stored as a nested record rather than as exported text */
+	FGeneric(const TArray<FGeneric>& Other)
+	{
+		(*this) = Other;
+	}
+
+	/** Assign from generics, each stored as a nested record rather than as exported text */
+	FGeneric& operator=(const TArray<FGeneric>& Other)
+	{
+		Set(&Other, GetNestedProperty(true));
 		return *this;
 	}
 
+	/** Make a generic holding another one as its nested value, As<FGeneric>() reads it back */
+	static FGeneric MakeNested(const FGeneric& Inner)
+	{
+		FGeneric Outer;
+		Outer.Set(&Inner, GetNestedProperty(false));
+		return Outer;
+	}
+
 	/** Construct from UEnum type */
 	template<class CppType, typename std::enable_if_t<TIsUEnum<CppType>>* = nullptr>
 	explicit FGeneric(const CppType& Other)
@@ -468,10 +806,19 @@ public:
 		/* Fast path for integral types */ \
 		if constexpr (TIsIntegral<CppType>::Value || TIsFloatingPoint<CppType>::Value) \
 		{ \
-			Clear(); \
-			PlainData.SetNumUninitialized(sizeof(Other)); \
-			FMemory::Memcpy(GetPlainData(), &Other, GetPlainSize()); \
-			SetEditPinType(GET_GENERIC_PROP_PRIVATE(CppType)); \
+			GENERIC_MEMORY_SCOPE(Set, nullptr); \
+			/* Same type as the stored value: overwrite the bytes in place */ \
+			const FProperty* Prop = GET_GENERIC_PROP_PRIVATE(CppType); \
+			if (ValueProperty != Prop || IsInterned()) \
+			{ \
+				Clear(); \
+				PlainData.SetNumUninitialized(sizeof(Other)); \
+				SetEditPinType(Prop); \
+				ValueProperty = Prop; \
+			} \
+			FMemory::Memcpy(PlainData.GetData(), &Other, sizeof(Other)); \
+			++Version; \
+			GENERIC_STATS_RECORD_SET(Prop, sizeof(Other)); \
 		} \
 		else \
 		{ \
@@ -501,11 +848,11 @@ public:
 		else if constexpr (std::is_same_v<CppTypeNoCV, bool>)
 		{
 			if (GetPlainSize() == 1)
-				return (bool)PlainData[0];
+				return (bool)GetPlainArray()[0];
 			else if (GetPlainSize() == 0)
-				return !Data.IsEmpty();
+				return !GetStringData().IsEmpty();
 			else {
-				for (const auto Elem : PlainData)
+				for (const auto Elem : GetPlainArray())
 					if (Elem) return true;
 			}
 			return false;
@@ -518,21 +865,21 @@ public:
 				return static_cast<CppTypeNoCV>(*reinterpret_cast<const double*>(GetPlainData()));
 			else if (GetPlainSize() == sizeof(long double))
 				return static_cast<CppTypeNoCV>(*reinterpret_cast<const long double*>(GetPlainData()));
-			else if (!Data.IsEmpty())
+			else if (!GetStringData().IsEmpty())
 				if constexpr (std::is_same_v<CppTypeNoCV, float>)
-					return FCString::Atof(*Data);
+					return FCString::Atof(*GetStringData());
 				else
-					return FCString::Atod(*Data);
+					return FCString::Atod(*GetStringData());
 			return static_cast<CppTypeNoCV>(0);
 		}
 		else if constexpr (TIsIntegral<CppTypeNoCV>::Value || TIsUEnum<CppTypeNoCV>)
 		{
 			using TDestType = typename std::conditional_t<TIsUEnum<CppTypeNoCV>, TUnderlyingType<CppTypeNoCV>, CppTypeNoCV>;
 			if (GetPlainSize() == 0)
-				if (Data.IsEmpty())
+				if (GetStringData().IsEmpty())
 					return static_cast<CppTypeNoCV>(TDestType(0));
 				else
-					return static_cast<CppTypeNoCV>(TDestType(FCString::Atoi64(*Data)));
+					return static_cast<CppTypeNoCV>(TDestType(FCString::Atoi64(*GetStringData())));
 			else if (GetPlainSize() == sizeof(int8))
 				return static_cast<CppTypeNoCV>(TDestType(*reinterpret_cast<const int8*>(GetPlainData())));
 			else if (GetPlainSize() == sizeof(int16))
@@ -551,6 +898,7 @@ public:
 		}
 		else if constexpr (std::is_pointer_v<CppTypeNoCV> && std::is_convertible_v<CppTypeNoCV, UObject*>)
 		{
+			GENERIC_TRACE_SCOPE(LoadSynchronous);
 			return Cast<std::remove_pointer_t<CppTypeNoCV>>(As<TSoftObjectPtr<>>().LoadSynchronous());
 		}
 		else if constexpr (std::is_pointer_v<CppTypeNoCV>)
@@ -561,17 +909,32 @@ public:
 		}
 		else if constexpr (TIsSubclassOf<CppTypeNoCV>)
 		{
+			GENERIC_TRACE_SCOPE(LoadSynchronous);
 			return Cast<UClass>(As<TSoftObjectPtr<>>().LoadSynchronous());
 		}
 		else if constexpr (std::is_same_v<CppTypeNoCV, FSoftObjectPath> || std::is_same_v<CppTypeNoCV, FSoftClassPath>)
 		{
 			return As<TSoftObjectPtr<>>();
 		}
+		else if constexpr (std::is_same_v<CppTypeNoCV, FGenericArgs>)
+		{
+			FGenericArgs Ans;
+			Ans.SetBuffer((const uint8*)GetPlainData(), GetPlainSize());
+			return Ans;
+		}
+		else if constexpr (std::is_same_v<CppTypeNoCV, FGeneric> || std::is_same_v<CppTypeNoCV, TArray<FGeneric>>)
+		{
+			CppTypeNoCV Ans;
+			Get(&Ans, GetNestedProperty(std::is_same_v<CppTypeNoCV, TArray<FGeneric>>));
+			return Ans;
+		}
 		else if constexpr (TIsUStruct<CppTypeNoCV>)
 		{
 			CppTypeNoCV Ans;
 			UScriptStruct* Struct = CppTypeNoCV::StaticStruct();
-			Struct->ImportText(*Data, &Ans, nullptr, 0, nullptr, Struct->GetName());
+			GENERIC_TRACE_SCOPE(ImportText);
+			Struct->ImportText(*GetStringData(), &Ans, nullptr, 0, nullptr, Struct->GetName());
+			GENERIC_STATS_RECORD_GET(Struct, GetStringData().Len() * sizeof(TCHAR), EGenericCacheResult::None);
 			return Ans;
 		}
 #pragma push_macro("GENERIC_PROPERTY")
@@ -596,6 +959,20 @@ public:
 		}
 	}
 
+	/** Read one field of the stored struct, default value if it cannot be read */
+	template<typename CppType> CppType GetField(const FGenericFieldPath& Path) const
+	{
+		CppType Value = CppType();
+		GetField(Path, &Value, GET_GENERIC_PROP_PRIVATE(CppType));
+		return Value;
+	}
+
+	/** Write one field of the stored struct */
+	template<typename CppType> bool SetField(const FGenericFieldPath& Path, const CppType& Value)
+	{
+		return SetField(Path, &Value, GET_GENERIC_PROP_PRIVATE(CppType));
+	}
+
 	template<typename Type> FORCEINLINE operator const Type() const
 	{
 		return As<Type>();
@@ -606,6 +983,11 @@ public:
 
 #pragma pop_macro("GET_GENERIC_PROP_PRIVATE")
 
+#if !WITH_EDITORONLY_DATA
+/** Text, plain data, the payload slot, the value property and the version, down from 72 bytes with the old cache */
+static_assert(sizeof(FGeneric) <= 56, "FGeneric grew, keep rarely used state behind the payload slot");
+#endif
+
 /** Macro to set FGeneric from a class member */
 #define SET_GENERIC_FROM_MEMBER(Generic, ClassName, MemberName, Object) \
 { Generic.Set(&Object->MemberName, ClassName::StaticClass()->FindPropertyByName(GET_MEMBER_NAME_CHECKED(ClassName, MemberName))); }
@@ -623,6 +1005,8 @@ struct TStructOpsTypeTraits<FGeneric> : public TStructOpsTypeTraitsBase2<FGeneri
 		WithZeroConstructor = true,
 		WithCopy = true,
 		WithIdenticalViaEquality = true,
+		WithSerializer = true,
+		WithPostSerialize = true,
 	};
 };
 
@@ -0,0 +1,210 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#include "Generic/GenericArena.h"
+#include "Generic/Generic.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
+#include "UObject/UnrealType.h"
+
+static int32 GGenericArenaBlockSize = 64 * 1024;
+static FAutoConsoleVariableRef CVarGenericArenaBlockSize(
+	TEXT("generic.arena.blocksize"),
+	GGenericArenaBlockSize,
+	TEXT("Size in bytes of each FGeneric arena block. Larger requests use the heap."));
+
+static int32 GGenericArenaRetainedBlocks = 4;
+static FAutoConsoleVariableRef CVarGenericArenaRetainedBlocks(
+	TEXT("generic.arena.retainedblocks"),
+	GGenericArenaRetainedBlocks,
+	TEXT("Number of FGeneric arena blocks kept per thread when a scope closes."));
+
+struct FGenericArenaThreadState
+{
+	FGenericArena* Arena = nullptr;
+	uint32 ActiveEpoch = 0;
+
+	~FGenericArenaThreadState() { delete Arena; }
+};
+
+static thread_local FGenericArenaThreadState GGenericArenaThreadState;
+
+/** Scope sessions are numbered globally so a stale session can never match the current one */
+static FThreadSafeCounter GGenericArenaEpochCounter;
+
+FGenericArena* FGenericArena::GetActive()
+{
+	return GGenericArenaThreadState.ActiveEpoch ? GGenericArenaThreadState.Arena : nullptr;
+}
+
+uint32 FGenericArena::GetActiveEpoch()
+{
+	return GGenericArenaThreadState.ActiveEpoch;
+}
+
+void FGenericArena::PushScope()
+{
+	FGenericArenaThreadState& State = GGenericArenaThreadState;
+	if (!State.Arena)
+	{
+		State.Arena = new FGenericArena();
+	}
+	State.Arena->Open();
+}
+
+void FGenericArena::PopScope()
+{
+	FGenericArenaThreadState& State = GGenericArenaThreadState;
+	if (ensure(State.Arena))
+	{
+		State.Arena->Close();
+	}
+}
+
+void FGenericArena::Open()
+{
+	if (ScopeDepth++ == 0)
+	{
+		uint32 Epoch = (uint32)GGenericArenaEpochCounter.Increment();
+		if (Epoch == 0)
+		{
+			Epoch = (uint32)GGenericArenaEpochCounter.Increment();
+		}
+		GGenericArenaThreadState.ActiveEpoch = Epoch;
+	}
+}
+
+void FGenericArena::Close()
+{
+	if (!ensure(ScopeDepth > 0) || --ScopeDepth > 0) return;
+
+	// Destroy the values whose owners did not release them, they either leaked out of the scope or are stale
+	for (const FRecord& Record : Records)
+	{
+		if (Record.Property)
+		{
+			Record.Property->DestroyValue(Record.Value);
+		}
+	}
+	Records.Reset();
+
+	while (Blocks.Num() > FMath::Max(GGenericArenaRetainedBlocks, 0))
+	{
+		FMemory::Free(Blocks.Last().Memory);
+		Blocks.RemoveAt(Blocks.Num() - 1);
+	}
+	BlockIndex = 0;
+	BlockOffset = 0;
+	UsedBytes = 0;
+	GGenericArenaThreadState.ActiveEpoch = 0;
+}
+
+FGenericArena::~FGenericArena()
+{
+	ensureMsgf(ScopeDepth == 0, TEXT("Generic arena destroyed with an open scope"));
+	for (const FBlock& Block : Blocks)
+	{
+		FMemory::Free(Block.Memory);
+	}
+}
+
+void* FGenericArena::Allocate(SIZE_T Size, uint32 Alignment)
+{
+	const SIZE_T BlockSize = (SIZE_T)FMath::Max(GGenericArenaBlockSize, 1024);
+	if (ScopeDepth == 0 || Size + Alignment > BlockSize / 4) return nullptr;
+
+	while (true)
+	{
+		if (Blocks.IsValidIndex(BlockIndex))
+		{
+			FBlock& Block = Blocks[BlockIndex];
+			const SIZE_T Offset = Align((UPTRINT)Block.Memory + BlockOffset, Alignment) - (UPTRINT)Block.Memory;
+			if (Offset + Size <= Block.Size)
+			{
+				BlockOffset = Offset + Size;
+				UsedBytes += Size;
+				return Block.Memory + Offset;
+			}
+			++BlockIndex;
+			BlockOffset = 0;
+		}
+		else
+		{
+			GENERIC_LLM_SCOPE();
+			FBlock& Block = Blocks.AddDefaulted_GetRef();
+			Block.Memory = (uint8*)FMemory::Malloc(BlockSize, 16);
+			Block.Size = BlockSize;
+			BlockIndex = Blocks.Num() - 1;
+			BlockOffset = 0;
+		}
+	}
+}
+
+int32 FGenericArena::RegisterValue(const FProperty* Property, void* Value)
+{
+	FRecord& Record = Records.AddDefaulted_GetRef();
+	Record.Property = Property;
+	Record.Value = Value;
+	return Records.Num() - 1;
+}
+
+void FGenericArena::ReleaseValue(int32 Record)
+{
+	if (Records.IsValidIndex(Record))
+	{
+		Records[Record].Property = nullptr;
+	}
+}
+
+SIZE_T FGenericArena::GetReservedBytes() const
+{
+	SIZE_T Reserved = 0;
+	for (const FBlock& Block : Blocks)
+	{
+		Reserved += Block.Size;
+	}
+	return Reserved;
+}
+
+static bool GGenericArenaFrameScopeOpen = false;
+
+static void OnGenericArenaBeginFrame()
+{
+	if (!GGenericArenaFrameScopeOpen)
+	{
+		FGenericArena::PushScope();
+		GGenericArenaFrameScopeOpen = true;
+	}
+}
+
+static void OnGenericArenaEndFrame()
+{
+	if (GGenericArenaFrameScopeOpen)
+	{
+		FGenericArena::PopScope();
+		GGenericArenaFrameScopeOpen = false;
+	}
+}
+
+static int32 GGenericArenaFrameScope = 0;
+static FAutoConsoleVariableRef CVarGenericArenaFrameScope(
+	TEXT("generic.arena.framescope"),
+	GGenericArenaFrameScope,
+	TEXT("Keep an FGeneric arena scope open on the game thread for the duration of every frame."),
+	FConsoleVariableDelegate::CreateLambda([](IConsoleVariable*)
+		{
+			static FDelegateHandle BeginFrameHandle;
+			static FDelegateHandle EndFrameHandle;
+			if (GGenericArenaFrameScope && !BeginFrameHandle.IsValid())
+			{
+				BeginFrameHandle = FCoreDelegates::OnBeginFrame.AddStatic(&OnGenericArenaBeginFrame);
+				EndFrameHandle = FCoreDelegates::OnEndFrame.AddStatic(&OnGenericArenaEndFrame);
+			}
+			else if (!GGenericArenaFrameScope && BeginFrameHandle.IsValid())
+			{
+				FCoreDelegates::OnBeginFrame.Remove(BeginFrameHandle);
+				FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+				BeginFrameHandle.Reset();
+				EndFrameHandle.Reset();
+				OnGenericArenaEndFrame();
+			}
+		}));
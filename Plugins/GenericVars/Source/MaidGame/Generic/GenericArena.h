@@ -0,0 +1,97 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#pragma once
+
+#include "Core/MaidCoreFwd.h"
+#include "CoreMinimal.h"
+
+/**
+ * Bump allocator for transient FGeneric storage
+ *
+ * Every thread owns one arena. While an FGenericArenaScope is open on a thread, the decoded value cache
+ * of each FGeneric written on that thread is carved from the arena instead of the global allocator.
+ * When the outermost scope closes, the arena destroys the cached values still alive and rewinds all of
+ * its blocks in one step.
+ *
+ * Escaping values stay correct: Data and PlainData remain the authoritative storage and always use the
+ * heap. Every copy or move of an FGeneric, inside the scope or not, promotes its cached value to the heap,
+ * since that is how values leave a scope. An FGeneric that was written in the scope and simply outlives it
+ * drops its cache on next access and decodes its text again: promoting it when the scope closes would mean
+ * writing to values that other threads may own by then.
+ *
+ * With generic.arena.framescope enabled the game thread keeps one scope open per frame.
+ */
+class MAIDGAME_API FGenericArena
+{
+public:
+	/** Arena of the calling thread if a scope is open on it, null otherwise */
+	static FGenericArena* GetActive();
+
+	/** Identifier of the scope session open on the calling thread, 0 if none */
+	static uint32 GetActiveEpoch();
+
+	/** Open and close a scope on the calling thread; prefer FGenericArenaScope */
+	static void PushScope();
+	static void PopScope();
+
+	/**
+	 * Allocate memory valid until the outermost scope closes
+	 * @return Null if the request is too large for an arena block
+	 */
+	void* Allocate(SIZE_T Size, uint32 Alignment);
+
+	/**
+	 * Register a value constructed in arena memory so the arena destroys it when the scope closes
+	 * @return Record handle to pass to ReleaseValue once the owner destroyed the value itself
+	 */
+	int32 RegisterValue(const FProperty* Property, void* Value);
+	void ReleaseValue(int32 Record);
+
+	/** Bytes handed out since the scope session opened */
+	FORCEINLINE SIZE_T GetUsedBytes() const { return UsedBytes; }
+
+	/** Bytes held by the arena blocks */
+	SIZE_T GetReservedBytes() const;
+
+	~FGenericArena();
+
+private:
+	void Open();
+	void Close();
+
+	struct FBlock
+	{
+		uint8* Memory = nullptr;
+		SIZE_T Size = 0;
+	};
+
+	struct FRecord
+	{
+		const FProperty* Property = nullptr;
+		void* Value = nullptr;
+	};
+
+	TArray<FBlock> Blocks;
+	TArray<FRecord> Records;
+	int32 BlockIndex = 0;
+	SIZE_T BlockOffset = 0;
+	SIZE_T UsedBytes = 0;
+	int32 ScopeDepth = 0;
+};
+
+/**
+ * Routes transient FGeneric storage of the calling thread to its FGenericArena
+ *
+ * Example usage:
+ *   {
+ *       FGenericArenaScope ArenaScope;
+ *       FGeneric Args = SomeStruct;
+ *       IGenericEventHandler::Execute_HandleGenericEvent(Target, Source, EventName, Args);
+ *   } // arena rewound here
+ */
+class MAIDGAME_API FGenericArenaScope : public FNoncopyable
+{
+public:
+	FGenericArenaScope() { FGenericArena::PushScope(); }
+	~FGenericArenaScope() { FGenericArena::PopScope(); }
+};
@@ -0,0 +1,334 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#include "Generic/GenericArgs.h"
+#include "Generic/Generic.h"
+
+namespace GenericArgs
+{
+	/** Marks a buffer as packed arguments, so plain data of another type is not misread */
+	static constexpr uint32 Magic = 0x53475241; // 'ARGS'
+
+	struct FHeader
+	{
+		uint32 Magic = 0;
+		int32 Num = 0;
+		int32 TableOffset = 0;
+		int32 Reserved = 0;
+	};
+
+	static constexpr int32 TableAlignment = 8;
+}
+
+struct FGenericArgsView::FEntry
+{
+	FName Name;
+	int32 Offset = 0;
+	int32 Size = 0;
+	EGenericArgType Type = EGenericArgType::None;
+};
+
+FGenericArgsView::FGenericArgsView(const uint8* InData, int32 InSize)
+{
+	using namespace GenericArgs;
+	if (!InData || InSize < (int32)sizeof(FHeader)) return;
+
+	FHeader Header;
+	FMemory::Memcpy(&Header, InData, sizeof(FHeader));
+	if (Header.Magic != Magic || Header.Num < 0 || Header.TableOffset < (int32)sizeof(FHeader)) return;
+	if ((int64)Header.TableOffset + (int64)Header.Num * sizeof(FEntry) != InSize) return;
+
+	Data = InData;
+	Size = InSize;
+	NumArgs = Header.Num;
+	TableOffset = Header.TableOffset;
+}
+
+FGenericArgsView::FGenericArgsView(const FGeneric& Generic)
+	: FGenericArgsView((const uint8*)Generic.GetPlainData(), Generic.GetPlainSize())
+{
+}
+
+bool FGenericArgsView::GetEntry(int32 Index, FEntry& OutEntry) const
+{
+	if (!IsValidIndex(Index)) return false;
+
+	FMemory::Memcpy(&OutEntry, Data + TableOffset + Index * sizeof(FEntry), sizeof(FEntry));
+	return OutEntry.Offset >= 0 && OutEntry.Size >= 0 && OutEntry.Offset + OutEntry.Size <= TableOffset;
+}
+
+EGenericArgType FGenericArgsView::GetType(int32 Index) const
+{
+	FEntry Entry;
+	return GetEntry(Index, Entry) ? Entry.Type : EGenericArgType::None;
+}
+
+FName FGenericArgsView::GetName(int32 Index) const
+{
+	FEntry Entry;
+	return GetEntry(Index, Entry) ? Entry.Name : NAME_None;
+}
+
+int32 FGenericArgsView::IndexOf(FName Name) const
+{
+	FEntry Entry;
+	for (int32 Index = 0; Index < NumArgs; ++Index)
+	{
+		if (GetEntry(Index, Entry) && Entry.Name == Name)
+		{
+			return Index;
+		}
+	}
+	return INDEX_NONE;
+}
+
+bool FGenericArgsView::ReadNumber(int32 Index, double& OutValue, int64& OutInteger, bool& bOutIsInteger) const
+{
+	FEntry Entry;
+	if (!GetEntry(Index, Entry)) return false;
+
+	const uint8* Value = Data + Entry.Offset;
+	bOutIsInteger = true;
+	switch (Entry.Type)
+	{
+	case EGenericArgType::Bool:
+		OutInteger = *Value ? 1 : 0;
+		break;
+	case EGenericArgType::Int32:
+	{
+		int32 Int32 = 0;
+		FMemory::Memcpy(&Int32, Value, sizeof(Int32));
+		OutInteger = Int32;
+		break;
+	}
+	case EGenericArgType::Int64:
+		FMemory::Memcpy(&OutInteger, Value, sizeof(OutInteger));
+		break;
+	case EGenericArgType::Float:
+	{
+		float Float = 0.0f;
+		FMemory::Memcpy(&Float, Value, sizeof(Float));
+		OutValue = Float;
+		bOutIsInteger = false;
+		return true;
+	}
+	case EGenericArgType::Double:
+		FMemory::Memcpy(&OutValue, Value, sizeof(OutValue));
+		bOutIsInteger = false;
+		return true;
+	default:
+		return false;
+	}
+	OutValue = (double)OutInteger;
+	return true;
+}
+
+bool FGenericArgsView::TryGet(int32 Index, bool& OutValue) const
+{
+	double Number = 0.0;
+	int64 Integer = 0;
+	bool bIsInteger = false;
+	if (!ReadNumber(Index, Number, Integer, bIsInteger)) return false;
+
+	OutValue = bIsInteger ? Integer != 0 : Number != 0.0;
+	return true;
+}
+
+bool FGenericArgsView::TryGet(int32 Index, int32& OutValue) const
+{
+	int64 Value = 0;
+	if (!TryGet(Index, Value)) return false;
+
+	OutValue = (int32)Value;
+	return true;
+}
+
+bool FGenericArgsView::TryGet(int32 Index, int64& OutValue) const
+{
+	double Number = 0.0;
+	int64 Integer = 0;
+	bool bIsInteger = false;
+	if (!ReadNumber(Index, Number, Integer, bIsInteger)) return false;
+
+	OutValue = bIsInteger ? Integer : (int64)Number;
+	return true;
+}
+
+bool FGenericArgsView::TryGet(int32 Index, float& OutValue) const
+{
+	double Value = 0.0;
+	if (!TryGet(Index, Value)) return false;
+
+	OutValue = (float)Value;
+	return true;
+}
+
+bool FGenericArgsView::TryGet(int32 Index, double& OutValue) const
+{
+	int64 Integer = 0;
+	bool bIsInteger = false;
+	return ReadNumber(Index, OutValue, Integer, bIsInteger);
+}
+
+bool FGenericArgsView::TryGet(int32 Index, FName& OutValue) const
+{
+	FEntry Entry;
+	if (!GetEntry(Index, Entry)) return false;
+
+	if (Entry.Type == EGenericArgType::Name)
+	{
+		FMemory::Memcpy(&OutValue, Data + Entry.Offset, sizeof(FName));
+		return true;
+	}
+	if (Entry.Type == EGenericArgType::String)
+	{
+		FString String;
+		TryGet(Index, String);
+		OutValue = FName(*String);
+		return true;
+	}
+	return false;
+}
+
+bool FGenericArgsView::TryGet(int32 Index, FString& OutValue) const
+{
+	FEntry Entry;
+	if (!GetEntry(Index, Entry)) return false;
+
+	if (Entry.Type == EGenericArgType::String)
+	{
+		// Stored as a length followed by the characters, without terminator
+		int32 Len = 0;
+		FMemory::Memcpy(&Len, Data + Entry.Offset, sizeof(Len));
+		if (Len < 0 || sizeof(int32) + Len * sizeof(TCHAR) > (SIZE_T)Entry.Size) return false;
+
+		OutValue.Reset(Len);
+		OutValue.AppendChars((const TCHAR*)(Data + Entry.Offset + sizeof(int32)), Len);
+		return true;
+	}
+	if (Entry.Type == EGenericArgType::Name)
+	{
+		FName Name;
+		TryGet(Index, Name);
+		OutValue = Name.ToString();
+		return true;
+	}
+	return false;
+}
+
+bool FGenericArgsView::TryGet(int32 Index, FVector& OutValue) const
+{
+	FEntry Entry;
+	if (!GetEntry(Index, Entry) || Entry.Type != EGenericArgType::Vector) return false;
+
+	FMemory::Memcpy(&OutValue, Data + Entry.Offset, sizeof(FVector));
+	return true;
+}
+
+bool FGenericArgsView::TryGet(int32 Index, FRotator& OutValue) const
+{
+	FEntry Entry;
+	if (!GetEntry(Index, Entry) || Entry.Type != EGenericArgType::Rotator) return false;
+
+	FMemory::Memcpy(&OutValue, Data + Entry.Offset, sizeof(FRotator));
+	return true;
+}
+
+bool FGenericArgsView::TryGet(int32 Index, UObject*& OutValue) const
+{
+	FEntry Entry;
+	if (!GetEntry(Index, Entry) || Entry.Type != EGenericArgType::Object) return false;
+
+	FWeakObjectPtr Object;
+	FMemory::Memcpy(&Object, Data + Entry.Offset, sizeof(FWeakObjectPtr));
+	OutValue = Object.Get();
+	return true;
+}
+
+uint8* FGenericArgs::AddValue(FName Name, EGenericArgType Type, int32 ValueSize, int32 Alignment)
+{
+	using namespace GenericArgs;
+	using FEntry = FGenericArgsView::FEntry;
+
+	FHeader Header;
+	if (Buffer.Num() < (int32)sizeof(FHeader))
+	{
+		Buffer.Reset();
+		Buffer.AddZeroed(sizeof(FHeader));
+		Header.Magic = Magic;
+		Header.TableOffset = sizeof(FHeader);
+	}
+	else
+	{
+		FMemory::Memcpy(&Header, Buffer.GetData(), sizeof(FHeader));
+	}
+
+	// The value goes where the table starts, the table moves behind it; only the small table is shifted
+	const int32 ValueOffset = Align(Header.TableOffset, Alignment);
+	const int32 NewTableOffset = Align(ValueOffset + ValueSize, TableAlignment);
+	Buffer.InsertZeroed(Header.TableOffset, NewTableOffset - Header.TableOffset);
+
+	// Zeroed first so the padding of the entry is deterministic, equal lists make equal buffers
+	FEntry Entry;
+	FMemory::Memzero(&Entry, sizeof(FEntry));
+	Entry.Name = Name;
+	Entry.Offset = ValueOffset;
+	Entry.Size = ValueSize;
+	Entry.Type = Type;
+	const int32 EntryOffset = Buffer.AddZeroed(sizeof(FEntry));
+	FMemory::Memcpy(Buffer.GetData() + EntryOffset, &Entry, sizeof(FEntry));
+
+	++Header.Num;
+	Header.TableOffset = NewTableOffset;
+	FMemory::Memcpy(Buffer.GetData(), &Header, sizeof(FHeader));
+	return Buffer.GetData() + ValueOffset;
+}
+
+void FGenericArgs::SetBuffer(const uint8* Data, int32 Size)
+{
+	Buffer.Reset();
+	if (FGenericArgsView(Data, Size).Num() > 0)
+	{
+		Buffer.Append(Data, Size);
+	}
+}
+
+#pragma push_macro("GENERIC_ARGS_ADD_PLAIN")
+#define GENERIC_ARGS_ADD_PLAIN(CppType, Type) \
+	FGenericArgs& FGenericArgs::Add(FName Name, CppType Value) \
+	{ \
+		FMemory::Memcpy(AddValue(Name, EGenericArgType::Type, sizeof(Value), alignof(decltype(Value))), &Value, sizeof(Value)); \
+		return *this; \
+	}
+GENERIC_ARGS_ADD_PLAIN(bool, Bool)
+GENERIC_ARGS_ADD_PLAIN(int32, Int32)
+GENERIC_ARGS_ADD_PLAIN(int64, Int64)
+GENERIC_ARGS_ADD_PLAIN(float, Float)
+GENERIC_ARGS_ADD_PLAIN(double, Double)
+GENERIC_ARGS_ADD_PLAIN(FName, Name)
+GENERIC_ARGS_ADD_PLAIN(const FVector&, Vector)
+GENERIC_ARGS_ADD_PLAIN(const FRotator&, Rotator)
+#pragma pop_macro("GENERIC_ARGS_ADD_PLAIN")
+
+FGenericArgs& FGenericArgs::Add(FName Name, const FString& Value)
+{
+	return Add(Name, *Value);
+}
+
+FGenericArgs& FGenericArgs::Add(FName Name, const TCHAR* Value)
+{
+	const int32 Len = Value ? FCString::Strlen(Value) : 0;
+	uint8* Slot = AddValue(Name, EGenericArgType::String, sizeof(int32) + Len * sizeof(TCHAR), alignof(int32));
+	FMemory::Memcpy(Slot, &Len, sizeof(Len));
+	if (Len > 0)
+	{
+		FMemory::Memcpy(Slot + sizeof(int32), Value, Len * sizeof(TCHAR));
+	}
+	return *this;
+}
+
+FGenericArgs& FGenericArgs::Add(FName Name, const UObject* Value)
+{
+	const FWeakObjectPtr Object(Value);
+	FMemory::Memcpy(AddValue(Name, EGenericArgType::Object, sizeof(FWeakObjectPtr), alignof(FWeakObjectPtr)), &Object, sizeof(FWeakObjectPtr));
+	return *this;
+}
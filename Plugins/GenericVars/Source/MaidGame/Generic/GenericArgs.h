@@ -0,0 +1,190 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Casts.h"
+#include "UObject/WeakObjectPtr.h"
+
+#include "GenericArgs.generated.h"
+
+struct FGeneric;
+
+/** Type of a value held by FGenericArgs */
+UENUM(BlueprintType)
+enum class EGenericArgType : uint8
+{
+	None,
+	Bool,
+	Int32,
+	Int64,
+	Float,
+	Double,
+	Name,
+	String,
+	Vector,
+	Rotator,
+	Object,
+};
+
+/**
+ * Read-only access to a packed argument list, without copying it
+ *
+ * Views an FGenericArgs or the payload of an FGeneric the arguments were assigned to, so event handlers read
+ * their arguments straight from the event payload. Numeric values convert between each other, names and
+ * strings convert between each other; any other mismatch reads as the default value.
+ */
+class MAIDGAME_API FGenericArgsView
+{
+public:
+	FGenericArgsView() = default;
+	FGenericArgsView(const uint8* InData, int32 InSize);
+
+	/** View the arguments stored in a generic, empty if it holds something else */
+	explicit FGenericArgsView(const FGeneric& Generic);
+
+	/** Check if the viewed bytes are a packed argument list */
+	FORCEINLINE bool IsValid() const { return Data != nullptr; }
+
+	FORCEINLINE int32 Num() const { return NumArgs; }
+	FORCEINLINE bool IsValidIndex(int32 Index) const { return Index >= 0 && Index < NumArgs; }
+
+	EGenericArgType GetType(int32 Index) const;
+	FName GetName(int32 Index) const;
+
+	/** @return Index of the first argument with this name, INDEX_NONE if there is none */
+	int32 IndexOf(FName Name) const;
+
+	/** @return False if the index is out of range or the type does not convert */
+	bool TryGet(int32 Index, bool& OutValue) const;
+	bool TryGet(int32 Index, int32& OutValue) const;
+	bool TryGet(int32 Index, int64& OutValue) const;
+	bool TryGet(int32 Index, float& OutValue) const;
+	bool TryGet(int32 Index, double& OutValue) const;
+	bool TryGet(int32 Index, FName& OutValue) const;
+	bool TryGet(int32 Index, FString& OutValue) const;
+	bool TryGet(int32 Index, FVector& OutValue) const;
+	bool TryGet(int32 Index, FRotator& OutValue) const;
+	bool TryGet(int32 Index, UObject*& OutValue) const;
+
+	template<typename T>
+	bool TryGet(FName Name, T& OutValue) const { return TryGet(IndexOf(Name), OutValue); }
+
+	/** Get an argument by position, default value if missing */
+	template<typename T>
+	T Get(int32 Index) const
+	{
+		if constexpr (std::is_pointer_v<T>)
+		{
+			UObject* Object = nullptr;
+			TryGet(Index, Object);
+			return Cast<std::remove_pointer_t<T>>(Object);
+		}
+		else
+		{
+			T Value = T();
+			TryGet(Index, Value);
+			return Value;
+		}
+	}
+
+	/** Get an argument by name, default value if missing */
+	template<typename T>
+	T Get(FName Name) const { return Get<T>(IndexOf(Name)); }
+
+private:
+	friend struct FGenericArgs;
+
+	struct FEntry;
+
+	bool GetEntry(int32 Index, FEntry& OutEntry) const;
+	bool ReadNumber(int32 Index, double& OutValue, int64& OutInteger, bool& bOutIsInteger) const;
+
+	const uint8* Data = nullptr;
+	int32 Size = 0;
+	int32 NumArgs = 0;
+	int32 TableOffset = 0;
+};
+
+/**
+ * Packed list of typed event arguments
+ *
+ * Values are written one after another into a single buffer, followed by a table giving the name, type and
+ * offset of each one. Assigning the list to an FGeneric copies that buffer as plain data, skipping the text
+ * export used for structs, and FGenericArgsView reads it back in place.
+ *
+ * Names and objects are stored as runtime handles, objects weakly: the list is an in-memory payload and is
+ * not saved. Saving a generic holding one trips an ensure, generic tables and streams write it as an empty value.
+ *
+ * Example usage:
+ *   Dispatcher.Broadcast(this, TEXT("Hit"), FGenericArgs().Add(TEXT("Damage"), 12.5f).Add(TEXT("Instigator"), Pawn));
+ *   FGenericArgsView Args(InArgs);
+ *   float Damage = Args.Get<float>(TEXT("Damage"));
+ */
+USTRUCT(BlueprintType)
+struct MAIDGAME_API FGenericArgs
+{
+	GENERATED_BODY()
+
+	FGenericArgs() = default;
+
+	/** Build a positional argument list */
+	template<typename... ArgTypes>
+	static FGenericArgs Make(const ArgTypes&... Values)
+	{
+		FGenericArgs Args;
+		(Args.Add(NAME_None, Values), ...);
+		return Args;
+	}
+
+	/** Append a value, NAME_None for a positional argument */
+	FGenericArgs& Add(FName Name, bool Value);
+	FGenericArgs& Add(FName Name, int32 Value);
+	FGenericArgs& Add(FName Name, int64 Value);
+	FGenericArgs& Add(FName Name, float Value);
+	FGenericArgs& Add(FName Name, double Value);
+	FGenericArgs& Add(FName Name, FName Value);
+	FGenericArgs& Add(FName Name, const FString& Value);
+	FGenericArgs& Add(FName Name, const TCHAR* Value);
+	FGenericArgs& Add(FName Name, const FVector& Value);
+	FGenericArgs& Add(FName Name, const FRotator& Value);
+	FGenericArgs& Add(FName Name, const UObject* Value);
+
+	FORCEINLINE FGenericArgsView View() const { return FGenericArgsView(Buffer.GetData(), Buffer.Num()); }
+
+	FORCEINLINE int32 Num() const { return View().Num(); }
+	FORCEINLINE int32 IndexOf(FName Name) const { return View().IndexOf(Name); }
+
+	template<typename T>
+	T Get(int32 Index) const { return View().Get<T>(Index); }
+
+	template<typename T>
+	T Get(FName Name) const { return View().Get<T>(Name); }
+
+	/** Remove every argument, keeping the buffer */
+	void Reset() { Buffer.Reset(); }
+
+	/** Packed bytes, as stored in an FGeneric */
+	FORCEINLINE const TArray<uint8>& GetBuffer() const { return Buffer; }
+
+	/** Replace the content with packed bytes, an invalid buffer leaves the list empty */
+	void SetBuffer(const uint8* Data, int32 Size);
+
+	FORCEINLINE bool operator==(const FGenericArgs& Other) const { return Buffer == Other.Buffer; }
+	FORCEINLINE bool operator!=(const FGenericArgs& Other) const { return Buffer != Other.Buffer; }
+
+private:
+	/** Reserve a zeroed value slot and register it in the table */
+	uint8* AddValue(FName Name, EGenericArgType Type, int32 ValueSize, int32 Alignment);
+
+	TArray<uint8> Buffer;
+};
+
+template<>
+struct TStructOpsTypeTraits<FGenericArgs> : public TStructOpsTypeTraitsBase2<FGenericArgs>
+{
+	enum
+	{
+		WithIdenticalViaEquality = true,
+	};
+};
@@ -1,72 +1,646 @@
 // Copyright Liquid Fish. All Rights Reserved.
 
 #include "Generic/GenericDebugUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectIterator.h"
+#include "UObject/UnrealType.h"
 
-void LogGenericValueDetails(const FName& VariableName, const FGeneric& VariableValue, const TCHAR* LogPrefix)
+#if WITH_EDITOR
+#include "Editor.h"
+#include "Engine/Selection.h"
+#endif
+
+namespace GenericFormat
 {
-#if !NO_LOGGING
-	if (!VariableValue.GetStringData().IsEmpty())
+	/** Walks a reflected value and appends it to a string builder within the bounds of FGenericFormatOptions */
+	class FFormatter
 	{
-		UE_LOG(LogMAID, Log, TEXT("%sStackValue: [%s] = \"%s\" (String)"),
-			LogPrefix, *VariableName.ToString(), *VariableValue.GetStringData());
-	}
-	else if (int32 BinarySize = VariableValue.GetPlainSize())
-	{
-		// Convert binary data to hex string
-		const uint8* Data = static_cast<const uint8*>(VariableValue.GetPlainData());
-		FString HexString;
-		for (int32 i = 0; i < BinarySize; ++i)
+	public:
+		FFormatter(FStringBuilderBase& InOut, const FGenericFormatOptions& InOptions)
+			: Out(InOut)
+			, Options(InOptions)
+			, StartLength(InOut.Len())
+		{
+		}
+
+		void FormatGeneric(const FGeneric& Value, int32 Depth)
+		{
+			if (!HasBudget()) return;
+
+			const FProperty* Property = Value.GetValueProperty();
+			if (Property && FGeneric::IsPlain(Property))
+			{
+				if (Value.GetPlainSize() >= Property->GetSize())
+				{
+					FormatProperty(Property, Value.GetPlainData(), Depth);
+					return;
+				}
+			}
+			else if (Property)
+			{
+				FormatTyped(Value, Property, Depth);
+				return;
+			}
+
+			if (!Value.GetStringData().IsEmpty())
+			{
+				AppendQuoted(Value.GetStringData());
+			}
+			else if (Value.GetPlainSize() > 0)
+			{
+				AppendHex(static_cast<const uint8*>(Value.GetPlainData()), Value.GetPlainSize());
+			}
+			else
+			{
+				AppendNone();
+			}
+		}
+
+		void FormatProperty(const FProperty* Property, const void* Address, int32 Depth)
+		{
+			if (GetArrayDim(Property) > 1)
+			{
+				FormatStaticArray(Property, Address, Depth);
+			}
+			else
+			{
+				FormatValue(Property, Address, Depth);
+			}
+		}
+
+		/** Append the truncation marker if the output ran out of budget */
+		void Finish()
+		{
+			if (bTruncated)
+			{
+				Out << TEXT("...");
+			}
+		}
+
+	private:
+		/** Format a single value of a property, ignoring its ArrayDim */
+		void FormatValue(const FProperty* Property, const void* Address, int32 Depth)
+		{
+			if (!HasBudget()) return;
+
+			if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+			{
+				if (StructProperty->Struct == FGeneric::StaticStruct())
+				{
+					FormatGeneric(*static_cast<const FGeneric*>(Address), Depth + 1);
+				}
+				else
+				{
+					FormatStruct(StructProperty->Struct, Address, Depth);
+				}
+			}
+			else if (const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property))
+			{
+				Out << (BoolProperty->GetPropertyValue(Address) ? TEXT("true") : TEXT("false"));
+			}
+			else if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+			{
+				AppendEnum(EnumProperty->GetEnum(), EnumProperty->GetUnderlyingProperty()->GetSignedIntPropertyValue(Address));
+			}
+			else if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+			{
+				if (UEnum* Enum = NumericProperty->GetIntPropertyEnum())
+				{
+					AppendEnum(Enum, NumericProperty->GetSignedIntPropertyValue(Address));
+				}
+				else if (NumericProperty->IsFloatingPoint())
+				{
+					Out.Appendf(TEXT("%g"), NumericProperty->GetFloatingPointPropertyValue(Address));
+				}
+				else if (Property->IsA<FUInt64Property>())
+				{
+					Out.Appendf(TEXT("%llu"), NumericProperty->GetUnsignedIntPropertyValue(Address));
+				}
+				else
+				{
+					Out.Appendf(TEXT("%lld"), NumericProperty->GetSignedIntPropertyValue(Address));
+				}
+			}
+			else if (const FStrProperty* StrProperty = CastField<FStrProperty>(Property))
+			{
+				AppendQuoted(StrProperty->GetPropertyValue(Address));
+			}
+			else if (const FNameProperty* NameProperty = CastField<FNameProperty>(Property))
+			{
+				AppendName(NameProperty->GetPropertyValue(Address));
+			}
+			else if (const FTextProperty* TextProperty = CastField<FTextProperty>(Property))
+			{
+				AppendQuoted(TextProperty->GetPropertyValuePtr(Address)->ToString());
+			}
+			else if (const FSoftObjectProperty* SoftObjectProperty = CastField<FSoftObjectProperty>(Property))
+			{
+				const FSoftObjectPath Path = SoftObjectProperty->GetPropertyValue(Address).ToSoftObjectPath();
+				if (Path.IsNull()) AppendNone();
+				else AppendToken(Path.ToString());
+			}
+			else if (const FObjectPropertyBase* ObjectProperty = CastField<FObjectPropertyBase>(Property))
+			{
+				AppendObject(ObjectProperty->GetObjectPropertyValue(Address));
+			}
+			else if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+			{
+				FScriptArrayHelper Helper(ArrayProperty, Address);
+				const int32 MaxPrinted = GetMaxElements(Depth);
+				int32 Printed = 0;
+				Out << TEXT("[");
+				for (; Printed < Helper.Num() && Printed < MaxPrinted && HasBudget(); ++Printed)
+				{
+					AppendSeparator(Printed);
+					FormatProperty(ArrayProperty->Inner, Helper.GetRawPtr(Printed), Depth + 1);
+				}
+				AppendRemaining(Printed, Helper.Num());
+				Out << TEXT("]");
+			}
+			else if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+			{
+				FScriptSetHelper Helper(SetProperty, Address);
+				const int32 MaxPrinted = GetMaxElements(Depth);
+				int32 Printed = 0;
+				Out << TEXT("[");
+				for (int32 Index = 0; Index < Helper.GetMaxIndex() && Printed < MaxPrinted && HasBudget(); ++Index)
+				{
+					if (!Helper.IsValidIndex(Index)) continue;
+					AppendSeparator(Printed++);
+					FormatProperty(SetProperty->ElementProp, Helper.GetElementPtr(Index), Depth + 1);
+				}
+				AppendRemaining(Printed, Helper.Num());
+				Out << TEXT("]");
+			}
+			else if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+			{
+				FScriptMapHelper Helper(MapProperty, Address);
+				const int32 MaxPrinted = GetMaxElements(Depth);
+				int32 Printed = 0;
+				Out << TEXT("{");
+				for (int32 Index = 0; Index < Helper.GetMaxIndex() && Printed < MaxPrinted && HasBudget(); ++Index)
+				{
+					if (!Helper.IsValidIndex(Index)) continue;
+					AppendSeparator(Printed++);
+					FormatProperty(MapProperty->KeyProp, Helper.GetKeyPtr(Index), Depth + 1);
+					Out << (IsJson() ? TEXT(":") : TEXT(": "));
+					FormatProperty(MapProperty->ValueProp, Helper.GetValuePtr(Index), Depth + 1);
+				}
+				AppendRemaining(Printed, Helper.Num());
+				Out << TEXT("}");
+			}
+			else
+			{
+				// Delegates, interfaces and field paths are rare enough to go through their text export, which allocates
+				FString Exported;
+				Property->ExportText_Direct(Exported, Address, Address, nullptr, PPF_None);
+				AppendToken(Exported);
+			}
+		}
+
+		bool HasBudget()
 		{
-			HexString += FString::Printf(TEXT("%02X "), Data[i]);
+			if (Out.Len() - StartLength < Options.MaxLength) return true;
+			bTruncated = true;
+			return false;
 		}
-		HexString.TrimEndInline();
 
-		FString TypeInfo = FString::Printf(TEXT("Binary (%d bytes): %s"), BinarySize, *HexString);
+		bool IsJson() const { return Options.Style == EGenericFormatStyle::Json; }
 
-		// Try to interpret as common types using As<>() method
-		if (BinarySize == 4)
+		int32 GetMaxElements(int32 Depth) const { return Depth < Options.MaxDepth ? Options.MaxElements : 0; }
+
+		static int32 GetArrayDim(const FProperty* Property)
 		{
-			float AsFloat = VariableValue.As<float>();
-			int32 AsInt32 = VariableValue.As<int32>();
-			uint32 AsUInt32 = VariableValue.As<uint32>();
-			UE_LOG(LogMAID, Log, TEXT("%sStackValue: [%s] = %s | float: %f, int32: %d, uint32: %u"),
-				LogPrefix, *VariableName.ToString(), *TypeInfo, AsFloat, AsInt32, AsUInt32);
+#if UE_VERSION_NEWER_THAN(5, 5, 0)
+			return Property->GetArrayDim();
+#else
+			return Property->ArrayDim;
+#endif
 		}
-		else if (BinarySize == 8)
+
+		/**
+		 * Format a text-stored value from its decoded cache, or import it into a stack temporary of its type
+		 * Importing allocates the strings and containers of the value; values too large for the stack print as text.
+		 */
+		void FormatTyped(const FGeneric& Value, const FProperty* Property, int32 Depth)
 		{
-			double AsDouble = VariableValue.As<double>();
-			int64 AsInt64 = VariableValue.As<int64>();
-			uint64 AsUInt64 = VariableValue.As<uint64>();
-			UE_LOG(LogMAID, Log, TEXT("%sStackValue: [%s] = %s | double: %lf, int64: %lld, uint64: %llu"),
-				LogPrefix, *VariableName.ToString(), *TypeInfo, AsDouble, AsInt64, AsUInt64);
+			if (const void* Cached = Value.FindCachedValue(Property))
+			{
+				FormatProperty(Property, Cached, Depth);
+				return;
+			}
+
+			static constexpr int32 InlineSize = 256;
+			if (Property->GetSize() > InlineSize || Property->GetMinAlignment() > 16)
+			{
+				AppendQuoted(Value.GetStringData());
+				return;
+			}
+
+			alignas(16) uint8 Temp[InlineSize];
+			Property->InitializeValue(Temp);
+			Value.Get(Temp, Property);
+			FormatProperty(Property, Temp, Depth);
+			Property->DestroyValue(Temp);
 		}
-		else if (BinarySize == 2)
+
+		/**
+		 * Authored name of a user-defined struct member: its FName without the "_<Index>_<Guid>" suffix
+		 * GetAuthoredName would build a string, and in the editor it may differ by characters FName cannot hold.
+		 */
+		static FStringView TrimUserStructSuffix(FStringView Name)
 		{
-			int16 AsInt16 = VariableValue.As<int16>();
-			uint16 AsUInt16 = VariableValue.As<uint16>();
-			UE_LOG(LogMAID, Log, TEXT("%sStackValue: [%s] = %s | int16: %d, uint16: %u"),
-				LogPrefix, *VariableName.ToString(), *TypeInfo, AsInt16, AsUInt16);
+			int32 GuidStart = INDEX_NONE;
+			if (!Name.FindLastChar(TEXT('_'), GuidStart) || Name.Len() - GuidStart - 1 != 32) return Name;
+
+			int32 IndexStart = INDEX_NONE;
+			if (!Name.Left(GuidStart).FindLastChar(TEXT('_'), IndexStart) || IndexStart == 0) return Name;
+			return Name.Left(IndexStart);
 		}
-		else if (BinarySize == 1)
+
+		void FormatStruct(const UScriptStruct* Struct, const void* Address, int32 Depth)
+		{
+			if (Depth >= Options.MaxDepth)
+			{
+				Out << (IsJson() ? TEXT("\"(...)\"") : TEXT("(...)"));
+				return;
+			}
+
+			const bool bAuthoredNames = Struct->IsA<UUserDefinedStruct>();
+			int32 Printed = 0;
+			Out << (IsJson() ? TEXT("{") : TEXT("("));
+			for (TFieldIterator<FProperty> It(Struct); It && HasBudget(); ++It)
+			{
+				if (Printed++ > 0) Out << TEXT(",");
+				TStringBuilder<NAME_SIZE> Name;
+				It->GetFName().AppendString(Name);
+				AppendKey(bAuthoredNames ? TrimUserStructSuffix(Name.ToView()) : Name.ToView());
+				FormatProperty(*It, It->ContainerPtrToValuePtr<void>(Address), Depth + 1);
+			}
+			Out << (IsJson() ? TEXT("}") : TEXT(")"));
+		}
+
+		void FormatStaticArray(const FProperty* Property, const void* Address, int32 Depth)
+		{
+			const int32 ArrayDim = GetArrayDim(Property);
+			const int32 MaxPrinted = GetMaxElements(Depth);
+			int32 Printed = 0;
+			Out << TEXT("[");
+			for (; Printed < ArrayDim && Printed < MaxPrinted && HasBudget(); ++Printed)
+			{
+				AppendSeparator(Printed);
+				FormatValue(Property, static_cast<const uint8*>(Address) + Printed * Property->GetElementSize(), Depth + 1);
+			}
+			AppendRemaining(Printed, ArrayDim);
+			Out << TEXT("]");
+		}
+
+		void AppendSeparator(int32 Index)
+		{
+			if (Index > 0) Out << (IsJson() ? TEXT(",") : TEXT(", "));
+		}
+
+		/** Summarize the container elements that were not printed */
+		void AppendRemaining(int32 Printed, int32 Num)
+		{
+			if (Printed >= Num) return;
+			AppendSeparator(Printed);
+			Out.Appendf(IsJson() ? TEXT("\"+%d more\"") : TEXT("+%d more"), Num - Printed);
+		}
+
+		void AppendKey(FStringView Key)
+		{
+			if (IsJson())
+			{
+				AppendQuoted(Key);
+				Out << TEXT(":");
+			}
+			else
+			{
+				Out.Append(Key.GetData(), Key.Len());
+				Out << TEXT("=");
+			}
+		}
+
+		void AppendNone()
+		{
+			Out << (IsJson() ? TEXT("null") : TEXT("None"));
+		}
+
+		/** Append an identifier, quoted in JSON */
+		void AppendToken(FStringView Token)
+		{
+			if (IsJson()) AppendQuoted(Token);
+			else Out.Append(Token.GetData(), Token.Len());
+		}
+
+		void AppendName(FName Name)
+		{
+			TStringBuilder<NAME_SIZE> Builder;
+			Name.AppendString(Builder);
+			AppendToken(Builder.ToView());
+		}
+
+		void AppendEnum(const UEnum* Enum, int64 Value)
+		{
+			const FName Name = Enum ? Enum->GetNameByValue(Value) : NAME_None;
+			if (Name.IsNone())
+			{
+				Out.Appendf(TEXT("%lld"), Value);
+			}
+			else
+			{
+				AppendName(Name);
+			}
+		}
+
+		void AppendObject(const UObject* Object)
+		{
+			if (!Object)
+			{
+				AppendNone();
+				return;
+			}
+			TStringBuilder<256> Path;
+			Object->GetPathName(nullptr, Path);
+			AppendToken(Path.ToView());
+		}
+
+		/** Append a quoted and escaped string, cut when the output runs out of budget */
+		void AppendQuoted(FStringView Text)
 		{
-			int8 AsInt8 = VariableValue.As<int8>();
-			uint8 AsUInt8 = VariableValue.As<uint8>();
-			bool AsBool = VariableValue.As<bool>();
-			UE_LOG(LogMAID, Log, TEXT("%sStackValue: [%s] = %s | int8: %d, uint8: %u, bool: %s"),
-				LogPrefix, *VariableName.ToString(), *TypeInfo, AsInt8, AsUInt8, AsBool ? TEXT("true") : TEXT("false"));
+			Out << TEXT("\"");
+			for (const TCHAR Char : Text)
+			{
+				if (!HasBudget()) break;
+				switch (Char)
+				{
+				case TEXT('"'): Out << TEXT("\\\""); break;
+				case TEXT('\\'): Out << TEXT("\\\\"); break;
+				case TEXT('\n'): Out << TEXT("\\n"); break;
+				case TEXT('\r'): Out << TEXT("\\r"); break;
+				case TEXT('\t'): Out << TEXT("\\t"); break;
+				default:
+					if (Char < 0x20) Out.Appendf(TEXT("\\u%04x"), (uint32)Char);
+					else Out.AppendChar(Char);
+				}
+			}
+			Out << TEXT("\"");
+		}
+
+		/** Append raw bytes of a value without known type */
+		void AppendHex(const uint8* Data, int32 Size)
+		{
+			static const TCHAR Digits[] = TEXT("0123456789ABCDEF");
+			Out << (IsJson() ? TEXT("\"0x") : TEXT("0x"));
+			for (int32 i = 0; i < Size; ++i)
+			{
+				if (!HasBudget()) break;
+				Out.AppendChar(Digits[Data[i] >> 4]);
+				Out.AppendChar(Digits[Data[i] & 0xF]);
+			}
+			if (IsJson()) Out << TEXT("\"");
+		}
+
+		FStringBuilderBase& Out;
+		const FGenericFormatOptions& Options;
+		const int32 StartLength;
+		bool bTruncated = false;
+	};
+}
+
+void FormatGenericValue(FStringBuilderBase& Out, const FGeneric& Value, const FGenericFormatOptions& Options)
+{
+	GenericFormat::FFormatter Formatter(Out, Options);
+	Formatter.FormatGeneric(Value, 0);
+	Formatter.Finish();
+}
+
+void FormatGenericProperty(FStringBuilderBase& Out, const FProperty* Property, const void* Address, const FGenericFormatOptions& Options)
+{
+	if (!(Property && Address)) return;
+	GenericFormat::FFormatter Formatter(Out, Options);
+	Formatter.FormatProperty(Property, Address, 0);
+	Formatter.Finish();
+}
+
+void LogGenericValueDetails(const FName& VariableName, const FGeneric& VariableValue, const TCHAR* LogPrefix)
+{
+#if !NO_LOGGING
+	TStringBuilder<1024> Formatted;
+	FormatGenericValue(Formatted, VariableValue);
+
+	TStringBuilder<NAME_SIZE> Name;
+	VariableName.AppendString(Name);
+
+	if (const FProperty* Property = VariableValue.GetValueProperty())
+	{
+		// Type named from its field class or struct, GetCPPType would build a string
+		TStringBuilder<NAME_SIZE> Type;
+		if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+		{
+			Type << StructProperty->Struct->GetPrefixCPP();
+			StructProperty->Struct->GetFName().AppendString(Type);
 		}
 		else
 		{
-			// Generic binary data
-			UE_LOG(LogMAID, Log, TEXT("%sStackValue: [%s] = %s"),
-				LogPrefix, *VariableName.ToString(), *TypeInfo);
+			Property->GetClass()->GetFName().AppendString(Type);
 		}
+		UE_LOG(LogMAID, Log, TEXT("%sStackValue: [%s] = %s (%s)"),
+			LogPrefix, Name.ToString(), Formatted.ToString(), Type.ToString());
+	}
+	else if (!VariableValue.GetStringData().IsEmpty())
+	{
+		UE_LOG(LogMAID, Log, TEXT("%sStackValue: [%s] = %s (String)"),
+			LogPrefix, Name.ToString(), Formatted.ToString());
+	}
+	else if (!VariableValue.IsEmpty())
+	{
+		UE_LOG(LogMAID, Log, TEXT("%sStackValue: [%s] = %s (Binary, %d bytes)"),
+			LogPrefix, Name.ToString(), Formatted.ToString(), VariableValue.GetPlainSize());
 	}
 	else
 	{
-		// Generic binary data
-		UE_LOG(LogMAID, Log, TEXT("%sStackValue: [%s] = null"), 
-			LogPrefix, *VariableName.ToString());
+		UE_LOG(LogMAID, Log, TEXT("%sStackValue: [%s] = null"),
+			LogPrefix, Name.ToString());
+	}
+#endif
+}
+
+void AccumulateGenericFootprint(const UObject* Object, FGenericFootprint& Footprint)
+{
+	if (!Object) return;
+	for (TPropertyValueIterator<FStructProperty> It(Object->GetClass(), Object); It; ++It)
+	{
+		if (It.Key()->Struct != FGeneric::StaticStruct()) continue;
+
+		const FGeneric* Generic = static_cast<const FGeneric*>(It.Value());
+		++Footprint.Count;
+		Footprint.InlineBytes += sizeof(FGeneric);
+		Footprint.AllocatedBytes += Generic->GetAllocatedSize();
+		It.SkipRecursiveProperty();
+	}
+}
+
+static FAutoConsoleCommand GenericFootprintCommand(
+	TEXT("generic.footprint"),
+	TEXT("Log the memory used by FGeneric values of all loaded objects. Optional argument: class name filter."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			FGenericFootprint Footprint;
+			int32 NumObjects = 0;
+			for (TObjectIterator<UObject> It; It; ++It)
+			{
+				if (Args.Num() > 0 && !It->GetClass()->GetName().Contains(Args[0])) continue;
+				const int64 CountBefore = Footprint.Count;
+				AccumulateGenericFootprint(*It, Footprint);
+				NumObjects += Footprint.Count > CountBefore ? 1 : 0;
+			}
+			UE_LOG(LogMAID, Log, TEXT("Generic footprint: %lld values in %d objects, %lld inline bytes (%d per value), %lld allocated bytes"),
+				Footprint.Count, NumObjects, Footprint.InlineBytes, (int32)sizeof(FGeneric), Footprint.AllocatedBytes);
+		}));
+
+/** Find an object by path or name, "selected" picks the first actor selected in the editor */
+static UObject* FindGenericDebugObject(const FString& Name)
+{
+#if WITH_EDITOR
+	if (Name == TEXT("selected"))
+	{
+		USelection* Selection = GEditor ? GEditor->GetSelectedActors() : nullptr;
+		return Selection && Selection->Num() > 0 ? Selection->GetSelectedObject(0) : nullptr;
 	}
 #endif
-}
\ No newline at end of file
+	if (Name.Contains(TEXT("/")))
+	{
+		return FindObject<UObject>(nullptr, *Name);
+	}
+	for (TObjectIterator<UObject> It; It; ++It)
+	{
+		if (It->GetName() == Name) return *It;
+	}
+	return nullptr;
+}
+
+static FAutoConsoleCommand GenericLogCommand(
+	TEXT("generic.log"),
+	TEXT("Log properties of an object using the FGeneric formatter. Arguments: object path, name or \"selected\"; optional property name (all FGeneric properties when omitted); optional -json."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			TArray<FString> Positional;
+			FGenericFormatOptions Options;
+			for (const FString& Arg : Args)
+			{
+				if (Arg == TEXT("-json")) Options.Style = EGenericFormatStyle::Json;
+				else Positional.Add(Arg);
+			}
+			if (Positional.Num() == 0)
+			{
+				UE_LOG(LogMAID, Warning, TEXT("Usage: generic.log <Object|selected> [Property] [-json]"));
+				return;
+			}
+
+			const UObject* Object = FindGenericDebugObject(Positional[0]);
+			if (!Object)
+			{
+				UE_LOG(LogMAID, Warning, TEXT("generic.log: object '%s' not found"), *Positional[0]);
+				return;
+			}
+
+			TStringBuilder<1024> Formatted;
+			if (Positional.Num() > 1)
+			{
+				const FProperty* Property = Object->GetClass()->FindPropertyByName(FName(*Positional[1]));
+				if (!Property)
+				{
+					UE_LOG(LogMAID, Warning, TEXT("generic.log: %s has no property '%s'"), *Object->GetName(), *Positional[1]);
+					return;
+				}
+				FormatGenericProperty(Formatted, Property, Property->ContainerPtrToValuePtr<void>(Object), Options);
+				UE_LOG(LogMAID, Log, TEXT("%s.%s = %s"), *Object->GetName(), *Property->GetName(), Formatted.ToString());
+				return;
+			}
+
+			int32 NumLogged = 0;
+			for (TPropertyValueIterator<FStructProperty> It(Object->GetClass(), Object); It; ++It)
+			{
+				if (It.Key()->Struct != FGeneric::StaticStruct()) continue;
+
+				Formatted.Reset();
+				FormatGenericValue(Formatted, *static_cast<const FGeneric*>(It.Value()), Options);
+				UE_LOG(LogMAID, Log, TEXT("%s.%s = %s"), *Object->GetName(), *It.Key()->GetName(), Formatted.ToString());
+				It.SkipRecursiveProperty();
+				++NumLogged;
+			}
+			if (NumLogged == 0)
+			{
+				UE_LOG(LogMAID, Log, TEXT("generic.log: %s has no FGeneric properties"), *Object->GetName());
+			}
+		}));
+
+void LogGenericStats(int32 MaxTypes)
+{
+#if !NO_LOGGING
+	if (!FGenericStats::IsEnabled())
+	{
+		UE_LOG(LogMAID, Log, TEXT("Generic stats are not being recorded, enable them with generic.stats.enable 1"));
+	}
+
+	const TArray<FGenericTypeStats> Stats = FGenericStats::GetSnapshot();
+	const int32 NumTypes = MaxTypes > 0 ? FMath::Min(MaxTypes, Stats.Num()) : Stats.Num();
+	UE_LOG(LogMAID, Log, TEXT("Generic stats: %d types"), Stats.Num());
+	UE_LOG(LogMAID, Log, TEXT("%12s %12s %10s %10s %14s %14s  %s"),
+		TEXT("Sets"), TEXT("Gets"), TEXT("CacheHits"), TEXT("CacheMiss"), TEXT("BytesStored"), TEXT("TextParsed"), TEXT("Type"));
+	for (int32 i = 0; i < NumTypes; ++i)
+	{
+		const FGenericTypeStats& Entry = Stats[i];
+		UE_LOG(LogMAID, Log, TEXT("%12lld %12lld %10lld %10lld %14lld %14lld  %s"),
+			Entry.Sets, Entry.Gets, Entry.CacheHits, Entry.CacheMisses, Entry.BytesStored, Entry.TextBytesParsed, *Entry.TypeName);
+	}
+#endif
+}
+
+FString SaveGenericStatsCSV(const FString& FilePath)
+{
+	const FString OutputPath = !FilePath.IsEmpty() ? FilePath
+		: FPaths::ProfilingDir() / TEXT("GenericStats") / FString::Printf(TEXT("GenericStats-%s.csv"), *FDateTime::Now().ToString());
+	if (!FFileHelper::SaveStringToFile(FGenericStats::ToCSV(FGenericStats::GetSnapshot()), *OutputPath))
+	{
+		return FString();
+	}
+	return OutputPath;
+}
+
+static FAutoConsoleCommand GenericStatsCommand(
+	TEXT("generic.stats"),
+	TEXT("Log per-type FGeneric Set/Get statistics recorded while generic.stats.enable is set. Optional argument: number of types to log."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			LogGenericStats(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 0);
+		}));
+
+static FAutoConsoleCommand GenericStatsResetCommand(
+	TEXT("generic.stats.reset"),
+	TEXT("Reset the per-type FGeneric statistics."),
+	FConsoleCommandDelegate::CreateLambda([]()
+		{
+			FGenericStats::Reset();
+			UE_LOG(LogMAID, Log, TEXT("Generic stats reset"));
+		}));
+
+static FAutoConsoleCommand GenericStatsCsvCommand(
+	TEXT("generic.stats.csv"),
+	TEXT("Write the per-type FGeneric statistics to a CSV file. Optional argument: file path."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			const FString OutputPath = SaveGenericStatsCSV(Args.Num() > 0 ? Args[0] : FString());
+			if (OutputPath.IsEmpty())
+			{
+				UE_LOG(LogMAID, Warning, TEXT("Generic stats: failed to write CSV"));
+			}
+			else
+			{
+				UE_LOG(LogMAID, Log, TEXT("Generic stats written to %s"), *FPaths::ConvertRelativePathToFull(OutputPath));
+			}
+		}));
@@ -4,5 +4,73 @@
 
 #include "Core/MaidCoreFwd.h"
 #include "Generic/Generic.h"
+#include "Misc/StringBuilder.h"
+
+/** Notation used by FormatGenericValue */
+enum class EGenericFormatStyle : uint8
+{
+	/** Unreal-like text: (X=1,Y=2), [1, 2], {Key: Value} */
+	Text,
+
+	/** Compact JSON-ish text: {"X":1,"Y":2}, [1,2], {"Key":Value} */
+	Json,
+};
+
+/** Bounds of FormatGenericValue */
+struct FGenericFormatOptions
+{
+	EGenericFormatStyle Style = EGenericFormatStyle::Text;
+
+	/** Elements printed per array, set or map, the remaining ones are only counted */
+	int32 MaxElements = 16;
+
+	/** Nesting depth of structs and containers, deeper values are elided */
+	int32 MaxDepth = 4;
+
+	/** Characters appended before the output is cut with "..." */
+	int32 MaxLength = 1024;
+};
+
+/**
+ * Append a readable representation of a value to a string builder
+ * Values set through FGeneric::Set are printed using their stored type. Values without a known type, such
+ * as freshly loaded ones, fall back to their exported text or a hex dump of their plain data.
+ *
+ * Plain and cached values are formatted in place and only the builder may allocate. A text-stored value
+ * without a cache is decoded into a stack temporary first, which allocates for its strings and containers.
+ */
+void MAIDGAME_API FormatGenericValue(FStringBuilderBase& Out, const FGeneric& Value, const FGenericFormatOptions& Options = FGenericFormatOptions());
+
+/** Append a readable representation of a reflected property value to a string builder */
+void MAIDGAME_API FormatGenericProperty(FStringBuilderBase& Out, const FProperty* Property, const void* Address, const FGenericFormatOptions& Options = FGenericFormatOptions());
 
 void MAIDGAME_API LogGenericValueDetails(const FName& VariableName, const FGeneric& VariableValue, const TCHAR* LogPrefix = TEXT(""));
+
+/** Memory used by FGeneric values */
+struct FGenericFootprint
+{
+	/** Number of FGeneric values visited */
+	int64 Count = 0;
+
+	/** Bytes taken by the FGeneric instances themselves */
+	int64 InlineBytes = 0;
+
+	/** Heap bytes owned by the visited values, see FGeneric::GetAllocatedSize */
+	int64 AllocatedBytes = 0;
+};
+
+/** Accumulate the footprint of every FGeneric reachable through the reflected properties of an object, including containers */
+void MAIDGAME_API AccumulateGenericFootprint(const UObject* Object, FGenericFootprint& Footprint);
+
+/**
+ * Log the per-type statistics recorded by FGenericStats, busiest types first
+ * @param MaxTypes - Number of types to log, all when 0
+ */
+void MAIDGAME_API LogGenericStats(int32 MaxTypes = 0);
+
+/**
+ * Write the per-type statistics recorded by FGenericStats to a CSV file
+ * @param FilePath - Destination file, a timestamped file under Saved/Profiling/GenericStats when empty
+ * @return Path of the written file, empty on failure
+ */
+FString MAIDGAME_API SaveGenericStatsCSV(const FString& FilePath = FString());
@@ -7,6 +7,33 @@
 
 #include "GenericEvent.Generated.h"
 
+/**
+ * Answers a generic request, possibly later and from any thread
+ *
+ * Copies share the same request and only the first Complete counts. If every copy is destroyed before the
+ * request is completed, it completes with FGeneric::Null so the sender never waits forever.
+ */
+class MAIDGAME_API FGenericResponder
+{
+public:
+	FGenericResponder() = default;
+	explicit FGenericResponder(TUniqueFunction<void(FGeneric&&)> OnComplete);
+
+	/** @return False if the request was already completed */
+	bool Complete(FGeneric Value) const;
+
+	bool IsCompleted() const;
+
+	FORCEINLINE bool IsValid() const { return State.IsValid(); }
+
+	/** Drop this copy, completing the request with Null if it was the last one */
+	FORCEINLINE void Reset() { State.Reset(); }
+
+private:
+	struct FState;
+	TSharedPtr<FState, ESPMode::ThreadSafe> State;
+};
+
 /**
  * Interface for objects that can receive and handle generic events
  *
@@ -53,4 +80,18 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintNativeEvent, Category = "Event", Meta = (AutoCreateRefTerm = "Args"))
 	FGeneric HandleGenericEvent(UObject* Source, FName EventName, const FGeneric& Args);
 	virtual FGeneric HandleGenericEvent_Implementation(UObject* Source, FName EventName, const FGeneric& Args) { return FGeneric::Null; }
+
+	/**
+	 * Handles a generic request that may be answered later
+	 *
+	 * Keep a copy of the responder and complete it once the result is known, from any thread. Args is only
+	 * valid during the call. The default implementation answers at once with HandleGenericEvent, which is
+	 * also how Blueprint handlers answer.
+	 *
+	 * @see FGenericEventDispatcher::Request
+	 */
+	virtual void HandleGenericRequest(UObject* Source, FName EventName, const FGeneric& Args, const FGenericResponder& Responder)
+	{
+		Responder.Complete(Execute_HandleGenericEvent(_getUObject(), Source, EventName, Args));
+	}
 };
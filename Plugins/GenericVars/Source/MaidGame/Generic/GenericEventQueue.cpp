@@ -0,0 +1,147 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#include "Generic/GenericEventQueue.h"
+
+FGenericEventQueue::FGenericEventQueue(int32 Capacity)
+{
+	const uint64 NumCells = FMath::RoundUpToPowerOfTwo((uint32)FMath::Max(Capacity, 2));
+	Mask = NumCells - 1;
+	Cells = new FCell[NumCells];
+	for (uint64 Index = 0; Index < NumCells; ++Index)
+	{
+		Cells[Index].Sequence.store(Index, std::memory_order_relaxed);
+	}
+}
+
+FGenericEventQueue::~FGenericEventQueue()
+{
+	delete[] Cells;
+}
+
+template<typename ArgsType>
+void FGenericEventQueue::Enqueue(UObject* Target, UObject* Source, FName EventName, ArgsType&& Args, bool bBroadcast)
+{
+	if (IsClosed()) return;
+	NumEnqueued.fetch_add(1, std::memory_order_relaxed);
+
+	// Bounded ring: a cell is free for position Pos once its sequence equals Pos
+	uint64 Pos = EnqueuePos.load(std::memory_order_relaxed);
+	FCell* Cell = nullptr;
+	for (;;)
+	{
+		Cell = &Cells[Pos & Mask];
+		const uint64 Sequence = Cell->Sequence.load(std::memory_order_acquire);
+		const int64 Diff = (int64)Sequence - (int64)Pos;
+		if (Diff == 0)
+		{
+			if (EnqueuePos.compare_exchange_weak(Pos, Pos + 1, std::memory_order_relaxed)) break;
+		}
+		else if (Diff < 0)
+		{
+			// The consumer has not released this cell yet, the ring is full
+			Cell = nullptr;
+			break;
+		}
+		else
+		{
+			Pos = EnqueuePos.load(std::memory_order_relaxed);
+		}
+	}
+
+	if (!Cell)
+	{
+		FGenericQueuedEvent Event;
+		Event.Target = Target;
+		Event.Source = Source;
+		Event.EventName = EventName;
+		Event.Args = Forward<ArgsType>(Args);
+		Event.bBroadcast = bBroadcast;
+		Overflow.Enqueue(MoveTemp(Event));
+		NumOverflowPending.fetch_add(1, std::memory_order_release);
+		NumOverflowed.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	Cell->Event.Target = Target;
+	Cell->Event.Source = Source;
+	Cell->Event.EventName = EventName;
+	Cell->Event.Args = Forward<ArgsType>(Args);
+	Cell->Event.bBroadcast = bBroadcast;
+	Cell->Sequence.store(Pos + 1, std::memory_order_release);
+}
+
+void FGenericEventQueue::EnqueueSend(UObject* Target, UObject* Source, FName EventName, const FGeneric& Args)
+{
+	Enqueue(Target, Source, EventName, Args, false);
+}
+
+void FGenericEventQueue::EnqueueSend(UObject* Target, UObject* Source, FName EventName, FGeneric&& Args)
+{
+	Enqueue(Target, Source, EventName, MoveTemp(Args), false);
+}
+
+void FGenericEventQueue::EnqueueBroadcast(UObject* Source, FName EventName, const FGeneric& Args)
+{
+	Enqueue(nullptr, Source, EventName, Args, true);
+}
+
+void FGenericEventQueue::EnqueueBroadcast(UObject* Source, FName EventName, FGeneric&& Args)
+{
+	Enqueue(nullptr, Source, EventName, MoveTemp(Args), true);
+}
+
+int32 FGenericEventQueue::Drain(int32 MaxEvents, TFunctionRef<void(const FGenericQueuedEvent&)> Deliver)
+{
+	const int32 Limit = MaxEvents > 0 ? MaxEvents : MAX_int32;
+	int32 NumDrained = 0;
+	while (NumDrained < Limit)
+	{
+		FCell& Cell = Cells[DequeuePos & Mask];
+		const uint64 Sequence = Cell.Sequence.load(std::memory_order_acquire);
+		if ((int64)Sequence - (int64)(DequeuePos + 1) < 0) break;
+
+		// Claimed before delivery, so a handler draining again moves on to the next event
+		const uint64 Position = DequeuePos++;
+
+		// Delivered in place, the cell keeps its payload buffers for the next producer
+		Deliver(Cell.Event);
+		Cell.Event.Target.Reset();
+		Cell.Event.Source.Reset();
+		Cell.Sequence.store(Position + Mask + 1, std::memory_order_release);
+		++NumDrained;
+	}
+
+	FGenericQueuedEvent Event;
+	while (NumDrained < Limit && Overflow.Dequeue(Event))
+	{
+		NumOverflowPending.fetch_sub(1, std::memory_order_relaxed);
+		Deliver(Event);
+		++NumDrained;
+	}
+
+	NumDelivered += NumDrained;
+	return NumDrained;
+}
+
+void FGenericEventQueue::Close()
+{
+	bClosed.store(true, std::memory_order_release);
+
+	// An event published by a producer that passed the check just before stays in its cell until destruction
+	Drain(0, [](const FGenericQueuedEvent&) {});
+}
+
+int32 FGenericEventQueue::Num() const
+{
+	const int64 InRing = (int64)EnqueuePos.load(std::memory_order_relaxed) - (int64)DequeuePos;
+	return (int32)FMath::Max<int64>(InRing + NumOverflowPending.load(std::memory_order_relaxed), 0);
+}
+
+FGenericEventQueue::FStats FGenericEventQueue::GetStats() const
+{
+	FStats Stats;
+	Stats.Enqueued = NumEnqueued.load(std::memory_order_relaxed);
+	Stats.Overflowed = NumOverflowed.load(std::memory_order_relaxed);
+	Stats.Delivered = NumDelivered;
+	return Stats;
+}
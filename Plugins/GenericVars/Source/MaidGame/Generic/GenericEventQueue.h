@@ -0,0 +1,104 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#pragma once
+
+#include "Core/MaidCoreFwd.h"
+#include "Generic/Generic.h"
+#include "Containers/Queue.h"
+#include <atomic>
+
+/** Generic event raised off the game thread, waiting for delivery */
+struct FGenericQueuedEvent
+{
+	/** Handler the event is sent to, unused for a broadcast */
+	TWeakObjectPtr<UObject> Target;
+	TWeakObjectPtr<UObject> Source;
+	FName EventName;
+	FGeneric Args;
+	bool bBroadcast = false;
+};
+
+/**
+ * Multi-producer, single-consumer queue of generic events
+ *
+ * Any thread may enqueue; only one thread, normally the game thread, drains. Events are stored in a ring of
+ * preallocated cells claimed with a compare-and-swap, so enqueueing takes no lock and allocates nothing
+ * beyond the payload itself. A cell keeps its FGeneric after delivery: enqueueing a copy of Args reuses the
+ * buffers left by the previous event of that cell.
+ *
+ * When the ring is full, events spill into an unbounded lock-free overflow queue that allocates per event.
+ * Events of one producer are delivered in order unless they spill.
+ */
+class MAIDGAME_API FGenericEventQueue : public FNoncopyable
+{
+public:
+	struct FStats
+	{
+		int64 Enqueued = 0;
+		int64 Overflowed = 0;
+		int64 Delivered = 0;
+	};
+
+	/** @param Capacity - Number of ring cells, rounded up to a power of two */
+	explicit FGenericEventQueue(int32 Capacity);
+	~FGenericEventQueue();
+
+	/** Queue an event for a handler, callable from any thread */
+	void EnqueueSend(UObject* Target, UObject* Source, FName EventName, const FGeneric& Args);
+	void EnqueueSend(UObject* Target, UObject* Source, FName EventName, FGeneric&& Args);
+
+	/** Queue an event for all subscribers, callable from any thread */
+	void EnqueueBroadcast(UObject* Source, FName EventName, const FGeneric& Args);
+	void EnqueueBroadcast(UObject* Source, FName EventName, FGeneric&& Args);
+
+	/**
+	 * Deliver queued events, only from the consumer thread
+	 * A handler may drain again, it is delivered the events queued after its own.
+	 * @param MaxEvents - Events to deliver at most, all queued events when 0 or less
+	 * @return Number of events delivered
+	 */
+	int32 Drain(int32 MaxEvents, TFunctionRef<void(const FGenericQueuedEvent&)> Deliver);
+
+	/**
+	 * Stop accepting events and drop the queued ones, only from the consumer thread
+	 * Producers still holding the queue may keep enqueueing, their events are discarded.
+	 */
+	void Close();
+
+	FORCEINLINE bool IsClosed() const { return bClosed.load(std::memory_order_acquire); }
+
+	/** Approximate number of queued events */
+	int32 Num() const;
+
+	FORCEINLINE int32 GetCapacity() const { return (int32)(Mask + 1); }
+
+	FStats GetStats() const;
+
+private:
+	struct FCell
+	{
+		std::atomic<uint64> Sequence{ 0 };
+		FGenericQueuedEvent Event;
+	};
+
+	template<typename ArgsType>
+	void Enqueue(UObject* Target, UObject* Source, FName EventName, ArgsType&& Args, bool bBroadcast);
+
+	FCell* Cells = nullptr;
+	uint64 Mask = 0;
+
+	/** Next position claimed by a producer */
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> EnqueuePos{ 0 };
+
+	/** Next position read by the consumer */
+	alignas(PLATFORM_CACHE_LINE_SIZE) uint64 DequeuePos = 0;
+
+	TQueue<FGenericQueuedEvent, EQueueMode::Mpsc> Overflow;
+	std::atomic<int64> NumOverflowPending{ 0 };
+
+	std::atomic<bool> bClosed{ false };
+
+	std::atomic<int64> NumEnqueued{ 0 };
+	std::atomic<int64> NumOverflowed{ 0 };
+	int64 NumDelivered = 0;
+};
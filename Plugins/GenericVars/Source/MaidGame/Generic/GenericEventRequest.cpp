@@ -0,0 +1,112 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#include "Generic/GenericEventRequest.h"
+#include "Generic/GenericEvent.h"
+#include "Generic/GenericEventSubsystem.h"
+#include "Async/Async.h"
+#include <atomic>
+
+struct FGenericResponder::FState
+{
+	TUniqueFunction<void(FGeneric&&)> OnComplete;
+	std::atomic<bool> bCompleted{ false };
+
+	~FState()
+	{
+		if (!bCompleted.exchange(true))
+		{
+			OnComplete(FGeneric());
+		}
+	}
+};
+
+FGenericResponder::FGenericResponder(TUniqueFunction<void(FGeneric&&)> OnComplete)
+	: State(MakeShared<FState, ESPMode::ThreadSafe>())
+{
+	State->OnComplete = MoveTemp(OnComplete);
+}
+
+bool FGenericResponder::Complete(FGeneric Value) const
+{
+	if (!State || State->bCompleted.exchange(true)) return false;
+
+	State->OnComplete(MoveTemp(Value));
+	return true;
+}
+
+bool FGenericResponder::IsCompleted() const
+{
+	return State && State->bCompleted.load();
+}
+
+UGenericEventRequestAction* UGenericEventRequestAction::RequestGenericEvent(UObject* WorldContextObject, UObject* Target, UObject* Source, FName EventName, const FGeneric& Args)
+{
+	UGenericEventRequestAction* Action = NewObject<UGenericEventRequestAction>();
+	Action->WorldContext = WorldContextObject;
+	Action->Target = Target;
+	Action->Source = Source;
+	Action->EventName = EventName;
+	Action->Args = Args;
+	Action->RegisterWithGameInstance(WorldContextObject);
+	return Action;
+}
+
+UGenericEventRequestAction* UGenericEventRequestAction::RequestGenericEventAll(UObject* WorldContextObject, UObject* Source, FName EventName, const FGeneric& Args)
+{
+	UGenericEventRequestAction* Action = RequestGenericEvent(WorldContextObject, nullptr, Source, EventName, Args);
+	Action->bAllHandlers = true;
+	return Action;
+}
+
+void UGenericEventRequestAction::Activate()
+{
+	// Answers may arrive on any thread, Completed is always broadcast on the game thread
+	TWeakObjectPtr<UGenericEventRequestAction> WeakThis(this);
+	auto Deliver = [WeakThis](TArray<FGeneric>&& Results)
+		{
+			auto Finish = [WeakThis, Results = MoveTemp(Results)]() mutable
+				{
+					if (UGenericEventRequestAction* Action = WeakThis.Get())
+					{
+						Action->Finish(MoveTemp(Results));
+					}
+				};
+			if (IsInGameThread())
+			{
+				Finish();
+			}
+			else
+			{
+				AsyncTask(ENamedThreads::GameThread, MoveTemp(Finish));
+			}
+		};
+
+	if (!bAllHandlers)
+	{
+		FGenericEventDispatcher::Request(Target.Get(), Source.Get(), EventName, Args).Next([Deliver](FGeneric Result)
+			{
+				TArray<FGeneric> Results;
+				Results.Add(MoveTemp(Result));
+				Deliver(MoveTemp(Results));
+			});
+		return;
+	}
+
+	UGenericEventSubsystem* Subsystem = UGenericEventSubsystem::Get(WorldContext.Get());
+	if (!Subsystem)
+	{
+		Finish(TArray<FGeneric>());
+		return;
+	}
+	Subsystem->RequestAll(Source.Get(), EventName, Args).Next([Deliver](TArray<FGeneric> Results)
+		{
+			Deliver(MoveTemp(Results));
+		});
+}
+
+void UGenericEventRequestAction::Finish(TArray<FGeneric>&& Results)
+{
+	Completed.Broadcast(Results.Num() > 0 ? Results[0] : FGeneric::Null, Results);
+	Args.Clear();
+	SetReadyToDestroy();
+}
@@ -0,0 +1,55 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#pragma once
+
+#include "Core/MaidCoreFwd.h"
+#include "Generic/Generic.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+
+#include "GenericEventRequest.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FGenericRequestCompleted, const FGeneric&, Result, const TArray<FGeneric>&, Results);
+
+/**
+ * Latent Blueprint node sending a generic request and firing Completed on the game thread once answered
+ *
+ * Result is the first answer, Results holds the answers of every handler in subscription order.
+ * @see FGenericEventDispatcher::Request, FGenericEventDispatcher::RequestAll
+ */
+UCLASS()
+class MAIDGAME_API UGenericEventRequestAction : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintAssignable)
+	FGenericRequestCompleted Completed;
+
+	/** Send a request to a single handler and wait for its answer */
+	UFUNCTION(BlueprintCallable, Category = "Event", Meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject", AutoCreateRefTerm = "Args"))
+	static UGenericEventRequestAction* RequestGenericEvent(UObject* WorldContextObject, UObject* Target, UObject* Source, FName EventName, const FGeneric& Args);
+
+	/** Send a request to every handler subscribed to EventName and wait for all answers */
+	UFUNCTION(BlueprintCallable, Category = "Event", Meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject", AutoCreateRefTerm = "Args"))
+	static UGenericEventRequestAction* RequestGenericEventAll(UObject* WorldContextObject, UObject* Source, FName EventName, const FGeneric& Args);
+
+	virtual void Activate() override;
+
+private:
+	void Finish(TArray<FGeneric>&& Results);
+
+	UPROPERTY()
+	TWeakObjectPtr<UObject> WorldContext;
+
+	UPROPERTY()
+	TWeakObjectPtr<UObject> Target;
+
+	UPROPERTY()
+	TWeakObjectPtr<UObject> Source;
+
+	FName EventName;
+
+	UPROPERTY()
+	FGeneric Args;
+	bool bAllHandlers = false;
+};
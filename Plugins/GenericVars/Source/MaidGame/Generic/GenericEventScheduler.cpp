@@ -0,0 +1,205 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#include "Generic/GenericEventScheduler.h"
+
+FGenericEventScheduler::FGenericEventScheduler(float InResolution)
+	: Resolution(FMath::Max(InResolution, KINDA_SMALL_NUMBER))
+{
+	for (int32& Head : Buckets)
+	{
+		Head = INDEX_NONE;
+	}
+}
+
+FGenericEventTimerHandle FGenericEventScheduler::Schedule(float Delay, UObject* Target, UObject* Source, FName EventName, const FGeneric& Args, bool bBroadcast)
+{
+	// Time already accumulated towards the next tick counts as elapsed, so the event never fires early
+	static constexpr double MaxTicks = (double)MAX_uint32;
+	const double Ticks = FMath::CeilToDouble((FMath::Max(Delay, 0.0f) + Accumulator) / Resolution);
+
+	const int32 Index = AllocateTimer();
+	FTimer& Timer = GetTimer(Index);
+	Timer.Event.Target = Target;
+	Timer.Event.Source = Source;
+	Timer.Event.EventName = EventName;
+	Timer.Event.Args = Args;
+	Timer.Event.bBroadcast = bBroadcast;
+	Timer.Deadline = Now + (uint64)FMath::Clamp(Ticks, 1.0, MaxTicks);
+	Timer.State = ETimerState::Pending;
+	Link(Index);
+	++NumPending;
+	return FGenericEventTimerHandle(Index, Timer.Generation);
+}
+
+bool FGenericEventScheduler::Cancel(FGenericEventTimerHandle Handle)
+{
+	if (!IsScheduled(Handle)) return false;
+
+	const int32 Index = Handle.GetIndex();
+	if (GetTimer(Index).State == ETimerState::Pending)
+	{
+		Unlink(Index);
+	}
+	ReleaseTimer(Index);
+	return true;
+}
+
+bool FGenericEventScheduler::IsScheduled(FGenericEventTimerHandle Handle) const
+{
+	const int32 Index = Handle.GetIndex();
+	if (!Handle.IsValid() || Index >= NumTimers) return false;
+
+	const FTimer& Timer = GetTimer(Index);
+	return Timer.Generation == Handle.GetGeneration() && Timer.State != ETimerState::Free;
+}
+
+int32 FGenericEventScheduler::Advance(float DeltaSeconds, TFunctionRef<void(const FGenericQueuedEvent&)> Deliver)
+{
+	Accumulator += FMath::Max(DeltaSeconds, 0.0f);
+	const uint64 Ticks = (uint64)(Accumulator / Resolution);
+	Accumulator -= (float)((double)Ticks * Resolution);
+
+	int32 NumFired = 0;
+	for (uint64 Tick = 0; Tick < Ticks; ++Tick)
+	{
+		if (NumPending == 0)
+		{
+			Now += Ticks - Tick;
+			break;
+		}
+
+		++Now;
+		Cascade();
+
+		int32& Head = Buckets[Now & BucketMask];
+		for (int32 Index = Head; Index != INDEX_NONE; Index = GetTimer(Index).Next)
+		{
+			FTimer& Timer = GetTimer(Index);
+			Timer.State = ETimerState::Due;
+			Timer.Bucket = INDEX_NONE;
+			Batch.Emplace(Index, Timer.Generation);
+		}
+		Head = INDEX_NONE;
+
+		// Handlers may cancel due events of the same batch or schedule new ones
+		for (const TPair<int32, uint32>& Entry : Batch)
+		{
+			FTimer& Timer = GetTimer(Entry.Key);
+			if (Timer.Generation != Entry.Value || Timer.State != ETimerState::Due) continue;
+
+			Deliver(Timer.Event);
+			++NumFired;
+			if (Timer.Generation == Entry.Value && Timer.State == ETimerState::Due)
+			{
+				ReleaseTimer(Entry.Key);
+			}
+		}
+		Batch.Reset();
+	}
+	return NumFired;
+}
+
+void FGenericEventScheduler::Reset()
+{
+	for (int32 Index = 0; Index < NumTimers; ++Index)
+	{
+		if (GetTimer(Index).State != ETimerState::Free)
+		{
+			ReleaseTimer(Index);
+		}
+	}
+	for (int32& Head : Buckets)
+	{
+		Head = INDEX_NONE;
+	}
+}
+
+int32 FGenericEventScheduler::AllocateTimer()
+{
+	if (FreeList.Num() > 0)
+	{
+		return FreeList.Pop();
+	}
+	if (NumTimers == Pages.Num() * PageSize)
+	{
+		Pages.Add(MakeUnique<FTimer[]>(PageSize));
+	}
+	return NumTimers++;
+}
+
+void FGenericEventScheduler::ReleaseTimer(int32 Index)
+{
+	// Args stay in the slot, the next event scheduled into it reuses their buffers
+	FTimer& Timer = GetTimer(Index);
+	Timer.Event.Target.Reset();
+	Timer.Event.Source.Reset();
+	Timer.State = ETimerState::Free;
+	Timer.Prev = Timer.Next = Timer.Bucket = INDEX_NONE;
+	++Timer.Generation;
+	FreeList.Add(Index);
+	--NumPending;
+}
+
+void FGenericEventScheduler::Link(int32 Index)
+{
+	FTimer& Timer = GetTimer(Index);
+	const uint64 Deadline = FMath::Max(Timer.Deadline, Now);
+
+	int32 Level = 0;
+	while (Level < NumLevels - 1 && ((Deadline >> (LevelBits * Level)) - (Now >> (LevelBits * Level))) >= (uint64)NumBuckets)
+	{
+		++Level;
+	}
+	const uint64 Slot = (Deadline >> (LevelBits * Level)) & BucketMask;
+	Timer.Bucket = Level * NumBuckets + (int32)Slot;
+
+	int32& Head = Buckets[Timer.Bucket];
+	Timer.Prev = INDEX_NONE;
+	Timer.Next = Head;
+	if (Head != INDEX_NONE)
+	{
+		GetTimer(Head).Prev = Index;
+	}
+	Head = Index;
+}
+
+void FGenericEventScheduler::Unlink(int32 Index)
+{
+	FTimer& Timer = GetTimer(Index);
+	if (Timer.Prev != INDEX_NONE)
+	{
+		GetTimer(Timer.Prev).Next = Timer.Next;
+	}
+	else if (Timer.Bucket != INDEX_NONE)
+	{
+		Buckets[Timer.Bucket] = Timer.Next;
+	}
+	if (Timer.Next != INDEX_NONE)
+	{
+		GetTimer(Timer.Next).Prev = Timer.Prev;
+	}
+	Timer.Prev = Timer.Next = Timer.Bucket = INDEX_NONE;
+}
+
+void FGenericEventScheduler::Cascade()
+{
+	int32 TopLevel = 0;
+	while (TopLevel < NumLevels - 1 && (Now & ((1ull << (LevelBits * (TopLevel + 1))) - 1)) == 0)
+	{
+		++TopLevel;
+	}
+
+	// Coarser wheels first, their timers may land in a finer bucket that turns at this tick too
+	for (int32 Level = TopLevel; Level > 0; --Level)
+	{
+		int32& Head = Buckets[Level * NumBuckets + (int32)((Now >> (LevelBits * Level)) & BucketMask)];
+		int32 Index = Head;
+		Head = INDEX_NONE;
+		while (Index != INDEX_NONE)
+		{
+			const int32 Next = GetTimer(Index).Next;
+			Link(Index);
+			Index = Next;
+		}
+	}
+}
@@ -0,0 +1,129 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#pragma once
+
+#include "Core/MaidCoreFwd.h"
+#include "Generic/GenericEventQueue.h"
+
+#include "GenericEventScheduler.generated.h"
+
+/** Identifies an event scheduled with FGenericEventScheduler */
+USTRUCT(BlueprintType)
+struct MAIDGAME_API FGenericEventTimerHandle
+{
+	GENERATED_BODY()
+
+	FGenericEventTimerHandle() = default;
+
+	FORCEINLINE bool IsValid() const { return Value != 0; }
+	FORCEINLINE void Invalidate() { Value = 0; }
+
+	FORCEINLINE bool operator==(const FGenericEventTimerHandle& Other) const { return Value == Other.Value; }
+	FORCEINLINE bool operator!=(const FGenericEventTimerHandle& Other) const { return Value != Other.Value; }
+	friend FORCEINLINE uint32 GetTypeHash(const FGenericEventTimerHandle& Handle) { return GetTypeHash(Handle.Value); }
+
+private:
+	friend class FGenericEventScheduler;
+
+	FGenericEventTimerHandle(int32 Index, uint32 Generation)
+		: Value(((uint64)Generation << 32) | (uint64)(Index + 1))
+	{
+	}
+
+	FORCEINLINE int32 GetIndex() const { return (int32)(Value & 0xFFFFFFFF) - 1; }
+	FORCEINLINE uint32 GetGeneration() const { return (uint32)(Value >> 32); }
+
+	uint64 Value = 0;
+};
+
+/**
+ * Deferred generic events on a hierarchical timing wheel
+ *
+ * Time advances in ticks of a fixed resolution. Four wheels of 256 buckets cover 256, 256^2, 256^3 and 256^4
+ * ticks; a timer is filed in the finest wheel that reaches its deadline and moves down one wheel each time
+ * the coarser one turns. Scheduling and cancelling are O(1), and each tick fires one bucket as a batch.
+ *
+ * Pending events live in pooled slots with stable addresses. A slot keeps its FGeneric after firing, so
+ * scheduling a copy of Args reuses the buffers of a previous event. Game thread only.
+ */
+class MAIDGAME_API FGenericEventScheduler : public FNoncopyable
+{
+public:
+	/** @param InResolution - Seconds per tick, deadlines are rounded up to it */
+	explicit FGenericEventScheduler(float InResolution = 0.01f);
+
+	/** Schedule an event for a handler, or for all subscribers when bBroadcast is set */
+	FGenericEventTimerHandle Schedule(float Delay, UObject* Target, UObject* Source, FName EventName, const FGeneric& Args, bool bBroadcast = false);
+
+	/** @return True if the event was pending and will not fire */
+	bool Cancel(FGenericEventTimerHandle Handle);
+
+	bool IsScheduled(FGenericEventTimerHandle Handle) const;
+
+	/**
+	 * Advance the time and fire the events that became due, bucket by bucket
+	 * @return Number of events fired
+	 */
+	int32 Advance(float DeltaSeconds, TFunctionRef<void(const FGenericQueuedEvent&)> Deliver);
+
+	/** Number of pending events */
+	FORCEINLINE int32 Num() const { return NumPending; }
+
+	FORCEINLINE float GetResolution() const { return Resolution; }
+
+	/** Cancel every pending event */
+	void Reset();
+
+private:
+	static constexpr int32 NumLevels = 4;
+	static constexpr int32 LevelBits = 8;
+	static constexpr int32 NumBuckets = 1 << LevelBits;
+	static constexpr uint64 BucketMask = NumBuckets - 1;
+	static constexpr int32 PageSize = 256;
+
+	enum class ETimerState : uint8
+	{
+		Free,
+		Pending,
+		Due,
+	};
+
+	struct FTimer
+	{
+		FGenericQueuedEvent Event;
+		uint64 Deadline = 0;
+		int32 Prev = INDEX_NONE;
+		int32 Next = INDEX_NONE;
+		int32 Bucket = INDEX_NONE;
+		uint32 Generation = 1;
+		ETimerState State = ETimerState::Free;
+	};
+
+	FTimer& GetTimer(int32 Index) { return Pages[Index / PageSize][Index % PageSize]; }
+	const FTimer& GetTimer(int32 Index) const { return Pages[Index / PageSize][Index % PageSize]; }
+
+	int32 AllocateTimer();
+	void ReleaseTimer(int32 Index);
+
+	/** File a pending timer in the bucket matching its deadline */
+	void Link(int32 Index);
+	void Unlink(int32 Index);
+
+	/** Re-file the timers of coarser wheels that turned at the current tick */
+	void Cascade();
+
+	/** Slots are allocated in pages so delivering from a slot stays valid while handlers schedule more */
+	TArray<TUniquePtr<FTimer[]>> Pages;
+	TArray<int32> FreeList;
+	int32 NumTimers = 0;
+	int32 NumPending = 0;
+
+	int32 Buckets[NumLevels * NumBuckets];
+
+	/** Timers due at the current tick, with the generation they had when collected */
+	TArray<TPair<int32, uint32>> Batch;
+
+	uint64 Now = 0;
+	float Accumulator = 0.0f;
+	float Resolution = 0.01f;
+};
@@ -0,0 +1,711 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#include "Generic/GenericEventSubsystem.h"
+#include "Generic/GenericArena.h"
+#include "Generic/GenericEvent.h"
+#include "Generic/GenericObserver.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/EngineVersionComparison.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/ObjectKey.h"
+#include <atomic>
+
+static int32 GGenericEventQueueCapacity = 1024;
+static FAutoConsoleVariableRef CVarGenericEventQueueCapacity(
+	TEXT("generic.eventqueue.capacity"),
+	GGenericEventQueueCapacity,
+	TEXT("Ring cells of the generic event queue of worlds created afterwards, rounded up to a power of two."));
+
+static int32 GGenericEventQueueTickGroup = TG_PrePhysics;
+static FAutoConsoleVariableRef CVarGenericEventQueueTickGroup(
+	TEXT("generic.eventqueue.tickgroup"),
+	GGenericEventQueueTickGroup,
+	TEXT("ETickingGroup in which queued generic events are delivered, for worlds created afterwards (0: PrePhysics ... 5: PostUpdateWork)."));
+
+static int32 GGenericEventQueueMaxPerFrame = 0;
+static FAutoConsoleVariableRef CVarGenericEventQueueMaxPerFrame(
+	TEXT("generic.eventqueue.maxperframe"),
+	GGenericEventQueueMaxPerFrame,
+	TEXT("Queued generic events delivered per frame at most, the rest waits for the next frame (0: all)."));
+
+static float GGenericSchedulerResolution = 0.01f;
+static FAutoConsoleVariableRef CVarGenericSchedulerResolution(
+	TEXT("generic.scheduler.resolution"),
+	GGenericSchedulerResolution,
+	TEXT("Seconds per tick of the generic event scheduler of worlds created afterwards, delays are rounded up to it."));
+
+static int32 GGenericEventParallelBatch = 32;
+static FAutoConsoleVariableRef CVarGenericEventParallelBatch(
+	TEXT("generic.event.parallelbatch"),
+	GGenericEventParallelBatch,
+	TEXT("Thread-safe generic event handlers run by one worker task of a parallel broadcast."));
+
+static int32 GGenericEventParallelMin = 64;
+static FAutoConsoleVariableRef CVarGenericEventParallelMin(
+	TEXT("generic.event.parallelmin"),
+	GGenericEventParallelMin,
+	TEXT("Thread-safe generic event handlers needed before a parallel broadcast uses worker threads, fewer run on the calling thread."));
+
+static bool IsGenericEventHandler(const UObject* Object)
+{
+	return Object && Object->GetClass()->ImplementsInterface(UGenericEventHandler::StaticClass());
+}
+
+/** Call a handler, skipping ProcessEvent when the class has no Blueprint override */
+static FORCEINLINE FGeneric InvokeHandler(UObject* Handler, IGenericEventHandler* NativeHandler, UObject* Source, FName EventName, const FGeneric& Args)
+{
+	if (NativeHandler)
+	{
+		return NativeHandler->HandleGenericEvent_Implementation(Source, EventName, Args);
+	}
+	return IGenericEventHandler::Execute_HandleGenericEvent(Handler, Source, EventName, Args);
+}
+
+/** Pass a request to a handler, Blueprint-only implementations answer synchronously */
+static void InvokeRequest(UObject* Handler, UObject* Source, FName EventName, const FGeneric& Args, const FGenericResponder& Responder)
+{
+	if (IGenericEventHandler* Interface = Cast<IGenericEventHandler>(Handler))
+	{
+		Interface->HandleGenericRequest(Source, EventName, Args, Responder);
+	}
+	else
+	{
+		Responder.Complete(IGenericEventHandler::Execute_HandleGenericEvent(Handler, Source, EventName, Args));
+	}
+}
+
+/** Deliver an event of the queue or the scheduler */
+static void DeliverEvent(FGenericEventDispatcher& Dispatcher, const FGenericQueuedEvent& Event)
+{
+	if (Event.bBroadcast)
+	{
+		Dispatcher.Broadcast(Event.Source.Get(), Event.EventName, Event.Args);
+	}
+	else if (UObject* Target = Event.Target.Get())
+	{
+		FGenericEventDispatcher::Send(Target, Event.Source.Get(), Event.EventName, Event.Args);
+	}
+}
+
+/** Interface to call directly, null if the handler has to go through ProcessEvent */
+static IGenericEventHandler* GetNativeHandler(UObject* Handler)
+{
+	if (FGenericEventDispatcher::HasBlueprintOverride(Handler->GetClass())) return nullptr;
+	return Cast<IGenericEventHandler>(Handler);
+}
+
+/** Classes inspected by HasBlueprintOverride, emptied when classes may have been collected or recompiled */
+struct FBlueprintOverrideCache
+{
+	TMap<FObjectKey, bool> Entries;
+
+	FBlueprintOverrideCache()
+	{
+		// A collected class can be replaced by a new one at the same key, a recompiled one can gain an override
+		FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FBlueprintOverrideCache::Reset);
+#if WITH_EDITOR && UE_VERSION_NEWER_THAN(5, 0, 0)
+		FCoreUObjectDelegates::OnObjectsReinstanced.AddLambda([this](const TMap<UObject*, UObject*>&) { Reset(); });
+#endif
+	}
+
+	void Reset() { Entries.Reset(); }
+};
+
+bool FGenericEventDispatcher::HasBlueprintOverride(const UClass* Class)
+{
+	if (!Class) return false;
+
+	// Classes are only inspected once, the cache is game thread only like the dispatcher
+	static FBlueprintOverrideCache Cache;
+	if (const bool* Found = Cache.Entries.Find(Class))
+	{
+		return *Found;
+	}
+	const UFunction* Function = Class->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(IGenericEventHandler, HandleGenericEvent));
+	const bool bOverride = Function && !Function->HasAnyFunctionFlags(FUNC_Native);
+	Cache.Entries.Add(Class, bOverride);
+	return bOverride;
+}
+
+int32 FGenericEventDispatcher::FindObject(const FSubscriberList& List, const UObject* Handler)
+{
+	return List.IndexOfByPredicate([Handler](const FSubscriber& Subscriber)
+		{
+			return !Subscriber.Delegate && Subscriber.Object == Handler;
+		});
+}
+
+FGenericEventDispatcher::FSubscriberList& FGenericEventDispatcher::FindOrAddList(FName EventName)
+{
+	TUniquePtr<FSubscriberList>& List = Subscribers.FindOrAdd(EventName);
+	if (!List)
+	{
+		List = MakeUnique<FSubscriberList>();
+	}
+	return *List;
+}
+
+bool FGenericEventDispatcher::Subscribe(FName EventName, UObject* Handler, bool bThreadSafe)
+{
+	if (!IsGenericEventHandler(Handler))
+	{
+		UE_LOG(LogMAID, Warning, TEXT("Generic event: %s does not implement GenericEventHandler and cannot subscribe to %s"),
+			*GetNameSafe(Handler), *EventName.ToString());
+		return false;
+	}
+
+	FSubscriberList& List = FindOrAddList(EventName);
+	int32 Index = FindObject(List, Handler);
+	if (Index == INDEX_NONE)
+	{
+		Index = List.AddDefaulted();
+		List[Index].Object = Handler;
+		List[Index].NativeHandler = GetNativeHandler(Handler);
+	}
+	List[Index].bThreadSafe = bThreadSafe;
+	return true;
+}
+
+void FGenericEventDispatcher::Unsubscribe(FName EventName, UObject* Handler)
+{
+	if (const TUniquePtr<FSubscriberList>* List = Subscribers.Find(EventName))
+	{
+		const int32 Index = FindObject(**List, Handler);
+		if (Index == INDEX_NONE) return;
+
+		// Entries are only cleared here, a dispatch in progress keeps iterating by index
+		(**List)[Index].Clear();
+		bNeedsCompaction = true;
+		Compact();
+	}
+}
+
+void FGenericEventDispatcher::UnsubscribeAll(UObject* Handler)
+{
+	for (auto& Pair : Subscribers)
+	{
+		const int32 Index = FindObject(*Pair.Value, Handler);
+		if (Index == INDEX_NONE) continue;
+
+		(*Pair.Value)[Index].Clear();
+		bNeedsCompaction = true;
+	}
+	Compact();
+}
+
+FDelegateHandle FGenericEventDispatcher::SubscribeNative(FName EventName, FGenericEventDelegate Delegate)
+{
+	if (!Delegate.IsBound()) return FDelegateHandle();
+
+	const FDelegateHandle Handle = Delegate.GetHandle();
+	FSubscriber& Subscriber = FindOrAddList(EventName).AddDefaulted_GetRef();
+	Subscriber.Delegate = MakeShared<FGenericEventDelegate, ESPMode::NotThreadSafe>(MoveTemp(Delegate));
+	return Handle;
+}
+
+void FGenericEventDispatcher::UnsubscribeNative(FName EventName, FDelegateHandle Handle)
+{
+	if (const TUniquePtr<FSubscriberList>* List = Subscribers.Find(EventName))
+	{
+		const int32 Index = (*List)->IndexOfByPredicate([&Handle](const FSubscriber& Subscriber)
+			{
+				return Subscriber.Delegate && Subscriber.Delegate->GetHandle() == Handle;
+			});
+		if (Index == INDEX_NONE) return;
+
+		(**List)[Index].Clear();
+		bNeedsCompaction = true;
+		Compact();
+	}
+}
+
+int32 FGenericEventDispatcher::Broadcast(UObject* Source, FName EventName, const FGeneric& Args)
+{
+	// Values decoded by the handlers only live for the duration of the broadcast
+	FGenericArenaScope ArenaScope;
+
+	++DispatchDepth;
+	int32 NumInvoked = Dispatch(EventName, Source, EventName, Args);
+	if (!EventName.IsNone())
+	{
+		NumInvoked += Dispatch(NAME_None, Source, EventName, Args);
+	}
+	--DispatchDepth;
+
+	Compact();
+	return NumInvoked;
+}
+
+int32 FGenericEventDispatcher::BroadcastParallel(UObject* Source, FName EventName, const FGeneric& Args, TArray<FGenericEventResult>* OutResults)
+{
+	check(IsInGameThread());
+	FGenericArenaScope ArenaScope;
+
+	if (ParallelScratch.Num() <= ParallelDepth)
+	{
+		ParallelScratch.AddDefaulted();
+	}
+	TArray<FParallelCall>& Calls = ParallelScratch[ParallelDepth];
+	Calls.Reset();
+	CollectParallel(EventName, Calls);
+	if (!EventName.IsNone())
+	{
+		CollectParallel(NAME_None, Calls);
+	}
+
+	const int32 NumParallel = Calls.Num();
+	if (OutResults)
+	{
+		OutResults->SetNum(NumParallel);
+	}
+
+	++DispatchDepth;
+	++ParallelDepth;
+	if (NumParallel > 0)
+	{
+		// Handlers only read Args: a const FGeneric is never written by Get, so workers share it
+		const int32 BatchSize = FMath::Max(GGenericEventParallelBatch, 1);
+		const int32 NumBatches = FMath::DivideAndRoundUp(NumParallel, BatchSize);
+		FGenericEventResult* Results = OutResults ? OutResults->GetData() : nullptr;
+		ParallelFor(NumBatches, [&Calls, Results, BatchSize, NumParallel, Source, EventName, &Args](int32 Batch)
+			{
+				FGenericArenaScope WorkerArenaScope;
+				const int32 End = FMath::Min((Batch + 1) * BatchSize, NumParallel);
+				for (int32 Index = Batch * BatchSize; Index < End; ++Index)
+				{
+					const FParallelCall& Call = Calls[Index];
+					FGeneric Value = Call.NativeHandler->HandleGenericEvent_Implementation(Source, EventName, Args);
+					if (Results)
+					{
+						Results[Index].Handler = Call.Handler;
+						Results[Index].Value = MoveTemp(Value);
+					}
+				}
+			}, NumParallel < GGenericEventParallelMin);
+	}
+	--ParallelDepth;
+
+	int32 NumInvoked = NumParallel;
+	NumInvoked += Dispatch(EventName, Source, EventName, Args, true, OutResults);
+	if (!EventName.IsNone())
+	{
+		NumInvoked += Dispatch(NAME_None, Source, EventName, Args, true, OutResults);
+	}
+	--DispatchDepth;
+
+	Compact();
+	return NumInvoked;
+}
+
+void FGenericEventDispatcher::CollectParallel(FName ListName, TArray<FParallelCall>& OutCalls) const
+{
+	const TUniquePtr<FSubscriberList>* Found = Subscribers.Find(ListName);
+	if (!Found) return;
+
+	// Weak pointers are resolved here on the game thread, workers only see live objects
+	for (const FSubscriber& Subscriber : **Found)
+	{
+		if (!Subscriber.IsParallel()) continue;
+
+		if (UObject* Handler = Subscriber.Object.Get())
+		{
+			OutCalls.Add({ Handler, Subscriber.NativeHandler });
+		}
+	}
+}
+
+int32 FGenericEventDispatcher::Dispatch(FName ListName, UObject* Source, FName EventName, const FGeneric& Args, bool bSkipParallel, TArray<FGenericEventResult>* OutResults)
+{
+	const TUniquePtr<FSubscriberList>* Found = Subscribers.Find(ListName);
+	if (!Found) return 0;
+
+	FSubscriberList& List = **Found;
+	const int32 NumSubscribers = List.Num();
+	int32 NumInvoked = 0;
+	for (int32 Index = 0; Index < NumSubscribers; ++Index)
+	{
+		// The list may grow during the call, so the entry is looked up again every iteration
+		const FSubscriber& Subscriber = List[Index];
+		if (Subscriber.Delegate)
+		{
+			// Held by reference count, the callback may unsubscribe itself and release the entry
+			const TSharedPtr<FGenericEventDelegate, ESPMode::NotThreadSafe> Delegate = Subscriber.Delegate;
+			if (Delegate->ExecuteIfBound(Source, EventName, Args))
+			{
+				++NumInvoked;
+			}
+			else
+			{
+				bNeedsCompaction = true;
+			}
+			continue;
+		}
+
+		if (bSkipParallel && Subscriber.IsParallel()) continue;
+
+		UObject* Handler = Subscriber.Object.Get();
+		if (!Handler)
+		{
+			bNeedsCompaction = true;
+			continue;
+		}
+		FGeneric Value = InvokeHandler(Handler, Subscriber.NativeHandler, Source, EventName, Args);
+		if (OutResults)
+		{
+			OutResults->Add({ Handler, MoveTemp(Value) });
+		}
+		++NumInvoked;
+	}
+	return NumInvoked;
+}
+
+FGeneric FGenericEventDispatcher::Send(UObject* Target, UObject* Source, FName EventName, const FGeneric& Args)
+{
+	if (!IsGenericEventHandler(Target)) return FGeneric::Null;
+	return InvokeHandler(Target, GetNativeHandler(Target), Source, EventName, Args);
+}
+
+TFuture<FGeneric> FGenericEventDispatcher::Request(UObject* Target, UObject* Source, FName EventName, const FGeneric& Args)
+{
+	if (!IsGenericEventHandler(Target))
+	{
+		return MakeFulfilledPromise<FGeneric>(FGeneric::Null).GetFuture();
+	}
+
+	TPromise<FGeneric> Promise;
+	TFuture<FGeneric> Future = Promise.GetFuture();
+	InvokeRequest(Target, Source, EventName, Args, FGenericResponder([Promise = MoveTemp(Promise)](FGeneric&& Value) mutable
+		{
+			Promise.SetValue(MoveTemp(Value));
+		}));
+	return Future;
+}
+
+TFuture<TArray<FGeneric>> FGenericEventDispatcher::RequestAll(UObject* Source, FName EventName, const FGeneric& Args)
+{
+	// Handlers are gathered first, they may unsubscribe or answer while the request is being sent
+	TArray<UObject*, TInlineAllocator<16>> Handlers;
+	CollectHandlers(EventName, Handlers);
+	if (!EventName.IsNone())
+	{
+		CollectHandlers(NAME_None, Handlers);
+	}
+	if (Handlers.Num() == 0)
+	{
+		return MakeFulfilledPromise<TArray<FGeneric>>().GetFuture();
+	}
+
+	struct FGather
+	{
+		TArray<FGeneric> Results;
+		std::atomic<int32> NumPending{ 0 };
+		TPromise<TArray<FGeneric>> Promise;
+	};
+	TSharedRef<FGather, ESPMode::ThreadSafe> Gather = MakeShared<FGather, ESPMode::ThreadSafe>();
+	Gather->Results.SetNum(Handlers.Num());
+	Gather->NumPending.store(Handlers.Num(), std::memory_order_relaxed);
+	TFuture<TArray<FGeneric>> Future = Gather->Promise.GetFuture();
+
+	for (int32 Index = 0; Index < Handlers.Num(); ++Index)
+	{
+		// Each answer has its own slot, the last one to arrive publishes all of them
+		InvokeRequest(Handlers[Index], Source, EventName, Args, FGenericResponder([Gather, Index](FGeneric&& Value)
+			{
+				Gather->Results[Index] = MoveTemp(Value);
+				if (Gather->NumPending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				{
+					Gather->Promise.SetValue(MoveTemp(Gather->Results));
+				}
+			}));
+	}
+	return Future;
+}
+
+void FGenericEventDispatcher::CollectHandlers(FName ListName, TArray<UObject*, TInlineAllocator<16>>& OutHandlers) const
+{
+	const TUniquePtr<FSubscriberList>* Found = Subscribers.Find(ListName);
+	if (!Found) return;
+
+	for (const FSubscriber& Subscriber : **Found)
+	{
+		if (Subscriber.Delegate) continue;
+
+		if (UObject* Handler = Subscriber.Object.Get())
+		{
+			OutHandlers.Add(Handler);
+		}
+	}
+}
+
+int32 FGenericEventDispatcher::GetNumSubscribers(FName EventName) const
+{
+	const TUniquePtr<FSubscriberList>* List = Subscribers.Find(EventName);
+	if (!List) return 0;
+
+	int32 Num = 0;
+	for (const FSubscriber& Subscriber : **List)
+	{
+		Num += Subscriber.IsActive() ? 1 : 0;
+	}
+	return Num;
+}
+
+void FGenericEventDispatcher::Reset()
+{
+	if (DispatchDepth > 0)
+	{
+		for (auto& Pair : Subscribers)
+		{
+			for (FSubscriber& Subscriber : *Pair.Value)
+			{
+				Subscriber.Clear();
+			}
+		}
+		bNeedsCompaction = true;
+		return;
+	}
+	Subscribers.Reset();
+	bNeedsCompaction = false;
+}
+
+void FGenericEventDispatcher::Compact()
+{
+	if (DispatchDepth > 0 || !bNeedsCompaction) return;
+
+	bNeedsCompaction = false;
+	for (auto It = Subscribers.CreateIterator(); It; ++It)
+	{
+		It.Value()->RemoveAll([](const FSubscriber& Subscriber) { return !Subscriber.IsActive(); });
+		if (It.Value()->Num() == 0)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+UGenericEventSubsystem* UGenericEventSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UGenericEventSubsystem>() : nullptr;
+}
+
+bool UGenericEventSubsystem::Subscribe(FName EventName, UObject* Handler, bool bThreadSafe)
+{
+	return Dispatcher.Subscribe(EventName, Handler, bThreadSafe);
+}
+
+void UGenericEventSubsystem::Unsubscribe(FName EventName, UObject* Handler)
+{
+	Dispatcher.Unsubscribe(EventName, Handler);
+}
+
+void UGenericEventSubsystem::UnsubscribeAll(UObject* Handler)
+{
+	Dispatcher.UnsubscribeAll(Handler);
+}
+
+FGeneric UGenericEventSubsystem::Send(UObject* Target, UObject* Source, FName EventName, const FGeneric& Args)
+{
+	return FGenericEventDispatcher::Send(Target, Source, EventName, Args);
+}
+
+int32 UGenericEventSubsystem::Broadcast(UObject* Source, FName EventName, const FGeneric& Args)
+{
+	return Dispatcher.Broadcast(Source, EventName, Args);
+}
+
+TFuture<FGeneric> UGenericEventSubsystem::Request(UObject* Target, UObject* Source, FName EventName, const FGeneric& Args)
+{
+	return FGenericEventDispatcher::Request(Target, Source, EventName, Args);
+}
+
+TFuture<TArray<FGeneric>> UGenericEventSubsystem::RequestAll(UObject* Source, FName EventName, const FGeneric& Args)
+{
+	return Dispatcher.RequestAll(Source, EventName, Args);
+}
+
+int32 UGenericEventSubsystem::BroadcastParallel(UObject* Source, FName EventName, const FGeneric& Args, TArray<FGenericEventResult>* OutResults)
+{
+	return Dispatcher.BroadcastParallel(Source, EventName, Args, OutResults);
+}
+
+int32 UGenericEventSubsystem::GetNumSubscribers(FName EventName) const
+{
+	return Dispatcher.GetNumSubscribers(EventName);
+}
+
+FDelegateHandle UGenericEventSubsystem::SubscribeNative(FName EventName, FGenericEventDelegate Delegate)
+{
+	return Dispatcher.SubscribeNative(EventName, MoveTemp(Delegate));
+}
+
+void UGenericEventSubsystem::UnsubscribeNative(FName EventName, FDelegateHandle Handle)
+{
+	Dispatcher.UnsubscribeNative(EventName, Handle);
+}
+
+int32 UGenericEventSubsystem::DrainEventQueue(int32 MaxEvents)
+{
+	check(IsInGameThread());
+	if (!Queue) return 0;
+
+	FGenericArenaScope ArenaScope;
+	return Queue->Drain(MaxEvents, [this](const FGenericQueuedEvent& Event) { DeliverEvent(Dispatcher, Event); });
+}
+
+void UGenericEventSubsystem::SetEventQueueTickGroup(ETickingGroup TickGroup)
+{
+	if (QueueTickFunction.TickGroup == TickGroup) return;
+
+	const bool bWasRegistered = QueueTickFunction.IsTickFunctionRegistered();
+	if (bWasRegistered)
+	{
+		QueueTickFunction.UnRegisterTickFunction();
+	}
+	QueueTickFunction.TickGroup = TickGroup;
+	QueueTickFunction.EndTickGroup = TickGroup;
+	if (bWasRegistered)
+	{
+		QueueTickFunction.RegisterTickFunction(GetWorld()->PersistentLevel);
+	}
+}
+
+FGenericEventTimerHandle UGenericEventSubsystem::ScheduleSend(float Delay, UObject* Target, UObject* Source, FName EventName, const FGeneric& Args)
+{
+	check(IsInGameThread());
+	if (!Scheduler || !Target) return FGenericEventTimerHandle();
+	return Scheduler->Schedule(Delay, Target, Source, EventName, Args);
+}
+
+FGenericEventTimerHandle UGenericEventSubsystem::ScheduleBroadcast(float Delay, UObject* Source, FName EventName, const FGeneric& Args)
+{
+	check(IsInGameThread());
+	if (!Scheduler) return FGenericEventTimerHandle();
+	return Scheduler->Schedule(Delay, nullptr, Source, EventName, Args, true);
+}
+
+bool UGenericEventSubsystem::CancelScheduled(FGenericEventTimerHandle& Handle)
+{
+	const bool bCancelled = Scheduler && Scheduler->Cancel(Handle);
+	Handle.Invalidate();
+	return bCancelled;
+}
+
+bool UGenericEventSubsystem::IsScheduled(FGenericEventTimerHandle Handle) const
+{
+	return Scheduler && Scheduler->IsScheduled(Handle);
+}
+
+int32 UGenericEventSubsystem::AdvanceScheduler(float DeltaSeconds)
+{
+	check(IsInGameThread());
+	if (!Scheduler) return 0;
+
+	FGenericArenaScope ArenaScope;
+	return Scheduler->Advance(DeltaSeconds, [this](const FGenericQueuedEvent& Event) { DeliverEvent(Dispatcher, Event); });
+}
+
+void UGenericEventSubsystem::AddObservable(FGenericObservableBag* Observable)
+{
+	check(IsInGameThread());
+	if (Observable)
+	{
+		Observables.AddUnique(Observable);
+	}
+}
+
+void UGenericEventSubsystem::RemoveObservable(FGenericObservableBag* Observable)
+{
+	check(IsInGameThread());
+	const int32 Index = Observables.Find(Observable);
+	if (Index == INDEX_NONE) return;
+
+	if (bFlushingObservables)
+	{
+		Observables[Index] = nullptr;
+	}
+	else
+	{
+		Observables.RemoveAt(Index);
+	}
+}
+
+int32 UGenericEventSubsystem::FlushObservables()
+{
+	check(IsInGameThread());
+	if (bFlushingObservables) return 0;
+
+	int32 NumCalled = 0;
+	{
+		TGuardValue<bool> FlushGuard(bFlushingObservables, true);
+		for (int32 Index = 0; Index < Observables.Num(); ++Index)
+		{
+			if (Observables[Index])
+			{
+				NumCalled += Observables[Index]->Flush();
+			}
+		}
+	}
+	Observables.Remove(nullptr);
+	return NumCalled;
+}
+
+void UGenericEventSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Queue = MakeShared<FGenericEventQueue, ESPMode::ThreadSafe>(GGenericEventQueueCapacity);
+	Scheduler = MakeUnique<FGenericEventScheduler>(GGenericSchedulerResolution);
+
+	const ETickingGroup TickGroup = (ETickingGroup)FMath::Clamp(GGenericEventQueueTickGroup, (int32)TG_PrePhysics, (int32)TG_PostUpdateWork);
+	QueueTickFunction.Subsystem = this;
+	QueueTickFunction.bCanEverTick = true;
+	QueueTickFunction.bStartWithTickEnabled = true;
+	QueueTickFunction.bTickEvenWhenPaused = true;
+	QueueTickFunction.TickGroup = TickGroup;
+	QueueTickFunction.EndTickGroup = TickGroup;
+
+	UWorld* World = GetWorld();
+	if (World && World->PersistentLevel)
+	{
+		QueueTickFunction.RegisterTickFunction(World->PersistentLevel);
+	}
+}
+
+void UGenericEventSubsystem::Deinitialize()
+{
+	if (QueueTickFunction.IsTickFunctionRegistered())
+	{
+		QueueTickFunction.UnRegisterTickFunction();
+	}
+	// Workers may still hold the queue or the subsystem, the queue stays allocated and drops their events
+	if (Queue)
+	{
+		Queue->Close();
+	}
+	Scheduler.Reset();
+	Dispatcher.Reset();
+	Observables.Reset();
+	Super::Deinitialize();
+}
+
+void FGenericEventQueueTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Subsystem)
+	{
+		Subsystem->DrainEventQueue(GGenericEventQueueMaxPerFrame);
+		if (TickType != LEVELTICK_PauseTick)
+		{
+			Subsystem->AdvanceScheduler(DeltaTime);
+		}
+		Subsystem->FlushObservables();
+	}
+}
+
+FString FGenericEventQueueTickFunction::DiagnosticMessage()
+{
+	return TEXT("FGenericEventQueueTickFunction");
+}
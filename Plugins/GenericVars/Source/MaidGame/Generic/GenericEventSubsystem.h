@@ -0,0 +1,325 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#pragma once
+
+#include "Core/MaidCoreFwd.h"
+#include "Generic/Generic.h"
+#include "Generic/GenericEventQueue.h"
+#include "Generic/GenericEventScheduler.h"
+#include "Async/Future.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "GenericEventSubsystem.generated.h"
+
+class IGenericEventHandler;
+class FGenericObservableBag;
+
+/** Native event callback, receives the arguments by reference without going through ProcessEvent */
+DECLARE_DELEGATE_ThreeParams(FGenericEventDelegate, UObject* /*Source*/, FName /*EventName*/, const FGeneric& /*Args*/);
+
+/** Value returned by a handler of a broadcast */
+struct FGenericEventResult
+{
+	UObject* Handler = nullptr;
+	FGeneric Value;
+};
+
+/**
+ * Per-EventName subscriber tables for IGenericEventHandler
+ *
+ * Each event name owns a flat array of weak handlers, so a broadcast costs one call per subscriber instead
+ * of a scan over the world. Handlers subscribed to NAME_None receive every event.
+ *
+ * Native C++ handlers take a fast path: objects whose HandleGenericEvent is not overridden in Blueprint are
+ * called through their _Implementation directly, and FGenericEventDelegate subscriptions are executed with
+ * the arguments by reference. Only Blueprint overrides go through ProcessEvent and copy Args.
+ *
+ * Handlers may subscribe or unsubscribe while an event is being dispatched: new subscribers start receiving
+ * with the next event, removed ones are skipped immediately. Destroyed handlers are dropped lazily.
+ * Not thread safe, use from the game thread.
+ *
+ * Native handlers subscribed as thread safe only read Args and touch their own state. BroadcastParallel runs
+ * them on worker threads in batches and joins before the other handlers are called on the game thread.
+ */
+class MAIDGAME_API FGenericEventDispatcher
+{
+public:
+	/**
+	 * @param bThreadSafe - The handler may run on a worker thread during BroadcastParallel, ignored for Blueprint overrides
+	 * @return False if the handler does not implement IGenericEventHandler
+	 */
+	bool Subscribe(FName EventName, UObject* Handler, bool bThreadSafe = false);
+	void Unsubscribe(FName EventName, UObject* Handler);
+	void UnsubscribeAll(UObject* Handler);
+
+	/** Receive events of a name through a native delegate, NAME_None receives every event */
+	FDelegateHandle SubscribeNative(FName EventName, FGenericEventDelegate Delegate);
+	void UnsubscribeNative(FName EventName, FDelegateHandle Handle);
+
+	/**
+	 * Dispatch an event to the subscribers of its name and to the NAME_None subscribers
+	 * @return Number of handlers invoked
+	 */
+	int32 Broadcast(UObject* Source, FName EventName, const FGeneric& Args);
+
+	/**
+	 * Dispatch an event, running thread-safe handlers in parallel
+	 *
+	 * Thread-safe handlers are split into batches of generic.event.parallelbatch and run with ParallelFor when
+	 * there are at least generic.event.parallelmin of them. They must not subscribe, unsubscribe or dispatch.
+	 * The remaining handlers are called on the game thread once the parallel ones are done.
+	 *
+	 * @param OutResults - Filled with the value of every object handler, thread-safe ones first; reuse the
+	 *                     array between broadcasts to keep its allocation
+	 * @return Number of handlers invoked
+	 */
+	int32 BroadcastParallel(UObject* Source, FName EventName, const FGeneric& Args, TArray<FGenericEventResult>* OutResults = nullptr);
+
+	/** Dispatch an event to a single handler, subscribed or not */
+	static FGeneric Send(UObject* Target, UObject* Source, FName EventName, const FGeneric& Args);
+
+	/**
+	 * Send a request to a single handler through HandleGenericRequest, without waiting for the answer
+	 * @return Future set when the handler completes, on the thread it completes from; Null if the target
+	 *         does not implement IGenericEventHandler or drops the request
+	 */
+	static TFuture<FGeneric> Request(UObject* Target, UObject* Source, FName EventName, const FGeneric& Args);
+
+	/**
+	 * Send a request to the handlers of its name and the NAME_None handlers, delegates are not involved
+	 * @return Future set once every handler completed, with the answers in subscription order
+	 */
+	TFuture<TArray<FGeneric>> RequestAll(UObject* Source, FName EventName, const FGeneric& Args);
+
+	/** Number of live handlers subscribed to an event name */
+	int32 GetNumSubscribers(FName EventName) const;
+
+	/** Drop all subscriptions */
+	void Reset();
+
+	/** Check if a class overrides HandleGenericEvent in Blueprint, so it has to be called through ProcessEvent */
+	static bool HasBlueprintOverride(const UClass* Class);
+
+private:
+	struct FSubscriber
+	{
+		/** Handler object, also set for native handlers to detect their destruction */
+		TWeakObjectPtr<UObject> Object;
+
+		/** Interface of a handler without Blueprint override, null when ProcessEvent is needed */
+		IGenericEventHandler* NativeHandler = nullptr;
+
+		/** Callback of a native subscription, shared so a dispatch can keep it alive while it unsubscribes */
+		TSharedPtr<FGenericEventDelegate, ESPMode::NotThreadSafe> Delegate;
+
+		/** Native handler allowed on worker threads */
+		bool bThreadSafe = false;
+
+		bool IsActive() const { return Delegate ? Delegate->IsBound() : Object.IsValid(); }
+
+		void Clear()
+		{
+			Object.Reset();
+			NativeHandler = nullptr;
+			Delegate.Reset();
+			bThreadSafe = false;
+		}
+
+		bool IsParallel() const { return bThreadSafe && NativeHandler; }
+	};
+
+	using FSubscriberList = TArray<FSubscriber>;
+
+	struct FParallelCall
+	{
+		UObject* Handler = nullptr;
+		IGenericEventHandler* NativeHandler = nullptr;
+	};
+
+	/** @return Index of the object subscription in a list, INDEX_NONE if not found */
+	static int32 FindObject(const FSubscriberList& List, const UObject* Handler);
+
+	FSubscriberList& FindOrAddList(FName EventName);
+
+	/**
+	 * Dispatch to the handlers of one list that were subscribed when the dispatch started
+	 * @param bSkipParallel - Skip the thread-safe handlers, already run by BroadcastParallel
+	 */
+	int32 Dispatch(FName ListName, UObject* Source, FName EventName, const FGeneric& Args, bool bSkipParallel = false, TArray<FGenericEventResult>* OutResults = nullptr);
+
+	/** Gather the live object handlers of one list for a request */
+	void CollectHandlers(FName ListName, TArray<UObject*, TInlineAllocator<16>>& OutHandlers) const;
+
+	/** Gather the live thread-safe handlers of one list */
+	void CollectParallel(FName ListName, TArray<FParallelCall>& OutCalls) const;
+
+	/** Remove the entries cleared by Unsubscribe or destroyed since the last compaction */
+	void Compact();
+
+	/** Lists are heap allocated so dispatch keeps a stable pointer while handlers add new event names */
+	TMap<FName, TUniquePtr<FSubscriberList>> Subscribers;
+
+	/** Handlers of parallel broadcasts, one array per nesting level so their capacity is kept */
+	TArray<TArray<FParallelCall>> ParallelScratch;
+	int32 ParallelDepth = 0;
+
+	int32 DispatchDepth = 0;
+	bool bNeedsCompaction = false;
+};
+
+/** Drains the event queue, advances the scheduled events and flushes the observable bags of a UGenericEventSubsystem once per frame */
+struct FGenericEventQueueTickFunction : public FTickFunction
+{
+	class UGenericEventSubsystem* Subsystem = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+};
+
+/**
+ * World subsystem routing generic events to subscribed IGenericEventHandler objects
+ *
+ * Events raised off the game thread are pushed into an FGenericEventQueue, which is drained in batches by a
+ * tick function in the group set by generic.eventqueue.tickgroup. Capture the subsystem on the game thread
+ * before handing it to worker code. The same tick advances an FGenericEventScheduler by the world delta time,
+ * so scheduled events follow time dilation and wait while the world is paused. Observable bags bound to the
+ * world are flushed last, also while paused, so their listeners see the writes made by the events of the frame.
+ * @see FGenericEventDispatcher, IGenericEventHandler
+ */
+UCLASS()
+class MAIDGAME_API UGenericEventSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Get the subsystem of the world of an object */
+	static UGenericEventSubsystem* Get(const UObject* WorldContextObject);
+
+	/**
+	 * Receive events of the given name, or of every name when EventName is None
+	 * @param bThreadSafe - A native handler may be called on worker threads by BroadcastParallel
+	 * @return False if the handler does not implement GenericEventHandler
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Event", Meta = (AdvancedDisplay = "bThreadSafe"))
+	bool Subscribe(FName EventName, UObject* Handler, bool bThreadSafe = false);
+
+	/** Stop receiving events of the given name */
+	UFUNCTION(BlueprintCallable, Category = "Event")
+	void Unsubscribe(FName EventName, UObject* Handler);
+
+	/** Stop receiving any event */
+	UFUNCTION(BlueprintCallable, Category = "Event")
+	void UnsubscribeAll(UObject* Handler);
+
+	/**
+	 * Send an event to a single handler
+	 * @return Result of the handler, Null if the target does not implement GenericEventHandler
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Event", Meta = (AutoCreateRefTerm = "Args"))
+	FGeneric Send(UObject* Target, UObject* Source, FName EventName, const FGeneric& Args);
+
+	/**
+	 * Send an event to every handler subscribed to its name
+	 * @return Number of handlers invoked
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Event", Meta = (AutoCreateRefTerm = "Args"))
+	int32 Broadcast(UObject* Source, FName EventName, const FGeneric& Args);
+
+	/** @see FGenericEventDispatcher::Request */
+	TFuture<FGeneric> Request(UObject* Target, UObject* Source, FName EventName, const FGeneric& Args);
+
+	/** @see FGenericEventDispatcher::RequestAll */
+	TFuture<TArray<FGeneric>> RequestAll(UObject* Source, FName EventName, const FGeneric& Args);
+
+	/** @see FGenericEventDispatcher::BroadcastParallel */
+	int32 BroadcastParallel(UObject* Source, FName EventName, const FGeneric& Args, TArray<FGenericEventResult>* OutResults = nullptr);
+
+	/** Number of live handlers subscribed to an event name */
+	UFUNCTION(BlueprintPure, Category = "Event")
+	int32 GetNumSubscribers(FName EventName) const;
+
+	/** @see FGenericEventDispatcher::SubscribeNative */
+	FDelegateHandle SubscribeNative(FName EventName, FGenericEventDelegate Delegate);
+	void UnsubscribeNative(FName EventName, FDelegateHandle Handle);
+
+	FGenericEventDispatcher& GetDispatcher() { return Dispatcher; }
+
+	/**
+	 * Queue an event for a handler from any thread, it is sent on the game thread
+	 * Producers that may outlive the subsystem enqueue through GetEventQueueHandle instead.
+	 */
+	void EnqueueSend(UObject* Target, UObject* Source, FName EventName, const FGeneric& Args) { Queue->EnqueueSend(Target, Source, EventName, Args); }
+	void EnqueueSend(UObject* Target, UObject* Source, FName EventName, FGeneric&& Args) { Queue->EnqueueSend(Target, Source, EventName, MoveTemp(Args)); }
+
+	/** Queue an event for all subscribers from any thread, it is broadcast on the game thread */
+	void EnqueueBroadcast(UObject* Source, FName EventName, const FGeneric& Args) { Queue->EnqueueBroadcast(Source, EventName, Args); }
+	void EnqueueBroadcast(UObject* Source, FName EventName, FGeneric&& Args) { Queue->EnqueueBroadcast(Source, EventName, MoveTemp(Args)); }
+
+	/**
+	 * Deliver queued events now, game thread only
+	 * @param MaxEvents - Events to deliver at most, all queued events when 0 or less
+	 * @return Number of events delivered
+	 */
+	int32 DrainEventQueue(int32 MaxEvents = 0);
+
+	FGenericEventQueue& GetEventQueue() { return *Queue; }
+
+	/**
+	 * Shared handle to the event queue, captured by worker threads before they go off-thread
+	 * The queue outlives the subsystem while a handle exists, and discards events once the subsystem is deinitialized.
+	 */
+	TSharedRef<FGenericEventQueue, ESPMode::ThreadSafe> GetEventQueueHandle() const { return Queue.ToSharedRef(); }
+
+	/** Move the queue drain to another tick group */
+	void SetEventQueueTickGroup(ETickingGroup TickGroup);
+
+	/** Send an event to a handler after Delay seconds of world time */
+	UFUNCTION(BlueprintCallable, Category = "Event", Meta = (AutoCreateRefTerm = "Args"))
+	FGenericEventTimerHandle ScheduleSend(float Delay, UObject* Target, UObject* Source, FName EventName, const FGeneric& Args);
+
+	/** Broadcast an event to subscribers after Delay seconds of world time */
+	UFUNCTION(BlueprintCallable, Category = "Event", Meta = (AutoCreateRefTerm = "Args"))
+	FGenericEventTimerHandle ScheduleBroadcast(float Delay, UObject* Source, FName EventName, const FGeneric& Args);
+
+	/**
+	 * Cancel a scheduled event and invalidate its handle
+	 * @return True if the event was pending
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Event")
+	bool CancelScheduled(UPARAM(ref) FGenericEventTimerHandle& Handle);
+
+	UFUNCTION(BlueprintPure, Category = "Event")
+	bool IsScheduled(FGenericEventTimerHandle Handle) const;
+
+	/**
+	 * Advance the scheduled events and fire the due ones now, game thread only
+	 * @return Number of events fired
+	 */
+	int32 AdvanceScheduler(float DeltaSeconds);
+
+	FGenericEventScheduler& GetScheduler() { return *Scheduler; }
+
+	/** Flush a bag every frame, see FGenericObservableBag::BindToWorld */
+	void AddObservable(FGenericObservableBag* Observable);
+	void RemoveObservable(FGenericObservableBag* Observable);
+
+	/**
+	 * Deliver the pending changes of every bound observable bag now, game thread only
+	 * @return Number of listeners called
+	 */
+	int32 FlushObservables();
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+private:
+	FGenericEventDispatcher Dispatcher;
+	TSharedPtr<FGenericEventQueue, ESPMode::ThreadSafe> Queue;
+	TUniquePtr<FGenericEventScheduler> Scheduler;
+	FGenericEventQueueTickFunction QueueTickFunction;
+
+	/** Bound bags, entries removed during a flush are nulled and compacted afterwards */
+	TArray<FGenericObservableBag*> Observables;
+	bool bFlushingObservables = false;
+};
@@ -0,0 +1,118 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#include "Generic/GenericFieldPath.h"
+#include "Generic/Generic.h"
+#include "Misc/ScopeRWLock.h"
+
+namespace GenericFieldPath
+{
+	struct FCache
+	{
+		FRWLock Lock;
+		TMap<TPair<const UScriptStruct*, FName>, FGenericFieldPath> Paths;
+	};
+
+	static FCache& GetCache()
+	{
+		static FCache Cache;
+		return Cache;
+	}
+
+	static const FProperty* FindMember(const UStruct* Owner, const FString& Name)
+	{
+		if (const FProperty* Member = Owner->FindPropertyByName(*Name))
+		{
+			return Member;
+		}
+		// Members of user defined structs carry a generated suffix, match the name shown to the user
+		for (TFieldIterator<FProperty> It(Owner); It; ++It)
+		{
+			if (It->GetAuthoredName() == Name)
+			{
+				return *It;
+			}
+		}
+		return nullptr;
+	}
+}
+
+FGenericFieldPath::FGenericFieldPath(const UScriptStruct* InStruct, const FString& InPath)
+{
+	if (!InStruct) return;
+
+	TArray<FString> Segments;
+	InPath.ParseIntoArray(Segments, TEXT("."));
+
+	const UStruct* Owner = InStruct;
+	int32 FieldOffset = 0;
+	for (const FString& Segment : Segments)
+	{
+		const FProperty* Member = Owner ? GenericFieldPath::FindMember(Owner, Segment) : nullptr;
+		if (!Member)
+		{
+			Chain.Reset();
+			return;
+		}
+		FieldOffset += Member->GetOffset_ForInternal();
+		Chain.Add(Member);
+
+		const FStructProperty* StructMember = CastField<FStructProperty>(Member);
+		Owner = StructMember ? StructMember->Struct : nullptr;
+	}
+	if (Chain.Num() == 0) return;
+
+	Struct = InStruct;
+	Property = Chain.Last();
+	Offset = FieldOffset;
+}
+
+FGenericFieldPath FGenericFieldPath::Find(const UScriptStruct* InStruct, FName InPath)
+{
+	if (!InStruct || InStruct->IsA<UUserDefinedStruct>())
+	{
+		return FGenericFieldPath(InStruct, InPath.ToString());
+	}
+
+	GenericFieldPath::FCache& Cache = GenericFieldPath::GetCache();
+	const TPair<const UScriptStruct*, FName> Key(InStruct, InPath);
+	{
+		FReadScopeLock ReadLock(Cache.Lock);
+		if (const FGenericFieldPath* Path = Cache.Paths.Find(Key))
+		{
+			return *Path;
+		}
+	}
+
+	FGenericFieldPath Path(InStruct, InPath.ToString());
+	FWriteScopeLock WriteLock(Cache.Lock);
+	Cache.Paths.Add(Key, Path);
+	return Path;
+}
+
+bool FGenericFieldPath::CopyValue(void* DestAddress, const FProperty* DestProperty, const void* SrcAddress, const FProperty* SrcProperty)
+{
+	if (DestProperty->SameType(SrcProperty))
+	{
+		DestProperty->CopyCompleteValue(DestAddress, SrcAddress);
+		return true;
+	}
+
+	// Vector components are float or double depending on the engine version, convert between numbers
+	const FNumericProperty* DestNumeric = CastField<FNumericProperty>(DestProperty);
+	const FNumericProperty* SrcNumeric = CastField<FNumericProperty>(SrcProperty);
+	if (!DestNumeric || !SrcNumeric) return false;
+
+	if (DestNumeric->IsFloatingPoint())
+	{
+		DestNumeric->SetFloatingPointPropertyValue(DestAddress, SrcNumeric->IsFloatingPoint()
+			? SrcNumeric->GetFloatingPointPropertyValue(SrcAddress)
+			: (double)SrcNumeric->GetSignedIntPropertyValue(SrcAddress));
+	}
+	else
+	{
+		DestNumeric->SetIntPropertyValue(DestAddress, SrcNumeric->IsFloatingPoint()
+			? (int64)SrcNumeric->GetFloatingPointPropertyValue(SrcAddress)
+			: SrcNumeric->GetSignedIntPropertyValue(SrcAddress));
+	}
+	return true;
+}
@@ -0,0 +1,62 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/UnrealType.h"
+
+/**
+ * Compiled path to a field of a struct, such as "Translation.X" in FTransform
+ *
+ * The path is resolved once against the struct into the chain of member properties and the offset of the
+ * last one, so FGeneric::GetField and FGeneric::SetField reach a single field of a stored struct without
+ * decoding or rebuilding the whole value. Each segment names a member of the struct reached so far; every
+ * segment but the last must be a struct.
+ *
+ * Example usage:
+ *   static const FGenericFieldPath Path = FGenericFieldPath::Find(TBaseStructure<FTransform>::Get(), TEXT("Translation.X"));
+ *   double X = Generic.GetField<double>(Path);
+ */
+class MAIDGAME_API FGenericFieldPath
+{
+public:
+	FGenericFieldPath() = default;
+
+	/** Resolve a dotted path against a struct, invalid if a segment is not found */
+	FGenericFieldPath(const UScriptStruct* InStruct, const FString& InPath);
+
+	/**
+	 * Resolve a dotted path through a process-wide cache, so each path is only parsed once
+	 * Paths into user defined structs are not cached, those structs may be recompiled in the editor.
+	 */
+	static FGenericFieldPath Find(const UScriptStruct* InStruct, FName InPath);
+
+	FORCEINLINE bool IsValid() const { return Property != nullptr; }
+
+	/** Struct the path starts from */
+	FORCEINLINE const UScriptStruct* GetStruct() const { return Struct; }
+
+	/** Property of the field the path ends at */
+	FORCEINLINE const FProperty* GetProperty() const { return Property; }
+
+	/** Offset of the field from the start of the struct */
+	FORCEINLINE int32 GetOffset() const { return Offset; }
+
+	/** Member properties from the struct down to the field */
+	FORCEINLINE TArrayView<const FProperty* const> GetChain() const { return Chain; }
+
+	FORCEINLINE uint8* GetFieldAddress(void* StructAddress) const { return (uint8*)StructAddress + Offset; }
+	FORCEINLINE const uint8* GetFieldAddress(const void* StructAddress) const { return (const uint8*)StructAddress + Offset; }
+
+	/**
+	 * Copy a field value between properties of the same type, or convert between numeric properties
+	 * @return False if the types do not match
+	 */
+	static bool CopyValue(void* DestAddress, const FProperty* DestProperty, const void* SrcAddress, const FProperty* SrcProperty);
+
+private:
+	const UScriptStruct* Struct = nullptr;
+	const FProperty* Property = nullptr;
+	TArray<const FProperty*, TInlineAllocator<4>> Chain;
+	int32 Offset = 0;
+};
@@ -0,0 +1,153 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#include "Generic/GenericInternPool.h"
+#include "Hash/CityHash.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+#include "UObject/UObjectGlobals.h"
+
+static int32 GGenericInternEnabled = 0;
+static FAutoConsoleVariableRef CVarGenericInternEnabled(
+	TEXT("generic.intern.enabled"),
+	GGenericInternEnabled,
+	TEXT("Share identical FGeneric payloads through a content-addressed pool (0: off, 1: on)."));
+
+static int32 GGenericInternMinPayloadSize = 16;
+static FAutoConsoleVariableRef CVarGenericInternMinPayloadSize(
+	TEXT("generic.intern.minpayloadsize"),
+	GGenericInternMinPayloadSize,
+	TEXT("Smallest FGeneric payload in bytes that is interned."));
+
+static int32 GGenericInternCompactOnMapLoad = 1;
+static FAutoConsoleVariableRef CVarGenericInternCompactOnMapLoad(
+	TEXT("generic.intern.compactonmapload"),
+	GGenericInternCompactOnMapLoad,
+	TEXT("Shrink the FGeneric intern pool lookup table after each map load."));
+
+static FAutoConsoleCommand GenericInternStatsCommand(
+	TEXT("generic.intern.stats"),
+	TEXT("Log FGeneric intern pool statistics."),
+	FConsoleCommandDelegate::CreateLambda([]()
+		{
+			const FGenericInternPool::FStats Stats = FGenericInternPool::Get().GetStats();
+			UE_LOG(LogMAID, Log, TEXT("Generic intern pool: %d payloads (%lld bytes), %lld requests, %lld hits, dedupe rate %.2f%%, %lld bytes deduped"),
+				Stats.UniquePayloads, Stats.UniqueBytes, Stats.Requests, Stats.Hits, Stats.GetDedupeRate() * 100.0, Stats.DedupedBytes);
+		}));
+
+static FAutoConsoleCommand GenericInternCompactCommand(
+	TEXT("generic.intern.compact"),
+	TEXT("Shrink the FGeneric intern pool lookup table."),
+	FConsoleCommandDelegate::CreateLambda([]()
+		{
+			FGenericInternPool::Get().Compact();
+			UE_LOG(LogMAID, Log, TEXT("Generic intern pool: %d payloads after compaction"), FGenericInternPool::Get().GetStats().UniquePayloads);
+		}));
+
+FGenericInternPool& FGenericInternPool::Get()
+{
+	static FGenericInternPool* Pool = new FGenericInternPool();
+	return *Pool;
+}
+
+FGenericInternPool::FGenericInternPool()
+{
+	FCoreUObjectDelegates::PostLoadMapWithWorld.AddRaw(this, &FGenericInternPool::OnPostLoadMap);
+}
+
+bool FGenericInternPool::IsEnabled()
+{
+	return GGenericInternEnabled != 0;
+}
+
+int32 FGenericInternPool::GetMinPayloadSize()
+{
+	return GGenericInternMinPayloadSize;
+}
+
+uint64 FGenericInternPool::HashPayload(const FString& Data, const TArray<uint8>& PlainData)
+{
+	const uint64 DataHash = CityHash64((const char*)Data.GetCharArray().GetData(), Data.Len() * sizeof(TCHAR));
+	return CityHash64WithSeed((const char*)PlainData.GetData(), PlainData.Num(), DataHash);
+}
+
+TRefCountPtr<FGenericSharedPayload> FGenericInternPool::Intern(FString& InOutData, TArray<uint8>& InOutPlainData)
+{
+	const uint64 Hash = HashPayload(InOutData, InOutPlainData);
+	const int64 PayloadSize = GetPayloadSize(InOutData, InOutPlainData);
+
+	FScopeLock ScopeLock(&Lock);
+	++Stats.Requests;
+
+	for (auto It = Payloads.CreateConstKeyIterator(Hash); It; ++It)
+	{
+		FGenericSharedPayload* Payload = It.Value();
+		if (Payload->PlainData == InOutPlainData && Payload->Data.Equals(InOutData, ESearchCase::CaseSensitive))
+		{
+			++Stats.Hits;
+			Stats.DedupedBytes += PayloadSize;
+			return Payload;
+		}
+	}
+
+	GENERIC_LLM_SCOPE();
+	FGenericSharedPayload* Payload = new FGenericSharedPayload();
+	Payload->Data = MoveTemp(InOutData);
+	Payload->PlainData = MoveTemp(InOutPlainData);
+	Payload->Data.Shrink();
+	Payload->PlainData.Shrink();
+	Payload->Hash = Hash;
+	Payloads.Add(Hash, Payload);
+
+	++Stats.UniquePayloads;
+	Stats.UniqueBytes += PayloadSize;
+	return Payload;
+}
+
+uint32 FGenericSharedPayload::ReleaseLast() const
+{
+	return FGenericInternPool::Get().Release(this);
+}
+
+uint32 FGenericInternPool::Release(const FGenericSharedPayload* Payload)
+{
+	// Intern only hands out references under the lock, so the count cannot grow back while it is held
+	FScopeLock ScopeLock(&Lock);
+	const int32 Refs = Payload->RefCount.fetch_sub(1) - 1;
+	if (Refs == 0)
+	{
+		--Stats.UniquePayloads;
+		Stats.UniqueBytes -= GetPayloadSize(Payload->Data, Payload->PlainData);
+		Payloads.RemoveSingle(Payload->Hash, const_cast<FGenericSharedPayload*>(Payload));
+		delete Payload;
+	}
+	return (uint32)Refs;
+}
+
+void FGenericInternPool::Compact()
+{
+	FScopeLock ScopeLock(&Lock);
+	Payloads.Compact();
+	Payloads.Shrink();
+}
+
+FGenericInternPool::FStats FGenericInternPool::GetStats() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Stats;
+}
+
+void FGenericInternPool::ResetStats()
+{
+	FScopeLock ScopeLock(&Lock);
+	Stats.Requests = 0;
+	Stats.Hits = 0;
+	Stats.DedupedBytes = 0;
+}
+
+void FGenericInternPool::OnPostLoadMap(UWorld* LoadedWorld)
+{
+	if (GGenericInternCompactOnMapLoad)
+	{
+		Compact();
+	}
+}
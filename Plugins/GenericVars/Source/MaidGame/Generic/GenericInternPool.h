@@ -0,0 +1,85 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#pragma once
+
+#include "Core/MaidCoreFwd.h"
+#include "Generic/Generic.h"
+
+/**
+ * Content-addressed pool of immutable FGeneric payloads
+ *
+ * When enabled (generic.intern.enabled), loading an FGeneric moves its Data/PlainData payload into this
+ * pool, and so does FGeneric::Intern, which code assigning values into long-lived assets may call. Writes
+ * never intern: a value rewritten every tick would hash its payload and take the pool lock each time.
+ * Identical payloads, found through a 64-bit CityHash of the content and confirmed by a full compare, are
+ * shared by every FGeneric holding them. A shared payload is never written in place: mutating an FGeneric
+ * detaches it first.
+ *
+ * The pool does not own the payloads, each one leaves the pool with its last reference. Compact() only
+ * shrinks the lookup table; it runs after each map load unless generic.intern.compactonmapload is 0.
+ */
+class MAIDGAME_API FGenericInternPool
+{
+public:
+	struct FStats
+	{
+		/** Number of payloads submitted to the pool */
+		int64 Requests = 0;
+
+		/** Number of submitted payloads that matched an existing one */
+		int64 Hits = 0;
+
+		/** Total bytes of submitted payloads that were shared instead of stored again */
+		int64 DedupedBytes = 0;
+
+		/** Payloads currently held by the pool */
+		int32 UniquePayloads = 0;
+
+		/** Bytes currently held by the pool */
+		int64 UniqueBytes = 0;
+
+		FORCEINLINE double GetDedupeRate() const { return Requests > 0 ? (double)Hits / (double)Requests : 0.0; }
+	};
+
+	static FGenericInternPool& Get();
+
+	/** Check if FGeneric payloads should be interned */
+	static bool IsEnabled();
+
+	/** Smallest payload in bytes worth interning */
+	static int32 GetMinPayloadSize();
+
+	/** Content hash of a payload */
+	static uint64 HashPayload(const FString& Data, const TArray<uint8>& PlainData);
+
+	/**
+	 * Get the shared payload matching the given content
+	 * The content is moved into the pool when no matching payload exists yet.
+	 */
+	TRefCountPtr<FGenericSharedPayload> Intern(FString& InOutData, TArray<uint8>& InOutPlainData);
+
+	/** Shrink the lookup table after many payloads were released, such as after a level load */
+	void Compact();
+
+	FStats GetStats() const;
+	void ResetStats();
+
+private:
+	FGenericInternPool();
+
+	void OnPostLoadMap(UWorld* LoadedWorld);
+
+	/** Drop a reference to a payload under the lock, removing the payload when it was the last one */
+	uint32 Release(const FGenericSharedPayload* Payload);
+
+	friend struct FGenericSharedPayload;
+
+	static int64 GetPayloadSize(const FString& Data, const TArray<uint8>& PlainData)
+	{
+		return Data.Len() * sizeof(TCHAR) + PlainData.Num();
+	}
+
+	mutable FCriticalSection Lock;
+	TMultiMap<uint64, FGenericSharedPayload*> Payloads;
+	FStats Stats;
+};
@@ -0,0 +1,150 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#include "Generic/GenericNested.h"
+
+namespace GenericNested
+{
+	/** Marks a buffer as nested records, so plain data of another type is not misread */
+	static constexpr uint32 Magic = 0x54534E47; // 'GNST'
+
+	static constexpr int32 HeaderSize = sizeof(uint32) + sizeof(int32);
+	static constexpr int32 RecordHeaderSize = 2 * sizeof(int32);
+	static constexpr int32 RecordAlignment = 4;
+
+	FORCEINLINE int32 ReadInt(const uint8* Data)
+	{
+		int32 Value = 0;
+		FMemory::Memcpy(&Value, Data, sizeof(Value));
+		return Value;
+	}
+
+	FORCEINLINE void WriteInt(uint8* Data, int32 Value)
+	{
+		FMemory::Memcpy(Data, &Value, sizeof(Value));
+	}
+}
+
+FGenericNestedView::FGenericNestedView(const uint8* InData, int32 InSize)
+{
+	if (!IsNestedPayload(InData, InSize)) return;
+
+	Data = InData;
+	Size = InSize;
+	NumRecords = GenericNested::ReadInt(InData + sizeof(uint32));
+}
+
+FGenericNestedView::FGenericNestedView(const FGeneric& Generic)
+	: FGenericNestedView((const uint8*)Generic.GetPlainData(), Generic.GetPlainSize())
+{
+}
+
+bool FGenericNestedView::IsNestedPayload(const uint8* InData, int32 InSize)
+{
+	using namespace GenericNested;
+	if (!InData || InSize < HeaderSize) return false;
+
+	uint32 HeaderMagic = 0;
+	FMemory::Memcpy(&HeaderMagic, InData, sizeof(HeaderMagic));
+	const int32 Num = ReadInt(InData + sizeof(uint32));
+	return HeaderMagic == Magic && Num >= 0 && HeaderSize + (int64)Num * sizeof(int32) <= InSize;
+}
+
+bool FGenericNestedView::GetRecord(int32 Index, FRecord& OutRecord) const
+{
+	using namespace GenericNested;
+	if (!IsValidIndex(Index)) return false;
+
+	const int32 Offset = ReadInt(Data + HeaderSize + Index * sizeof(int32));
+	if (Offset < HeaderSize + NumRecords * (int32)sizeof(int32) || (int64)Offset + RecordHeaderSize > Size) return false;
+
+	OutRecord.TextLen = ReadInt(Data + Offset);
+	OutRecord.PlainSize = ReadInt(Data + Offset + sizeof(int32));
+	if (OutRecord.TextLen < 0 || OutRecord.PlainSize < 0) return false;
+
+	const int64 TextSize = (int64)OutRecord.TextLen * sizeof(TCHAR);
+	if (Offset + RecordHeaderSize + TextSize + OutRecord.PlainSize > Size) return false;
+
+	OutRecord.Text = Data + Offset + RecordHeaderSize;
+	OutRecord.Plain = OutRecord.Text + TextSize;
+	return true;
+}
+
+FGeneric FGenericNestedView::Get(int32 Index) const
+{
+	FGeneric Value;
+	Get(Index, Value);
+	return Value;
+}
+
+bool FGenericNestedView::Get(int32 Index, FGeneric& OutValue) const
+{
+	// Clear keeps the buffers of the destination
+	OutValue.Clear();
+
+	FRecord Record;
+	if (!GetRecord(Index, Record)) return false;
+
+	if (Record.TextLen > 0)
+	{
+		TArray<TCHAR>& Chars = OutValue.Data.GetCharArray();
+		Chars.SetNumUninitialized(Record.TextLen + 1);
+		FMemory::Memcpy(Chars.GetData(), Record.Text, Record.TextLen * sizeof(TCHAR));
+		Chars[Record.TextLen] = TEXT('\0');
+	}
+	// Records nested in this value are copied as they are, they decode when it is read
+	OutValue.PlainData.Append(Record.Plain, Record.PlainSize);
+	return true;
+}
+
+FGenericNestedView FGenericNestedView::GetNested(int32 Index) const
+{
+	FRecord Record;
+	if (!GetRecord(Index, Record) || Record.TextLen > 0) return FGenericNestedView();
+
+	return FGenericNestedView(Record.Plain, Record.PlainSize);
+}
+
+void FGenericNestedView::Write(TArray<uint8>& OutData, const FGeneric* Values, int32 NumValues)
+{
+	using namespace GenericNested;
+
+	int64 TotalSize = HeaderSize + (int64)NumValues * sizeof(int32);
+	for (int32 Index = 0; Index < NumValues; ++Index)
+	{
+		TotalSize = Align(TotalSize, RecordAlignment) + RecordHeaderSize
+			+ (int64)Values[Index].GetStringData().Len() * sizeof(TCHAR) + Values[Index].GetPlainSize();
+	}
+	checkf(TotalSize <= MAX_int32, TEXT("Nested generics exceed the size of a plain data buffer"));
+
+	// Zeroed so the padding is deterministic and equal values compare equal
+	OutData.Reset();
+	OutData.AddZeroed((int32)TotalSize);
+
+	uint8* Dest = OutData.GetData();
+	FMemory::Memcpy(Dest, &Magic, sizeof(Magic));
+	WriteInt(Dest + sizeof(uint32), NumValues);
+
+	int32 Offset = HeaderSize + NumValues * sizeof(int32);
+	for (int32 Index = 0; Index < NumValues; ++Index)
+	{
+		const FString& Text = Values[Index].GetStringData();
+		const int32 TextSize = Text.Len() * sizeof(TCHAR);
+		const int32 PlainSize = Values[Index].GetPlainSize();
+
+		Offset = Align(Offset, RecordAlignment);
+		WriteInt(Dest + HeaderSize + Index * sizeof(int32), Offset);
+		WriteInt(Dest + Offset, Text.Len());
+		WriteInt(Dest + Offset + sizeof(int32), PlainSize);
+		Offset += RecordHeaderSize;
+		if (TextSize > 0)
+		{
+			FMemory::Memcpy(Dest + Offset, *Text, TextSize);
+			Offset += TextSize;
+		}
+		if (PlainSize > 0)
+		{
+			FMemory::Memcpy(Dest + Offset, Values[Index].GetPlainData(), PlainSize);
+			Offset += PlainSize;
+		}
+	}
+}
@@ -0,0 +1,89 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Generic/Generic.h"
+
+#include "GenericNested.generated.h"
+
+/**
+ * Read access to generics nested in another generic
+ *
+ * An FGeneric or TArray<FGeneric> assigned to an FGeneric is stored in its plain data as binary records, one
+ * per inner value, each holding the text and plain bytes of that value behind their lengths. Nesting adds no
+ * quoting or escaping, so the payload grows linearly with depth. Records are decoded one level at a time: an
+ * inner value holding generics itself keeps them packed until it is read in turn.
+ *
+ * Layout: { Magic, Num, Offsets[Num] } then per record { TextLen, PlainSize, TCHAR[TextLen], uint8[PlainSize] },
+ * records aligned to 4 bytes.
+ *
+ * Example usage:
+ *   FGeneric Outer = TArray<FGeneric>{ FGeneric(1), FGeneric(FString(TEXT("Two"))) };
+ *   FGenericNestedView View(Outer);
+ *   FString Second = View.Get(1).As<FString>();
+ */
+class MAIDGAME_API FGenericNestedView
+{
+public:
+	FGenericNestedView() = default;
+	FGenericNestedView(const uint8* InData, int32 InSize);
+
+	/** View the values nested in a generic, empty if it holds something else */
+	explicit FGenericNestedView(const FGeneric& Generic);
+
+	FORCEINLINE int32 Num() const { return NumRecords; }
+	FORCEINLINE bool IsValidIndex(int32 Index) const { return Index >= 0 && Index < NumRecords; }
+
+	/** Decode one inner value, Null if the index is out of range */
+	FGeneric Get(int32 Index) const;
+
+	/** Decode one inner value into an existing generic, reusing its buffers */
+	bool Get(int32 Index, FGeneric& OutValue) const;
+
+	/** View the values nested in an inner value without decoding it */
+	FGenericNestedView GetNested(int32 Index) const;
+
+	/** Check if a plain data buffer holds nested records */
+	static bool IsNestedPayload(const uint8* InData, int32 InSize);
+
+private:
+	friend struct FGeneric;
+
+	struct FRecord
+	{
+		const uint8* Text = nullptr;
+		int32 TextLen = 0;
+		const uint8* Plain = nullptr;
+		int32 PlainSize = 0;
+	};
+
+	bool GetRecord(int32 Index, FRecord& OutRecord) const;
+
+	/** Append the records of the values to an empty buffer */
+	static void Write(TArray<uint8>& OutData, const FGeneric* Values, int32 NumValues);
+
+	const uint8* Data = nullptr;
+	int32 Size = 0;
+	int32 NumRecords = 0;
+};
+
+/**
+ * Reflection host for the nested value types
+ * Declared apart from FGenericPropJunkPrivate, which comes before FGeneric and cannot hold one.
+ */
+USTRUCT()
+struct FGenericNestedPropJunkPrivate
+{
+	GENERATED_BODY()
+
+	UPROPERTY() FGeneric Generic;
+	UPROPERTY() TArray<FGeneric> GenericArray;
+
+	static FProperty* GetProperty(bool bArray)
+	{
+		static FProperty* Prop = StaticStruct()->FindPropertyByName(GET_MEMBER_NAME_CHECKED(FGenericNestedPropJunkPrivate, Generic));
+		static FProperty* ArrayProp = StaticStruct()->FindPropertyByName(GET_MEMBER_NAME_CHECKED(FGenericNestedPropJunkPrivate, GenericArray));
+		return bArray ? ArrayProp : Prop;
+	}
+};
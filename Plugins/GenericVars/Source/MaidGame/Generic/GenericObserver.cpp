@@ -0,0 +1,140 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#include "Generic/GenericObserver.h"
+#include "Generic/GenericEventSubsystem.h"
+
+FGenericObservableBag::~FGenericObservableBag()
+{
+	Unbind();
+}
+
+FDelegateHandle FGenericObservableBag::Subscribe(TArray<FName> Keys, FGenericBagChangedDelegate Delegate)
+{
+	if (!Delegate.IsBound()) return FDelegateHandle();
+
+	FListener& Listener = Listeners.AddDefaulted_GetRef();
+	Listener.Keys = MoveTemp(Keys);
+	Listener.Handle = Delegate.GetHandle();
+	Listener.Delegate = MoveTemp(Delegate);
+	return Listener.Handle;
+}
+
+void FGenericObservableBag::Unsubscribe(FDelegateHandle Handle)
+{
+	for (int32 Index = 0; Index < Listeners.Num(); ++Index)
+	{
+		if (Listeners[Index].Handle == Handle)
+		{
+			// Keep the indices of a flush in progress valid, the slot is dropped once it is done
+			if (bFlushing)
+			{
+				Listeners[Index].Delegate.Unbind();
+			}
+			else
+			{
+				Listeners.RemoveAt(Index);
+			}
+			return;
+		}
+	}
+}
+
+void FGenericObservableBag::BindToWorld(const UObject* WorldContextObject)
+{
+	Unbind();
+	if (UGenericEventSubsystem* EventSubsystem = UGenericEventSubsystem::Get(WorldContextObject))
+	{
+		EventSubsystem->AddObservable(this);
+		Subsystem = EventSubsystem;
+	}
+}
+
+void FGenericObservableBag::Unbind()
+{
+	if (UGenericEventSubsystem* EventSubsystem = Subsystem.Get())
+	{
+		EventSubsystem->RemoveObservable(this);
+	}
+	Subsystem.Reset();
+}
+
+int32 FGenericObservableBag::Flush()
+{
+	check(IsInGameThread());
+	if (bFlushing || !HasPendingChanges()) return 0;
+
+	Changed.Reset();
+	const FGenericShape* Shape = Bag.GetShape();
+	for (TConstSetBitIterator<> It(Bag.GetDirtySlots()); It; ++It)
+	{
+		Changed.Add(Shape->GetSlot(It.GetIndex()).Key);
+	}
+	for (const FName& Key : RemovedKeys)
+	{
+		Changed.AddUnique(Key);
+	}
+	Bag.ClearDirty();
+	RemovedKeys.Reset();
+
+	TGuardValue<bool> FlushGuard(bFlushing, true);
+	int32 NumCalled = 0;
+	const int32 NumListeners = Listeners.Num();
+	for (int32 Index = 0; Index < NumListeners; ++Index)
+	{
+		if (!Listeners[Index].Delegate.IsBound()) continue;
+
+		TArrayView<const FName> Keys = Changed;
+		if (Listeners[Index].Keys.Num() > 0)
+		{
+			Filtered.Reset();
+			for (const FName& Key : Changed)
+			{
+				if (Listeners[Index].Keys.Contains(Key))
+				{
+					Filtered.Add(Key);
+				}
+			}
+			if (Filtered.Num() == 0) continue;
+			Keys = Filtered;
+		}
+
+		// Copy the delegate, the listener array may grow while it runs
+		const FGenericBagChangedDelegate Delegate = Listeners[Index].Delegate;
+		Delegate.Execute(*this, Keys);
+		++NumCalled;
+	}
+
+	Listeners.RemoveAll([](const FListener& Listener) { return !Listener.Delegate.IsBound(); });
+	return NumCalled;
+}
+
+bool FGenericObservableBag::HasPendingChanges() const
+{
+	return RemovedKeys.Num() > 0 || Bag.GetDirtySlots().Contains(true);
+}
+
+bool FGenericObservableBag::Remove(const FGenericBagKey& Key)
+{
+	if (!Bag.Remove(Key)) return false;
+	RemovedKeys.AddUnique(Key.Key);
+	return true;
+}
+
+void FGenericObservableBag::Reset()
+{
+	for (const FGenericShape::FSlot& Slot : Bag.GetShape()->GetSlots())
+	{
+		RemovedKeys.AddUnique(Slot.Key);
+	}
+	Bag.Reset();
+}
+
+int32 FGenericObservableBag::GetNumListeners() const
+{
+	int32 NumListeners = 0;
+	for (const FListener& Listener : Listeners)
+	{
+		NumListeners += Listener.Delegate.IsBound() ? 1 : 0;
+	}
+	return NumListeners;
+}
@@ -0,0 +1,106 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Generic/GenericShape.h"
+
+class FGenericObservableBag;
+class UGenericEventSubsystem;
+
+/** Called once per flush with every watched key written since the previous flush */
+DECLARE_DELEGATE_TwoParams(FGenericBagChangedDelegate, const FGenericObservableBag& /*Bag*/, TArrayView<const FName> /*ChangedKeys*/);
+
+/**
+ * FGenericBag whose changes are delivered to listeners in batches
+ *
+ * Writes only set the dirty bit of their slot. Flush collects the dirty and removed keys, clears the bits and
+ * calls each listener once with the keys it watches, so a value written many times in a frame or many values
+ * written together cost one callback per listener. Bind the bag to a world to have it flushed by the
+ * UGenericEventSubsystem tick, after the queued and scheduled events of the frame were delivered.
+ *
+ * Listeners may subscribe or unsubscribe during a flush: new listeners start with the next flush, removed ones
+ * are skipped immediately. Values written by a listener are delivered by the next flush. Game thread only.
+ *
+ * The bag is not a UObject: an owner storing object references in it must call AddReferencedObjects from
+ * its own AddReferencedObjects, or the referenced objects may be collected while still in the bag.
+ *
+ * Example usage:
+ *   Stats.Subscribe({ TEXT("Health") }, FGenericBagChangedDelegate::CreateUObject(this, &UHealthBar::OnStatsChanged));
+ *   Stats.BindToWorld(this);
+ *   Stats.SetValue(TEXT("Health"), 50.f);
+ */
+class MAIDGAME_API FGenericObservableBag : public FNoncopyable
+{
+public:
+	FGenericObservableBag() = default;
+	~FGenericObservableBag();
+
+	/**
+	 * Receive changes of the given keys, or of every key when Keys is empty
+	 * @return Handle to unsubscribe with
+	 */
+	FDelegateHandle Subscribe(TArray<FName> Keys, FGenericBagChangedDelegate Delegate);
+	void Unsubscribe(FDelegateHandle Handle);
+
+	/** Flush the bag once per frame from the tick of the world of an object, until unbound or destroyed */
+	void BindToWorld(const UObject* WorldContextObject);
+	void Unbind();
+
+	/**
+	 * Deliver the changes made since the previous flush
+	 * @return Number of listeners called
+	 */
+	int32 Flush();
+
+	/** Check if a flush would have changes to deliver */
+	bool HasPendingChanges() const;
+
+	/** @see FGenericBag::Set */
+	FORCEINLINE bool Set(const FGenericBagKey& Key, const void* SrcPropertyAddress, const FProperty* SrcProperty) { return Bag.Set(Key, SrcPropertyAddress, SrcProperty); }
+	FORCEINLINE bool SetGeneric(const FGenericBagKey& Key, const FGeneric& Value) { return Bag.SetGeneric(Key, Value); }
+
+	template<typename CppType>
+	FORCEINLINE bool SetValue(const FGenericBagKey& Key, const CppType& Value) { return Bag.SetValue(Key, Value); }
+
+	/** Mutable access counts as a write of the key */
+	template<typename CppType>
+	FORCEINLINE CppType* FindValue(const FGenericBagKey& Key) { return Bag.FindValue<CppType>(Key); }
+
+	/** Remove a key, listeners of the key are notified by the next flush */
+	bool Remove(const FGenericBagKey& Key);
+
+	/** Remove every key, listeners of the removed keys are notified by the next flush */
+	void Reset();
+
+	/** Report hard object references held in the values to the garbage collector, see FGenericBag::AddReferencedObjects */
+	FORCEINLINE void AddReferencedObjects(FReferenceCollector& Collector) { Bag.AddReferencedObjects(Collector); }
+
+	/** Read access to the values, writes have to go through the observable bag */
+	FORCEINLINE const FGenericBag& GetBag() const { return Bag; }
+
+	/** Number of live listeners */
+	int32 GetNumListeners() const;
+
+private:
+	struct FListener
+	{
+		TArray<FName> Keys;
+		FGenericBagChangedDelegate Delegate;
+		FDelegateHandle Handle;
+	};
+
+	FGenericBag Bag;
+
+	/** Keys removed since the previous flush, they have no slot to be marked dirty in */
+	TArray<FName> RemovedKeys;
+
+	TArray<FListener> Listeners;
+
+	/** Changed keys of the flush being delivered, reused between flushes */
+	TArray<FName> Changed;
+	TArray<FName> Filtered;
+
+	TWeakObjectPtr<UGenericEventSubsystem> Subsystem;
+	bool bFlushing = false;
+};
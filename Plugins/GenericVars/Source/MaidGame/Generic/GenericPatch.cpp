@@ -0,0 +1,171 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#include "Generic/GenericPatch.h"
+
+uint32 FGenericPatch::HashPayload(const FGeneric& Generic)
+{
+	const FString& Text = Generic.GetStringData();
+	const uint32 TextHash = FCrc::MemCrc32(*Text, Text.Len() * sizeof(TCHAR));
+	return FCrc::MemCrc32(Generic.GetPlainData(), Generic.GetPlainSize(), TextHash);
+}
+
+bool FGenericPatch::HoldSameType(const FGeneric& From, const FGeneric& To)
+{
+#if WITH_EDITORONLY_DATA
+	// Pin types are interned and survive loading, equal handles mean equal types
+	if (From.EditPinType.IsValid() || To.EditPinType.IsValid())
+	{
+		return From.EditPinType == To.EditPinType;
+	}
+#endif
+	// An unknown type never matches, Apply then drops the type of the target rather than keep a stale one
+	const FProperty* FromProperty = From.GetValueProperty();
+	const FProperty* ToProperty = To.GetValueProperty();
+	return FromProperty && ToProperty && FGeneric::IsSameType(FromProperty, ToProperty);
+}
+
+FGenericPatch FGenericPatch::Diff(const FGeneric& From, const FGeneric& To)
+{
+	FGenericPatch Patch;
+	Patch.BaseHash = HashPayload(From);
+	Patch.bSameType = HoldSameType(From, To);
+
+	const uint8* Base = (const uint8*)From.GetPlainData();
+	const uint8* Result = (const uint8*)To.GetPlainData();
+	const int32 BaseSize = From.GetPlainSize();
+	const int32 ResultSize = To.GetPlainSize();
+	const int32 CommonSize = FMath::Min(BaseSize, ResultSize);
+	if (BaseSize != ResultSize)
+	{
+		Patch.PlainSize = ResultSize;
+	}
+
+	// Bytes past the end of the base always differ
+	int32 Index = 0;
+	while (Index < ResultSize)
+	{
+		while (Index < CommonSize && Base[Index] == Result[Index]) ++Index;
+		if (Index >= ResultSize) break;
+
+		const int32 Start = Index;
+		int32 End = Index + 1;
+		int32 NumEqual = 0;
+		for (++Index; Index < ResultSize; ++Index)
+		{
+			if (Index < CommonSize && Base[Index] == Result[Index])
+			{
+				if (++NumEqual >= MergeGap) break;
+			}
+			else
+			{
+				NumEqual = 0;
+				End = Index + 1;
+			}
+		}
+
+		const int32 Length = End - Start;
+		const int32 EditOffset = Patch.PlainEdits.AddUninitialized(2 * sizeof(int32) + Length);
+		uint8* Edit = Patch.PlainEdits.GetData() + EditOffset;
+		FMemory::Memcpy(Edit, &Start, sizeof(int32));
+		FMemory::Memcpy(Edit + sizeof(int32), &Length, sizeof(int32));
+		FMemory::Memcpy(Edit + 2 * sizeof(int32), Result + Start, Length);
+		Index = End;
+	}
+
+	const FString& BaseText = From.GetStringData();
+	const FString& ResultText = To.GetStringData();
+	if (!BaseText.Equals(ResultText, ESearchCase::CaseSensitive))
+	{
+		const int32 BaseLen = BaseText.Len();
+		const int32 ResultLen = ResultText.Len();
+		const int32 MaxPrefix = FMath::Min(BaseLen, ResultLen);
+		int32 Prefix = 0;
+		while (Prefix < MaxPrefix && BaseText[Prefix] == ResultText[Prefix]) ++Prefix;
+		int32 Suffix = 0;
+		while (Suffix < MaxPrefix - Prefix && BaseText[BaseLen - 1 - Suffix] == ResultText[ResultLen - 1 - Suffix]) ++Suffix;
+
+		Patch.bTextChanged = true;
+		Patch.TextOffset = Prefix;
+		Patch.TextRemoved = BaseLen - Prefix - Suffix;
+		Patch.TextInserted = ResultText.Mid(Prefix, ResultLen - Prefix - Suffix);
+	}
+	return Patch;
+}
+
+bool FGenericPatch::Apply(FGeneric& Target) const
+{
+	if (HashPayload(Target) != BaseHash) return false;
+
+	// Patches may come from the network, check every edit before touching the target
+	const int32 ResultSize = PlainSize != INDEX_NONE ? PlainSize : Target.GetPlainSize();
+	if (ResultSize < 0) return false;
+	for (int32 Offset = 0; Offset < PlainEdits.Num();)
+	{
+		if (Offset + 2 * (int32)sizeof(int32) > PlainEdits.Num()) return false;
+		int32 Start = 0;
+		int32 Length = 0;
+		FMemory::Memcpy(&Start, PlainEdits.GetData() + Offset, sizeof(int32));
+		FMemory::Memcpy(&Length, PlainEdits.GetData() + Offset + sizeof(int32), sizeof(int32));
+		Offset += 2 * sizeof(int32);
+		if (Start < 0 || Length < 0 || (int64)Start + Length > ResultSize || (int64)Offset + Length > PlainEdits.Num()) return false;
+		Offset += Length;
+	}
+	if (bTextChanged && (TextOffset < 0 || TextRemoved < 0 || (int64)TextOffset + TextRemoved > Target.GetStringData().Len())) return false;
+
+	Target.Detach();
+	if (PlainSize != INDEX_NONE)
+	{
+		Target.PlainData.SetNumZeroed(PlainSize);
+	}
+	for (int32 Offset = 0; Offset < PlainEdits.Num();)
+	{
+		int32 Start = 0;
+		int32 Length = 0;
+		FMemory::Memcpy(&Start, PlainEdits.GetData() + Offset, sizeof(int32));
+		FMemory::Memcpy(&Length, PlainEdits.GetData() + Offset + sizeof(int32), sizeof(int32));
+		Offset += 2 * sizeof(int32);
+		FMemory::Memcpy(Target.PlainData.GetData() + Start, PlainEdits.GetData() + Offset, Length);
+		Offset += Length;
+	}
+	if (bTextChanged)
+	{
+		Target.Data.RemoveAt(TextOffset, TextRemoved);
+		Target.Data.InsertAt(TextOffset, TextInserted);
+	}
+
+	// The decoded value no longer matches the payload
+#if GENERIC_USING_CACHE
+	if (FGeneric::FDataCache* Cache = Target.FindDataCache()) Cache->Clear();
+#endif
+	if (!bSameType)
+	{
+		Target.ValueProperty = nullptr;
+#if WITH_EDITORONLY_DATA
+		Target.EditPinType.Reset();
+#endif
+	}
+#if WITH_EDITOR
+	// Object references come from the decoded value like in Set, text is the only payload that can hold them
+	const FProperty* Property = Target.ValueProperty;
+	if (bTextChanged && !Property)
+	{
+		// Loaded values have no property, their references are found in the text itself
+		Target.CacheReferencedObjectsFromText();
+	}
+	else if (bTextChanged && (FGeneric::IsPackedArgs(Property) || FGeneric::IsNested(Property) || FGeneric::IsPlain(Property)))
+	{
+		Target.ClearReferencedObjects();
+	}
+	else if (bTextChanged)
+	{
+		void* Value = FMemory::Malloc(Property->GetSize(), Property->GetMinAlignment());
+		Property->InitializeValue(Value);
+		Target.Get(Value, Property);
+		Target.CacheReferencedObjects(Property, Value);
+		Property->DestroyValue(Value);
+		FMemory::Free(Value);
+	}
+#endif
+	++Target.Version;
+	return true;
+}
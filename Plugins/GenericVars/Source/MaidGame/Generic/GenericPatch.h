@@ -0,0 +1,79 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Generic/Generic.h"
+
+#include "GenericPatch.generated.h"
+
+/**
+ * Compact difference between two generic values
+ *
+ * Plain data is compared byte by byte and recorded as the runs that changed, text is recorded as the span
+ * between the common prefix and suffix of both values. A patch only applies to the value it was made from,
+ * recognized by the hash of its payload, so transactions, replication or save deltas can carry the patch
+ * instead of the whole value and fall back to a full copy when Apply fails.
+ *
+ * Example usage:
+ *   FGenericPatch Patch = FGenericPatch::Diff(Before, After);
+ *   if (!Patch.Apply(Replica)) Replica = After;
+ */
+USTRUCT(BlueprintType)
+struct MAIDGAME_API FGenericPatch
+{
+	GENERATED_BODY()
+
+	/** Make the patch turning From into To */
+	static FGenericPatch Diff(const FGeneric& From, const FGeneric& To);
+
+	/**
+	 * Turn the value the patch was made from into the value it was made to
+	 * @return False if Target holds another value, Target is then left unchanged
+	 */
+	bool Apply(FGeneric& Target) const;
+
+	/** Check if the patch leaves its base value unchanged */
+	FORCEINLINE bool IsEmpty() const { return PlainEdits.Num() == 0 && PlainSize == INDEX_NONE && !bTextChanged; }
+
+	/** Bytes of changed data carried by the patch */
+	int32 GetPayloadSize() const { return PlainEdits.Num() + TextInserted.Len() * sizeof(TCHAR); }
+
+	/** Hash of the payload of a value, identifying the base of a patch */
+	static uint32 HashPayload(const FGeneric& Generic);
+
+	/** Check if two values hold the same type, by pin type in the editor and by property otherwise */
+	static bool HoldSameType(const FGeneric& From, const FGeneric& To);
+
+private:
+	/** Equal bytes shorter than a run header are carried over rather than splitting the run */
+	static constexpr int32 MergeGap = 2 * sizeof(int32);
+
+	UPROPERTY()
+	uint32 BaseHash = 0;
+
+	/** Plain data size of the result, INDEX_NONE when unchanged */
+	UPROPERTY()
+	int32 PlainSize = INDEX_NONE;
+
+	/** Changed runs of the plain data, each an int32 offset and int32 length followed by the bytes */
+	UPROPERTY()
+	TArray<uint8> PlainEdits;
+
+	/** Text replaced from TextOffset over TextRemoved characters by TextInserted */
+	UPROPERTY()
+	int32 TextOffset = 0;
+
+	UPROPERTY()
+	int32 TextRemoved = 0;
+
+	UPROPERTY()
+	FString TextInserted;
+
+	UPROPERTY()
+	bool bTextChanged = false;
+
+	/** Both values hold the same type, see HoldSameType; the target then keeps its type information */
+	UPROPERTY()
+	bool bSameType = true;
+};
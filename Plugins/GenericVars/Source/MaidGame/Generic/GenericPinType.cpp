@@ -0,0 +1,247 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#include "Generic/GenericPinType.h"
+#include "Misc/EngineVersionComparison.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/PropertyTag.h"
+#include "UObject/UObjectGlobals.h"
+
+#if WITH_EDITOR
+#include "EdGraphSchema_K2.h"
+#endif
+
+uint32 GetTypeHash(const FEdGraphPinType& Struct)
+{
+	return HashCombine(
+		HashCombine(
+			HashCombine(
+				HashCombine(GetTypeHash(Struct.PinCategory), GetTypeHash(Struct.PinSubCategory)),
+				HashCombine(GetTypeHash(Struct.PinSubCategoryObject.Get()), GetTypeHash(Struct.PinSubCategoryMemberReference.MemberGuid))
+			),
+			HashCombine(
+				GetTypeHash((int32)Struct.ContainerType),
+				GetTypeHash(((int32)Struct.bIsReference) | ((int32)Struct.bIsConst << 1) | ((int32)Struct.bIsWeakPointer << 2) | ((int32)Struct.bIsUObjectWrapper << 3))
+			)
+		),
+		HashCombine(
+			HashCombine(GetTypeHash(Struct.PinValueType.TerminalCategory), GetTypeHash(Struct.PinValueType.TerminalSubCategory)),
+			HashCombine(GetTypeHash(Struct.PinValueType.TerminalSubCategoryObject.Get()),
+				GetTypeHash(((int32)Struct.PinValueType.bTerminalIsConst) | ((int32)Struct.PinValueType.bTerminalIsWeakPointer << 1) | ((int32)Struct.PinValueType.bTerminalIsUObjectWrapper << 2)))
+		)
+	);
+}
+
+/** Append-only storage behind FGenericPinTypeHandle, entry 0 is the empty pin type */
+class FGenericPinTypeTable
+{
+public:
+	static FGenericPinTypeTable& Get()
+	{
+		static FGenericPinTypeTable* Table = new FGenericPinTypeTable();
+		return *Table;
+	}
+
+	uint32 Intern(const FEdGraphPinType& PinType)
+	{
+		const uint32 Hash = GetTypeHash(PinType);
+		{
+			FReadScopeLock ReadLock(Lock);
+			const uint32 Found = FindLocked(PinType, Hash);
+			if (Found != (uint32)INDEX_NONE) return Found;
+		}
+
+		FWriteScopeLock WriteLock(Lock);
+		const uint32 Found = FindLocked(PinType, Hash);
+		if (Found != (uint32)INDEX_NONE) return Found;
+
+		const uint32 Index = (uint32)Entries.Add(MakeUnique<FEdGraphPinType>(PinType));
+		Lookup.Add(Hash, Index);
+		return Index;
+	}
+
+	const FEdGraphPinType& Resolve(uint32 Index) const
+	{
+		// Entries are heap allocated and never removed, so the reference outlives the lock
+		FReadScopeLock ReadLock(Lock);
+		return Entries.IsValidIndex((int32)Index) ? *Entries[Index] : *Entries[0];
+	}
+
+	int32 Num() const
+	{
+		FReadScopeLock ReadLock(Lock);
+		return Entries.Num() - 1;
+	}
+
+	bool FindField(const FField* Field, uint32& OutIndex) const
+	{
+		FReadScopeLock ReadLock(Lock);
+		const FFieldEntry* Entry = PropertyCache.Find(Field);
+		if (Entry && Entry->Name == Field->GetFName())
+		{
+			OutIndex = Entry->Index;
+			return true;
+		}
+		return false;
+	}
+
+	void AddField(const FField* Field, uint32 Index)
+	{
+		FWriteScopeLock WriteLock(Lock);
+		PropertyCache.Add(Field, { Field->GetFName(), Index });
+	}
+
+	bool FindStruct(const UScriptStruct* Struct, uint32& OutIndex) const
+	{
+		FReadScopeLock ReadLock(Lock);
+		if (const uint32* Index = StructCache.Find(Struct))
+		{
+			OutIndex = *Index;
+			return true;
+		}
+		return false;
+	}
+
+	void AddStruct(const UScriptStruct* Struct, uint32 Index)
+	{
+		FWriteScopeLock WriteLock(Lock);
+		StructCache.Add(Struct, Index);
+	}
+
+private:
+	FGenericPinTypeTable()
+	{
+		Entries.Add(MakeUnique<FEdGraphPinType>());
+		Lookup.Add(GetTypeHash(*Entries[0]), 0);
+		FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FGenericPinTypeTable::ResetFieldCaches);
+#if WITH_EDITOR && UE_VERSION_NEWER_THAN(5, 0, 0)
+		FCoreUObjectDelegates::OnObjectsReinstanced.AddLambda([this](const TMap<UObject*, UObject*>&) { ResetFieldCaches(); });
+#endif
+	}
+
+	/** @return Index of the matching entry, INDEX_NONE if the pin type is not interned yet */
+	uint32 FindLocked(const FEdGraphPinType& PinType, uint32 Hash) const
+	{
+		for (auto It = Lookup.CreateConstKeyIterator(Hash); It; ++It)
+		{
+			if (*Entries[It.Value()] == PinType) return It.Value();
+		}
+		return INDEX_NONE;
+	}
+
+	/** Field addresses may be reused once the owning struct is destroyed or reinstanced */
+	void ResetFieldCaches()
+	{
+		FWriteScopeLock WriteLock(Lock);
+		PropertyCache.Reset();
+		StructCache.Reset();
+	}
+
+	struct FFieldEntry
+	{
+		FName Name;
+		uint32 Index = 0;
+	};
+
+	mutable FRWLock Lock;
+	TArray<TUniquePtr<FEdGraphPinType>> Entries;
+	TMultiMap<uint32, uint32> Lookup;
+	TMap<const FField*, FFieldEntry> PropertyCache;
+	TMap<const UScriptStruct*, uint32> StructCache;
+};
+
+FGenericPinTypeHandle::FGenericPinTypeHandle(const FEdGraphPinType& PinType)
+	: Index(FGenericPinTypeTable::Get().Intern(PinType))
+{
+}
+
+const FEdGraphPinType& FGenericPinTypeHandle::Get() const
+{
+	return FGenericPinTypeTable::Get().Resolve(Index);
+}
+
+#if WITH_EDITOR
+FGenericPinTypeHandle FGenericPinTypeHandle::FromProperty(const FProperty* Property)
+{
+	FGenericPinTypeHandle Handle;
+	if (!Property) return Handle;
+
+	FGenericPinTypeTable& Table = FGenericPinTypeTable::Get();
+	if (!Table.FindField(Property, Handle.Index))
+	{
+		FEdGraphPinType PinType;
+		GetDefault<UEdGraphSchema_K2>()->ConvertPropertyToPinType(Property, PinType);
+		Handle.Index = Table.Intern(PinType);
+		Table.AddField(Property, Handle.Index);
+	}
+	return Handle;
+}
+#endif
+
+FGenericPinTypeHandle FGenericPinTypeHandle::FromStruct(const UScriptStruct* Struct)
+{
+	FGenericPinTypeHandle Handle;
+	if (!Struct) return Handle;
+
+	FGenericPinTypeTable& Table = FGenericPinTypeTable::Get();
+	if (!Table.FindStruct(Struct, Handle.Index))
+	{
+		FEdGraphPinType PinType;
+		PinType.PinCategory = "struct";
+		PinType.PinSubCategoryObject = const_cast<UScriptStruct*>(Struct);
+		Handle.Index = Table.Intern(PinType);
+		Table.AddStruct(Struct, Handle.Index);
+	}
+	return Handle;
+}
+
+int32 FGenericPinTypeHandle::GetNumInterned()
+{
+	return FGenericPinTypeTable::Get().Num();
+}
+
+bool FGenericPinTypeHandle::Serialize(FArchive& Ar)
+{
+	FEdGraphPinType PinType = Get();
+	FEdGraphPinType::StaticStruct()->SerializeItem(Ar, &PinType, nullptr);
+	if (Ar.IsLoading())
+	{
+		*this = FGenericPinTypeHandle(PinType);
+	}
+	return true;
+}
+
+bool FGenericPinTypeHandle::SerializeFromMismatchedTag(const FPropertyTag& Tag, FStructuredArchive::FSlot Slot)
+{
+	// Values saved before the handle existed stored the pin type as a plain FEdGraphPinType
+#if UE_VERSION_NEWER_THAN(5, 4, 0)
+	const FName StructName = Tag.GetType().GetParameterName(0);
+#else
+	const FName StructName = Tag.StructName;
+#endif
+	if (Tag.Type == NAME_StructProperty && StructName == FEdGraphPinType::StaticStruct()->GetFName())
+	{
+		FEdGraphPinType PinType;
+		FEdGraphPinType::StaticStruct()->SerializeItem(Slot, &PinType, nullptr);
+		*this = FGenericPinTypeHandle(PinType);
+		return true;
+	}
+	return false;
+}
+
+bool FGenericPinTypeHandle::ExportTextItem(FString& ValueStr, const FGenericPinTypeHandle& DefaultValue, UObject* Parent, int32 PortFlags, UObject* ExportRootScope) const
+{
+	FEdGraphPinType::StaticStruct()->ExportText(ValueStr, &Get(), &DefaultValue.Get(), Parent, PortFlags, ExportRootScope);
+	return true;
+}
+
+bool FGenericPinTypeHandle::ImportTextItem(const TCHAR*& Buffer, int32 PortFlags, UObject* Parent, FOutputDevice* ErrorText)
+{
+	FEdGraphPinType PinType;
+	UScriptStruct* Struct = FEdGraphPinType::StaticStruct();
+	const TCHAR* Result = Struct->ImportText(Buffer, &PinType, Parent, PortFlags, ErrorText, Struct->GetName());
+	if (!Result) return false;
+
+	Buffer = Result;
+	*this = FGenericPinTypeHandle(PinType);
+	return true;
+}
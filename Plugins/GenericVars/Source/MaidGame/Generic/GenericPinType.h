@@ -0,0 +1,74 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EdGraph/EdGraphPin.h"
+
+#include "GenericPinType.generated.h"
+
+/** Hash of a pin type, consistent with FEdGraphPinType::operator== */
+MAIDGAME_API uint32 GetTypeHash(const FEdGraphPinType& PinType);
+
+/**
+ * Handle to a pin type interned in a global append-only table
+ *
+ * FGeneric stores the editor pin type of its value through this handle instead of a full FEdGraphPinType,
+ * so every value of the same type shares one table entry. Conversions from a property or struct are cached
+ * per field and dropped after garbage collection and reinstancing, when field addresses may be reused.
+ *
+ * The handle serializes the full pin type, and loads pin types saved as a plain FEdGraphPinType property.
+ * A default handle refers to the empty pin type.
+ */
+USTRUCT()
+struct MAIDGAME_API FGenericPinTypeHandle
+{
+	GENERATED_BODY()
+
+	FGenericPinTypeHandle() = default;
+	explicit FGenericPinTypeHandle(const FEdGraphPinType& PinType);
+
+	/** Get the interned pin type, the reference stays valid for the lifetime of the process */
+	const FEdGraphPinType& Get() const;
+
+	/** Check if the handle refers to a non-empty pin type */
+	FORCEINLINE bool IsValid() const { return Index != 0; }
+	FORCEINLINE void Reset() { Index = 0; }
+
+#if WITH_EDITOR
+	/** Get the handle of the pin type a property converts to, cached per property */
+	static FGenericPinTypeHandle FromProperty(const FProperty* Property);
+#endif
+
+	/** Get the handle of the struct pin type of a script struct, cached per struct */
+	static FGenericPinTypeHandle FromStruct(const UScriptStruct* Struct);
+
+	/** Number of distinct pin types interned so far */
+	static int32 GetNumInterned();
+
+	FORCEINLINE bool operator==(const FGenericPinTypeHandle& Other) const { return Index == Other.Index; }
+	FORCEINLINE bool operator!=(const FGenericPinTypeHandle& Other) const { return Index != Other.Index; }
+	friend FORCEINLINE uint32 GetTypeHash(const FGenericPinTypeHandle& Handle) { return Handle.Index; }
+
+	bool Serialize(FArchive& Ar);
+	bool SerializeFromMismatchedTag(const FPropertyTag& Tag, FStructuredArchive::FSlot Slot);
+	bool ExportTextItem(FString& ValueStr, const FGenericPinTypeHandle& DefaultValue, UObject* Parent, int32 PortFlags, UObject* ExportRootScope) const;
+	bool ImportTextItem(const TCHAR*& Buffer, int32 PortFlags, UObject* Parent, FOutputDevice* ErrorText);
+
+private:
+	uint32 Index = 0;
+};
+
+template<>
+struct TStructOpsTypeTraits<FGenericPinTypeHandle> : public TStructOpsTypeTraitsBase2<FGenericPinTypeHandle>
+{
+	enum
+	{
+		WithZeroConstructor = true,
+		WithIdenticalViaEquality = true,
+		WithSerializer = true,
+		WithStructuredSerializeFromMismatchedTag = true,
+		WithExportTextItem = true,
+		WithImportTextItem = true,
+	};
+};
@@ -73,8 +73,8 @@ GENERIC_PROPERTY(FPlane, Plane)
 GENERIC_PROPERTY(FGuid, Guid)
 GENERIC_PROPERTY(FBox, Box)
 GENERIC_PROPERTY(FBox2D, Box2D)
-GENERIC_PROPERTY(FDateTime, Box2D)
-GENERIC_PROPERTY(FTimespan, Box2D)
+GENERIC_PROPERTY(FDateTime, DateTime)
+GENERIC_PROPERTY(FTimespan, Timespan)
 #if UE_VERSION_NEWER_THAN(5, 0, 0)
 GENERIC_PROPERTY(FVector2f, Vector2f)
 GENERIC_PROPERTY(FVector3f, Vector3f)
@@ -0,0 +1,384 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#include "Generic/GenericShape.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/UnrealType.h"
+
+/** Guards the transition tables of every shape; slot data is immutable once published */
+static FRWLock GenericShapeLock;
+
+const FGenericShape* FGenericShape::Root()
+{
+	static const FGenericShape* RootShape = new FGenericShape();
+	return RootShape;
+}
+
+bool FGenericShape::IsSameType(const FProperty* A, const FProperty* B)
+{
+	return FGeneric::IsSameType(A, B);
+}
+
+const FGenericShape* FGenericShape::AddKey(FName Key, const FProperty* Property) const
+{
+	check(Property);
+	ensureMsgf(!SlotIndices.Contains(Key), TEXT("Key %s already exists in generic shape"), *Key.ToString());
+
+	auto FindTransition = [&]() -> const FGenericShape*
+		{
+			if (const auto* Children = Transitions.Find(Key))
+			{
+				for (const FGenericShape* Child : *Children)
+				{
+					if (IsSameType(Child->Slots.Last().Property, Property)) return Child;
+				}
+			}
+			return nullptr;
+		};
+
+	{
+		FReadScopeLock ReadLock(GenericShapeLock);
+		if (const FGenericShape* Child = FindTransition()) return Child;
+	}
+
+	FWriteScopeLock WriteLock(GenericShapeLock);
+	if (const FGenericShape* Child = FindTransition()) return Child;
+
+	FGenericShape* Child = new FGenericShape();
+	Child->Parent = this;
+	Child->Slots = Slots;
+	Child->SlotIndices = SlotIndices;
+
+	FSlot& NewSlot = Child->Slots.AddDefaulted_GetRef();
+	NewSlot.Key = Key;
+	NewSlot.Property = Property;
+	NewSlot.Offset = Align(Size, Property->GetMinAlignment());
+	Child->SlotIndices.Add(Key, Child->Slots.Num() - 1);
+	Child->Size = NewSlot.Offset + Property->GetSize();
+	Child->Alignment = FMath::Max(Alignment, Property->GetMinAlignment());
+
+	Transitions.FindOrAdd(Key).Add(Child);
+	return Child;
+}
+
+const FGenericShape* FGenericShape::ReplaceKey(int32 SlotIndex, const FProperty* Property) const
+{
+	check(Slots.IsValidIndex(SlotIndex));
+	TArray<FSlot> NewSlots = Slots;
+	NewSlots[SlotIndex].Property = Property;
+	return FromSlots(NewSlots);
+}
+
+const FGenericShape* FGenericShape::RemoveKey(int32 SlotIndex) const
+{
+	check(Slots.IsValidIndex(SlotIndex));
+	TArray<FSlot> NewSlots = Slots;
+	NewSlots.RemoveAt(SlotIndex);
+	return FromSlots(NewSlots);
+}
+
+int32 FGenericShape::FindSlot(FName Key) const
+{
+	const int32* SlotIndex = SlotIndices.Find(Key);
+	return SlotIndex ? *SlotIndex : INDEX_NONE;
+}
+
+const FGenericShape* FGenericShape::FromSlots(const TArray<FSlot>& InSlots)
+{
+	const FGenericShape* Result = Root();
+	for (const FSlot& Slot : InSlots)
+	{
+		Result = Result->AddKey(Slot.Key, Slot.Property);
+	}
+	return Result;
+}
+
+static struct
+{
+	void operator()(FReferenceCollector& Collector, const FProperty* Prop, void* Data)
+	{
+#if UE_VERSION_NEWER_THAN(5, 5, 0)
+		const int32 ArrayDim = Prop->GetArrayDim();
+#else
+		const int32 ArrayDim = Prop->ArrayDim;
+#endif
+		for (int32 Index = 0; Index < ArrayDim; ++Index)
+		{
+			void* ValuePtr = (uint8*)Data + Index * Prop->GetElementSize();
+			if (const FObjectProperty* ObjectProp = CastField<FObjectProperty>(Prop))
+			{
+				UObject* Object = ObjectProp->GetObjectPropertyValue(ValuePtr);
+				if (Object)
+				{
+					Collector.AddReferencedObject(Object);
+					ObjectProp->SetObjectPropertyValue(ValuePtr, Object);
+				}
+			}
+			else if (const FStructProperty* StructProp = CastField<FStructProperty>(Prop))
+			{
+				if (FGeneric::IsPlain(Prop)) continue;
+				for (auto* SubProp = StructProp->Struct->PropertyLink; SubProp; SubProp = SubProp->PropertyLinkNext)
+				{
+					(*this)(Collector, SubProp, SubProp->ContainerPtrToValuePtr<void>(ValuePtr));
+				}
+			}
+			else if (const FArrayProperty* ArrayProp = CastField<FArrayProperty>(Prop))
+			{
+				FScriptArrayHelper Helper(ArrayProp, ValuePtr);
+				for (int32 ElemIndex = 0; ElemIndex < Helper.Num(); ++ElemIndex)
+				{
+					(*this)(Collector, ArrayProp->Inner, Helper.GetRawPtr(ElemIndex));
+				}
+			}
+			else if (const FSetProperty* SetProp = CastField<FSetProperty>(Prop))
+			{
+				FScriptSetHelper Helper(SetProp, ValuePtr);
+				for (int32 ElemIndex = 0; ElemIndex < Helper.GetMaxIndex(); ++ElemIndex)
+				{
+					if (!Helper.IsValidIndex(ElemIndex)) continue;
+					(*this)(Collector, SetProp->ElementProp, Helper.GetElementPtr(ElemIndex));
+				}
+			}
+			else if (const FMapProperty* MapProp = CastField<FMapProperty>(Prop))
+			{
+				FScriptMapHelper Helper(MapProp, ValuePtr);
+				for (int32 ElemIndex = 0; ElemIndex < Helper.GetMaxIndex(); ++ElemIndex)
+				{
+					if (!Helper.IsValidIndex(ElemIndex)) continue;
+					(*this)(Collector, MapProp->KeyProp, Helper.GetKeyPtr(ElemIndex));
+					(*this)(Collector, MapProp->ValueProp, Helper.GetValuePtr(ElemIndex));
+				}
+			}
+		}
+	}
+} AddBagReferencedObjectsImpl;
+
+static const FProperty* GetBagGenericProperty()
+{
+	static const FProperty* Prop = FGenericBagPropJunkPrivate::StaticStruct()->FindPropertyByName(
+		GET_MEMBER_NAME_CHECKED(FGenericBagPropJunkPrivate, Generic));
+	return Prop;
+}
+
+FGenericBag::FGenericBag(const FGenericBag& Other)
+{
+	*this = Other;
+}
+
+FGenericBag::FGenericBag(FGenericBag&& Other)
+{
+	*this = MoveTemp(Other);
+}
+
+FGenericBag& FGenericBag::operator=(const FGenericBag& Other)
+{
+	if (this != &Other)
+	{
+		Reset();
+		if (Other.Shape && Other.Shape->GetSize() > 0)
+		{
+			Values = (uint8*)FMemory::Malloc(Other.Shape->GetSize(), Other.Shape->GetAlignment());
+			for (const FGenericShape::FSlot& Slot : Other.Shape->GetSlots())
+			{
+				Slot.Property->InitializeValue(Values + Slot.Offset);
+				Slot.Property->CopyCompleteValue(Values + Slot.Offset, Other.Values + Slot.Offset);
+			}
+		}
+		Shape = Other.Shape;
+		// Every value was just written
+		Dirty.Init(true, Num());
+	}
+	return *this;
+}
+
+FGenericBag& FGenericBag::operator=(FGenericBag&& Other)
+{
+	if (this != &Other)
+	{
+		Reset();
+		Shape = Other.Shape;
+		Values = Other.Values;
+		Dirty = MoveTemp(Other.Dirty);
+		Other.Shape = nullptr;
+		Other.Values = nullptr;
+		Other.Dirty.Empty();
+		++Other.Version;
+	}
+	return *this;
+}
+
+int32 FGenericBag::FindSlot(const FGenericBagKey& Key) const
+{
+	const FGenericShape* CurrentShape = GetShape();
+	const TArray<FGenericShape::FSlot>& Slots = CurrentShape->GetSlots();
+
+	// A slot of another shape lies outside this slot array, it only matches a bag of the shape it was found in
+	const FGenericShape::FSlot* CachedSlot = Key.CachedSlot.load(std::memory_order_relaxed);
+	if (CachedSlot >= Slots.GetData() && CachedSlot < Slots.GetData() + Slots.Num() && CachedSlot->Key == Key.Key)
+	{
+		return (int32)(CachedSlot - Slots.GetData());
+	}
+
+	const int32 SlotIndex = CurrentShape->FindSlot(Key.Key);
+	if (SlotIndex != INDEX_NONE)
+	{
+		Key.CachedSlot.store(&Slots[SlotIndex], std::memory_order_relaxed);
+	}
+	return SlotIndex;
+}
+
+bool FGenericBag::Set(const FGenericBagKey& Key, const void* SrcPropertyAddress, const FProperty* SrcProperty)
+{
+	if (!(SrcPropertyAddress && SrcProperty)) return false;
+
+	int32 SlotIndex = FindSlot(Key);
+	if (SlotIndex == INDEX_NONE)
+	{
+		Reshape(GetShape()->AddKey(Key.Key, SrcProperty));
+		SlotIndex = Shape->Num() - 1;
+	}
+	else if (!FGenericShape::IsSameType(Shape->GetSlot(SlotIndex).Property, SrcProperty))
+	{
+		Reshape(Shape->ReplaceKey(SlotIndex, SrcProperty));
+	}
+
+	const FGenericShape::FSlot& Slot = Shape->GetSlot(SlotIndex);
+	Slot.Property->CopyCompleteValue(Values + Slot.Offset, SrcPropertyAddress);
+	Dirty[SlotIndex] = true;
+	++Version;
+	return true;
+}
+
+bool FGenericBag::Get(const FGenericBagKey& Key, void* DestPropertyAddress, const FProperty* DestProperty) const
+{
+	if (!(DestPropertyAddress && DestProperty)) return false;
+	if (const void* Value = FindValue(Key, DestProperty))
+	{
+		DestProperty->CopyCompleteValue(DestPropertyAddress, Value);
+		return true;
+	}
+	return false;
+}
+
+const void* FGenericBag::FindValue(const FGenericBagKey& Key, const FProperty* Property) const
+{
+	const int32 SlotIndex = FindSlot(Key);
+	if (SlotIndex == INDEX_NONE) return nullptr;
+
+	const FGenericShape::FSlot& Slot = Shape->GetSlot(SlotIndex);
+	if (!FGenericShape::IsSameType(Slot.Property, Property)) return nullptr;
+	return Values + Slot.Offset;
+}
+
+void* FGenericBag::FindValue(const FGenericBagKey& Key, const FProperty* Property)
+{
+	// The caller may write through the address, count it as a write
+	const int32 SlotIndex = FindSlot(Key);
+	if (SlotIndex == INDEX_NONE) return nullptr;
+
+	const FGenericShape::FSlot& Slot = Shape->GetSlot(SlotIndex);
+	if (!FGenericShape::IsSameType(Slot.Property, Property)) return nullptr;
+	Dirty[SlotIndex] = true;
+	++Version;
+	return Values + Slot.Offset;
+}
+
+bool FGenericBag::Remove(const FGenericBagKey& Key)
+{
+	const int32 SlotIndex = FindSlot(Key);
+	if (SlotIndex == INDEX_NONE) return false;
+	Reshape(Shape->RemoveKey(SlotIndex));
+	return true;
+}
+
+bool FGenericBag::SetGeneric(const FGenericBagKey& Key, const FGeneric& Value)
+{
+	return Set(Key, &Value, GetBagGenericProperty());
+}
+
+const FGeneric* FGenericBag::FindGeneric(const FGenericBagKey& Key) const
+{
+	return static_cast<const FGeneric*>(FindValue(Key, GetBagGenericProperty()));
+}
+
+void FGenericBag::Reset()
+{
+	if (Shape)
+	{
+		for (const FGenericShape::FSlot& Slot : Shape->GetSlots())
+		{
+			Slot.Property->DestroyValue(Values + Slot.Offset);
+		}
+	}
+	if (Values)
+	{
+		FMemory::Free(Values);
+	}
+	Values = nullptr;
+	Shape = nullptr;
+	Dirty.Empty();
+	++Version;
+}
+
+bool FGenericBag::IsDirty(const FGenericBagKey& Key) const
+{
+	const int32 SlotIndex = FindSlot(Key);
+	return SlotIndex != INDEX_NONE && Dirty[SlotIndex];
+}
+
+void FGenericBag::ClearDirty()
+{
+	Dirty.SetRange(0, Dirty.Num(), false);
+}
+
+void FGenericBag::Reshape(const FGenericShape* NewShape)
+{
+	const FGenericShape* OldShape = GetShape();
+	uint8* NewValues = NewShape->GetSize() > 0 ? (uint8*)FMemory::Malloc(NewShape->GetSize(), NewShape->GetAlignment()) : nullptr;
+
+	// Values are relocated bitwise, the same assumption TArray makes for its elements
+	// Dirty bits follow their key, new or retyped slots start dirty
+	TBitArray<> Relocated(false, OldShape->Num());
+	TBitArray<> NewDirty(true, NewShape->Num());
+	for (int32 NewIndex = 0; NewIndex < NewShape->Num(); ++NewIndex)
+	{
+		const FGenericShape::FSlot& NewSlot = NewShape->GetSlot(NewIndex);
+		const int32 OldIndex = OldShape->FindSlot(NewSlot.Key);
+		if (OldIndex != INDEX_NONE && FGenericShape::IsSameType(OldShape->GetSlot(OldIndex).Property, NewSlot.Property))
+		{
+			FMemory::Memcpy(NewValues + NewSlot.Offset, Values + OldShape->GetSlot(OldIndex).Offset, NewSlot.Property->GetSize());
+			Relocated[OldIndex] = true;
+			NewDirty[NewIndex] = Dirty.IsValidIndex(OldIndex) && Dirty[OldIndex];
+		}
+		else
+		{
+			NewSlot.Property->InitializeValue(NewValues + NewSlot.Offset);
+		}
+	}
+
+	for (int32 OldIndex = 0; OldIndex < OldShape->Num(); ++OldIndex)
+	{
+		if (!Relocated[OldIndex])
+		{
+			const FGenericShape::FSlot& OldSlot = OldShape->GetSlot(OldIndex);
+			OldSlot.Property->DestroyValue(Values + OldSlot.Offset);
+		}
+	}
+
+	if (Values)
+	{
+		FMemory::Free(Values);
+	}
+	Values = NewValues;
+	Shape = NewShape;
+	Dirty = MoveTemp(NewDirty);
+	++Version;
+}
+
+void FGenericBag::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	if (!Shape) return;
+	for (const FGenericShape::FSlot& Slot : Shape->GetSlots())
+	{
+		AddBagReferencedObjectsImpl(Collector, Slot.Property, Values + Slot.Offset);
+	}
+}
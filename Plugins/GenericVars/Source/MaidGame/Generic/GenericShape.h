@@ -0,0 +1,244 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#pragma once
+
+#include "Core/MaidCoreFwd.h"
+#include "Generic/Generic.h"
+#include <atomic>
+
+#include "GenericShape.generated.h"
+
+/**
+ * Reflection host for the bag value types that cannot live in FGenericPropJunkPrivate
+ * @see FGenericPropJunkPrivate
+ */
+USTRUCT()
+struct FGenericBagPropJunkPrivate
+{
+	GENERATED_BODY()
+
+	UPROPERTY() FGeneric Generic;
+};
+
+/**
+ * Shared layout ("hidden class") of a generic property bag
+ *
+ * A shape describes an ordered list of keys, the property type stored under each key and
+ * the byte offset of every value inside the packed value block of a bag. Shapes are immutable
+ * and interned through a transition tree rooted at FGenericShape::Root(): adding a key to a
+ * shape always yields the same cached child shape, so every bag built with the same ordered
+ * key/type list points at one shared shape instead of duplicating its metadata.
+ *
+ * Shapes are never destroyed. Properties referenced by a shape must outlive it, which holds for
+ * the native properties FGeneric works with (see FGenericPropJunkPrivate).
+ */
+class MAIDGAME_API FGenericShape
+{
+public:
+	/** One key of the shape and the location of its value in the packed value block */
+	struct FSlot
+	{
+		FName Key;
+		const FProperty* Property = nullptr;
+		int32 Offset = 0;
+	};
+
+	/** The empty shape every bag starts from */
+	static const FGenericShape* Root();
+
+	/**
+	 * Get the shape reached by appending a key to this shape
+	 * @param Key - Name of the new key, must not already exist in this shape
+	 * @param Property - Property describing the value type stored under the key
+	 * @return The cached child shape, created on first use
+	 */
+	const FGenericShape* AddKey(FName Key, const FProperty* Property) const;
+
+	/**
+	 * Get the shape with the same ordered key list but a different type for one slot
+	 * @param SlotIndex - Slot to retype
+	 * @param Property - New property type for the slot
+	 */
+	const FGenericShape* ReplaceKey(int32 SlotIndex, const FProperty* Property) const;
+
+	/** Get the shape with the same ordered key list minus one slot */
+	const FGenericShape* RemoveKey(int32 SlotIndex) const;
+
+	/** Find the slot index of a key, or INDEX_NONE */
+	int32 FindSlot(FName Key) const;
+
+	FORCEINLINE int32 Num() const { return Slots.Num(); }
+	FORCEINLINE const FSlot& GetSlot(int32 SlotIndex) const { return Slots[SlotIndex]; }
+	FORCEINLINE const TArray<FSlot>& GetSlots() const { return Slots; }
+
+	/** Size in bytes of the packed value block for this shape */
+	FORCEINLINE int32 GetSize() const { return Size; }
+
+	/** Required alignment of the packed value block for this shape */
+	FORCEINLINE int32 GetAlignment() const { return Alignment; }
+
+	/** Parent shape in the transition tree, null for the root */
+	FORCEINLINE const FGenericShape* GetParent() const { return Parent; }
+
+	/** Check if two properties may share a slot type */
+	static bool IsSameType(const FProperty* A, const FProperty* B);
+
+private:
+	FGenericShape() = default;
+	FGenericShape(const FGenericShape&) = delete;
+	FGenericShape& operator=(const FGenericShape&) = delete;
+
+	/** Rebuild a shape from the root with the given ordered slot list */
+	static const FGenericShape* FromSlots(const TArray<FSlot>& InSlots);
+
+	const FGenericShape* Parent = nullptr;
+	TArray<FSlot> Slots;
+	TMap<FName, int32> SlotIndices;
+	int32 Size = 0;
+	int32 Alignment = 1;
+
+	/** Cached child shapes, keyed by the appended key; one entry per distinct value type */
+	mutable TMap<FName, TArray<FGenericShape*, TInlineAllocator<1>>> Transitions;
+};
+
+/**
+ * Inline cache for repeated lookups of one key
+ *
+ * Remembers the slot found by the last lookup, so looking the key up again in a bag of the same
+ * shape is a range check on the slot pointer. Shapes are never freed and their slots never move,
+ * so the cached slot stays readable and is validated against the bag on every lookup. It is kept
+ * in a single atomic, a static key may be shared by bags used on any thread.
+ */
+struct FGenericBagKey
+{
+	FGenericBagKey(FName InKey) : Key(InKey) {}
+	FGenericBagKey(const TCHAR* InKey) : Key(InKey) {}
+	FGenericBagKey(const FGenericBagKey& Other) : Key(Other.Key), CachedSlot(Other.CachedSlot.load(std::memory_order_relaxed)) {}
+	FGenericBagKey& operator=(const FGenericBagKey& Other)
+	{
+		Key = Other.Key;
+		CachedSlot.store(Other.CachedSlot.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		return *this;
+	}
+
+	FName Key;
+
+private:
+	friend class FGenericBag;
+	mutable std::atomic<const FGenericShape::FSlot*> CachedSlot{ nullptr };
+};
+
+/**
+ * Property bag whose key and type metadata lives in a shared FGenericShape
+ *
+ * The bag itself only stores a shape pointer and one packed, aligned value block laid out as the
+ * shape describes. Adding a key transitions the bag to the cached child shape of its current
+ * shape, so bags filled with the same keys in the same order end up sharing one layout.
+ *
+ * Example usage:
+ *   FGenericBag Bag;
+ *   Bag.SetValue(TEXT("Health"), 100.f);
+ *   static const FGenericBagKey HealthKey(TEXT("Health"));
+ *   const float* Health = Bag.FindValue<float>(HealthKey);
+ */
+class MAIDGAME_API FGenericBag
+{
+public:
+	FGenericBag() = default;
+	FGenericBag(const FGenericBag& Other);
+	FGenericBag(FGenericBag&& Other);
+	FGenericBag& operator=(const FGenericBag& Other);
+	FGenericBag& operator=(FGenericBag&& Other);
+	~FGenericBag() { Reset(); }
+
+	/**
+	 * Set the value stored under a key, adding the key if needed
+	 * If the key exists with a different type the bag transitions to a retyped shape.
+	 * @param Key - Key to write
+	 * @param SrcPropertyAddress - Address of the source data
+	 * @param SrcProperty - Property describing the data type
+	 * @return False if the source is invalid
+	 */
+	bool Set(const FGenericBagKey& Key, const void* SrcPropertyAddress, const FProperty* SrcProperty);
+
+	/**
+	 * Copy the value stored under a key to a destination address
+	 * @return False if the key is missing or stored with a different type
+	 */
+	bool Get(const FGenericBagKey& Key, void* DestPropertyAddress, const FProperty* DestProperty) const;
+
+	/** Get the address of the value stored under a key, or null if missing or of another type */
+	const void* FindValue(const FGenericBagKey& Key, const FProperty* Property) const;
+	void* FindValue(const FGenericBagKey& Key, const FProperty* Property);
+
+	/** Remove a key, transitioning to the shape without it */
+	bool Remove(const FGenericBagKey& Key);
+
+	/** Check if a key exists */
+	FORCEINLINE bool Contains(const FGenericBagKey& Key) const { return FindSlot(Key) != INDEX_NONE; }
+
+	/** Number of keys in the bag */
+	FORCEINLINE int32 Num() const { return Shape ? Shape->Num() : 0; }
+
+	/** Shared layout of this bag */
+	FORCEINLINE const FGenericShape* GetShape() const { return Shape ? Shape : FGenericShape::Root(); }
+
+	/** Destroy all values and return to the root shape */
+	void Reset();
+
+	/**
+	 * Check if the value under a key was written since the last ClearDirty
+	 * Set and the mutable FindValue mark a slot dirty, so a system syncing the bag only visits what changed.
+	 */
+	bool IsDirty(const FGenericBagKey& Key) const;
+
+	/** Dirty bit of every slot, indexed like the slots of GetShape() */
+	FORCEINLINE const TBitArray<>& GetDirtySlots() const { return Dirty; }
+
+	/** Forget which slots were written, usually after syncing them */
+	void ClearDirty();
+
+	/** Stamp increased by every write, key addition or removal, compare it to skip an unchanged bag */
+	FORCEINLINE uint32 GetVersion() const { return Version; }
+
+	/** Report hard object references held in the packed values to the garbage collector */
+	void AddReferencedObjects(FReferenceCollector& Collector);
+
+	/** Store an FGeneric value under a key */
+	bool SetGeneric(const FGenericBagKey& Key, const FGeneric& Value);
+
+	/** Get the FGeneric value stored under a key, or null if missing or of another type */
+	const FGeneric* FindGeneric(const FGenericBagKey& Key) const;
+
+	/** Typed helpers for every type listed in GenericProperties.inl */
+	template<typename CppType>
+	FORCEINLINE bool SetValue(const FGenericBagKey& Key, const CppType& Value)
+	{
+		return Set(Key, &Value, FGenericPropJunkPrivate::Get(CppType()));
+	}
+
+	template<typename CppType>
+	FORCEINLINE const CppType* FindValue(const FGenericBagKey& Key) const
+	{
+		return static_cast<const CppType*>(FindValue(Key, FGenericPropJunkPrivate::Get(CppType())));
+	}
+
+	template<typename CppType>
+	FORCEINLINE CppType* FindValue(const FGenericBagKey& Key)
+	{
+		return static_cast<CppType*>(FindValue(Key, FGenericPropJunkPrivate::Get(CppType())));
+	}
+
+private:
+	int32 FindSlot(const FGenericBagKey& Key) const;
+
+	/** Move the values to a block laid out for NewShape, keeping slots whose key and type survive */
+	void Reshape(const FGenericShape* NewShape);
+
+	const FGenericShape* Shape = nullptr;
+	uint8* Values = nullptr;
+
+	/** One bit per slot of Shape, set by writes */
+	TBitArray<> Dirty;
+	uint32 Version = 0;
+};
@@ -1,6 +1,8 @@
 // Copyright Liquid Fish. All Rights Reserved.
 
 #include "Generic/GenericStatics.h"
+#include "Generic/GenericNested.h"
+#include "Generic/GenericFieldPath.h"
 
 #pragma push_macro("GENERIC_DEF_HELPER")
 #define GENERIC_DEF_HELPER(ValueType, PropertyType)						\
@@ -102,3 +104,109 @@ void UGenericStatics::Clear(FGeneric& Variable)
 {
 	Variable.Clear();
 }
+
+int32 UGenericStatics::GetVersion(const FGeneric& Variable)
+{
+	return (int32)Variable.GetVersion();
+}
+
+FGeneric UGenericStatics::ArgsToGeneric(const FGenericArgs& Args)
+{
+	return FGeneric(Args);
+}
+
+FGenericArgs UGenericStatics::GenericToArgs(const FGeneric& Variable)
+{
+	return Variable.As<FGenericArgs>();
+}
+
+#pragma push_macro("GENERIC_ARGS_HELPER")
+#define GENERIC_ARGS_HELPER(Suffix, CppType, ParamType)							\
+void UGenericStatics::AddArg##Suffix(FGenericArgs& Args, FName Name, ParamType Value)	\
+{																				\
+	Args.Add(Name, Value);														\
+}																				\
+CppType UGenericStatics::GetArgAs##Suffix(const FGenericArgs& Args, FName Name, int32 Index)	\
+{																				\
+	const FGenericArgsView View = Args.View();									\
+	return View.Get<CppType>(Name.IsNone() ? Index : View.IndexOf(Name));		\
+}
+
+GENERIC_ARGS_HELPER(Bool, bool, bool)
+GENERIC_ARGS_HELPER(Int, int32, int32)
+GENERIC_ARGS_HELPER(Int64, int64, int64)
+GENERIC_ARGS_HELPER(Float, float, float)
+GENERIC_ARGS_HELPER(Name, FName, FName)
+GENERIC_ARGS_HELPER(String, FString, const FString&)
+GENERIC_ARGS_HELPER(Vector, FVector, const FVector&)
+GENERIC_ARGS_HELPER(Rotator, FRotator, const FRotator&)
+GENERIC_ARGS_HELPER(Object, UObject*, UObject*)
+#pragma pop_macro("GENERIC_ARGS_HELPER")
+
+int32 UGenericStatics::GetNumArgs(const FGenericArgs& Args)
+{
+	return Args.Num();
+}
+
+int32 UGenericStatics::FindArg(const FGenericArgs& Args, FName Name)
+{
+	return Args.IndexOf(Name);
+}
+
+EGenericArgType UGenericStatics::GetArgType(const FGenericArgs& Args, int32 Index)
+{
+	return Args.View().GetType(Index);
+}
+
+FName UGenericStatics::GetArgName(const FGenericArgs& Args, int32 Index)
+{
+	return Args.View().GetName(Index);
+}
+
+int32 UGenericStatics::GetNumNested(const FGeneric& Variable)
+{
+	return FGenericNestedView(Variable).Num();
+}
+
+FGeneric UGenericStatics::GetNestedAt(const FGeneric& Variable, int32 Index)
+{
+	return FGenericNestedView(Variable).Get(Index);
+}
+
+DEFINE_FUNCTION(UGenericStatics::execGetGenericField)
+{
+	P_GET_STRUCT_REF(FGeneric, Variable);
+	P_GET_OBJECT(UScriptStruct, StructType);
+	P_GET_PROPERTY(FNameProperty, Path);
+	Stack.StepCompiledIn<FProperty>(nullptr);
+	void* DestPropertyAddress = Stack.MostRecentPropertyAddress;
+	FProperty* DestProperty = Stack.MostRecentProperty;
+	P_FINISH;
+	P_NATIVE_BEGIN;
+	*(bool*)RESULT_PARAM = Variable.GetField(FGenericFieldPath::Find(StructType, Path), DestPropertyAddress, DestProperty);
+	P_NATIVE_END;
+}
+
+DEFINE_FUNCTION(UGenericStatics::execSetGenericField)
+{
+	P_GET_STRUCT_REF(FGeneric, Variable);
+	P_GET_OBJECT(UScriptStruct, StructType);
+	P_GET_PROPERTY(FNameProperty, Path);
+	Stack.StepCompiledIn<FProperty>(nullptr);
+	void* SrcPropertyAddress = Stack.MostRecentPropertyAddress;
+	FProperty* SrcProperty = Stack.MostRecentProperty;
+	P_FINISH;
+	P_NATIVE_BEGIN;
+	*(bool*)RESULT_PARAM = Variable.SetField(FGenericFieldPath::Find(StructType, Path), SrcPropertyAddress, SrcProperty);
+	P_NATIVE_END;
+}
+
+FGenericPatch UGenericStatics::MakeGenericPatch(const FGeneric& From, const FGeneric& To)
+{
+	return FGenericPatch::Diff(From, To);
+}
+
+bool UGenericStatics::ApplyGenericPatch(FGeneric& Target, const FGenericPatch& Patch)
+{
+	return Patch.Apply(Target);
+}
@@ -4,6 +4,7 @@
 
 #include "Core/MaidCoreFwd.h"
 #include "Generic/Generic.h"
+#include "Generic/GenericPatch.h"
 
 #include "GenericStatics.generated.h"
 
@@ -193,4 +194,132 @@ public:
     /** Check if FGeneric instance contains no data */
     UFUNCTION(BlueprintPure, Category = "Generic")
     static bool IsEmpty(const FGeneric& Variable);
-};
\ No newline at end of file
+
+    /** Get the version stamp of a FGeneric variable, it changes whenever the variable is written */
+    UFUNCTION(BlueprintPure, Category = "Generic")
+    static int32 GetVersion(const FGeneric& Variable);
+
+public:
+    // ========================
+    // Packed Arguments
+    // ========================
+
+    /** Convert packed arguments to FGeneric, the packed buffer is copied as is */
+    UFUNCTION(BlueprintPure, meta = (DisplayName = "ToGeneric (Args)", KeyWords = "cast convert", CompactNodeTitle = "->", BlueprintAutocast), Category = "Generic|Args")
+    static FGeneric ArgsToGeneric(const FGenericArgs& Args);
+
+    UFUNCTION(BlueprintPure, meta = (DisplayName = "ToArgs (Generic)", KeyWords = "cast convert", CompactNodeTitle = "->", BlueprintAutocast), Category = "Generic|Args")
+    static FGenericArgs GenericToArgs(const FGeneric& Variable);
+
+    /** Append a value to packed arguments, leave Name empty for a positional argument */
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Add Arg (Bool)"), Category = "Generic|Args")
+    static void AddArgBool(UPARAM(ref) FGenericArgs& Args, FName Name, bool Value);
+
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Add Arg (Int)"), Category = "Generic|Args")
+    static void AddArgInt(UPARAM(ref) FGenericArgs& Args, FName Name, int32 Value);
+
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Add Arg (Int64)"), Category = "Generic|Args")
+    static void AddArgInt64(UPARAM(ref) FGenericArgs& Args, FName Name, int64 Value);
+
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Add Arg (Float)"), Category = "Generic|Args")
+    static void AddArgFloat(UPARAM(ref) FGenericArgs& Args, FName Name, float Value);
+
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Add Arg (Name)"), Category = "Generic|Args")
+    static void AddArgName(UPARAM(ref) FGenericArgs& Args, FName Name, FName Value);
+
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Add Arg (String)"), Category = "Generic|Args")
+    static void AddArgString(UPARAM(ref) FGenericArgs& Args, FName Name, const FString& Value);
+
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Add Arg (Vector)"), Category = "Generic|Args")
+    static void AddArgVector(UPARAM(ref) FGenericArgs& Args, FName Name, const FVector& Value);
+
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Add Arg (Rotator)"), Category = "Generic|Args")
+    static void AddArgRotator(UPARAM(ref) FGenericArgs& Args, FName Name, const FRotator& Value);
+
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Add Arg (Object)"), Category = "Generic|Args")
+    static void AddArgObject(UPARAM(ref) FGenericArgs& Args, FName Name, UObject* Value);
+
+    /** Read an argument by Name, or by Index when Name is empty */
+    UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Arg (Bool)"), Category = "Generic|Args")
+    static bool GetArgAsBool(const FGenericArgs& Args, FName Name, int32 Index);
+
+    UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Arg (Int)"), Category = "Generic|Args")
+    static int32 GetArgAsInt(const FGenericArgs& Args, FName Name, int32 Index);
+
+    UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Arg (Int64)"), Category = "Generic|Args")
+    static int64 GetArgAsInt64(const FGenericArgs& Args, FName Name, int32 Index);
+
+    UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Arg (Float)"), Category = "Generic|Args")
+    static float GetArgAsFloat(const FGenericArgs& Args, FName Name, int32 Index);
+
+    UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Arg (Name)"), Category = "Generic|Args")
+    static FName GetArgAsName(const FGenericArgs& Args, FName Name, int32 Index);
+
+    UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Arg (String)"), Category = "Generic|Args")
+    static FString GetArgAsString(const FGenericArgs& Args, FName Name, int32 Index);
+
+    UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Arg (Vector)"), Category = "Generic|Args")
+    static FVector GetArgAsVector(const FGenericArgs& Args, FName Name, int32 Index);
+
+    UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Arg (Rotator)"), Category = "Generic|Args")
+    static FRotator GetArgAsRotator(const FGenericArgs& Args, FName Name, int32 Index);
+
+    UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Arg (Object)"), Category = "Generic|Args")
+    static UObject* GetArgAsObject(const FGenericArgs& Args, FName Name, int32 Index);
+
+    UFUNCTION(BlueprintPure, Category = "Generic|Args")
+    static int32 GetNumArgs(const FGenericArgs& Args);
+
+    /** Index of the first argument with this name, -1 if there is none */
+    UFUNCTION(BlueprintPure, Category = "Generic|Args")
+    static int32 FindArg(const FGenericArgs& Args, FName Name);
+
+    UFUNCTION(BlueprintPure, Category = "Generic|Args")
+    static EGenericArgType GetArgType(const FGenericArgs& Args, int32 Index);
+
+    UFUNCTION(BlueprintPure, Category = "Generic|Args")
+    static FName GetArgName(const FGenericArgs& Args, int32 Index);
+
+public:
+    // ========================
+    // Nested Generics
+    // ========================
+
+    /** Number of generics nested in a generic, 0 if it holds something else */
+    UFUNCTION(BlueprintPure, Category = "Generic|Nested")
+    static int32 GetNumNested(const FGeneric& Variable);
+
+    /** Decode one nested generic, its own nested generics stay packed until read */
+    UFUNCTION(BlueprintPure, Category = "Generic|Nested")
+    static FGeneric GetNestedAt(const FGeneric& Variable, int32 Index);
+
+public:
+    // ========================
+    // Struct Fields
+    // ========================
+
+    /** Read one field of a struct stored in a generic, such as "Location.X", without decoding the rest of it */
+    UFUNCTION(BlueprintCallable, CustomThunk, meta = (CustomStructureParam = "Value", KeyWords = "Obtain,Member,Path"), Category = "Generic|Field")
+    static bool GetGenericField(const FGeneric& Variable, UScriptStruct* StructType, FName Path, int32& Value);
+
+    /** Write one field of a struct stored in a generic, keeping the rest of it */
+    UFUNCTION(BlueprintCallable, CustomThunk, meta = (CustomStructureParam = "Value", KeyWords = "Assign,Member,Path"), Category = "Generic|Field")
+    static bool SetGenericField(UPARAM(ref) FGeneric& Variable, UScriptStruct* StructType, FName Path, const int32& Value);
+
+private:
+    DECLARE_FUNCTION(execGetGenericField);
+    DECLARE_FUNCTION(execSetGenericField);
+
+public:
+    // ========================
+    // Patches
+    // ========================
+
+    /** Make the patch turning From into To, carrying only the changed bytes */
+    UFUNCTION(BlueprintPure, Category = "Generic|Patch")
+    static FGenericPatch MakeGenericPatch(const FGeneric& From, const FGeneric& To);
+
+    /** Apply a patch to the value it was made from, false if Target holds another value */
+    UFUNCTION(BlueprintCallable, Category = "Generic|Patch")
+    static bool ApplyGenericPatch(UPARAM(ref) FGeneric& Target, const FGenericPatch& Patch);
+};
@@ -0,0 +1,194 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#include "Generic/GenericStats.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/ThreadSafeCounter64.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/UnrealType.h"
+
+bool FGenericStats::bEnabled = false;
+
+FAutoConsoleVariableRef FGenericStats::CVarEnabled(
+	TEXT("generic.stats.enable"),
+	FGenericStats::bEnabled,
+	TEXT("Record per-type statistics of FGeneric Set/Get, see generic.stats."));
+
+/** Counters of one type, updated without holding the registry lock */
+struct FGenericTypeCounters
+{
+	FString TypeName;
+	FThreadSafeCounter64 Sets;
+	FThreadSafeCounter64 Gets;
+	FThreadSafeCounter64 CacheHits;
+	FThreadSafeCounter64 CacheMisses;
+	FThreadSafeCounter64 BytesStored;
+	FThreadSafeCounter64 TextBytesParsed;
+};
+
+class FGenericStatsRegistry
+{
+public:
+	static FGenericStatsRegistry& Get()
+	{
+		static FGenericStatsRegistry* Registry = new FGenericStatsRegistry();
+		return *Registry;
+	}
+
+	/** Find the counters of a property or struct, registering its type on first use */
+	template<typename KeyType>
+	FGenericTypeCounters& Find(const KeyType* Key)
+	{
+		{
+			FReadScopeLock ReadLock(Lock);
+			if (FGenericTypeCounters* const* Found = Keys.Find(Key))
+			{
+				return **Found;
+			}
+		}
+
+		const FString TypeName = GetTypeName(Key);
+		FWriteScopeLock WriteLock(Lock);
+		TUniquePtr<FGenericTypeCounters>& Counters = Types.FindOrAdd(TypeName);
+		if (!Counters)
+		{
+			Counters = MakeUnique<FGenericTypeCounters>();
+			Counters->TypeName = TypeName;
+		}
+		Keys.Add(Key, Counters.Get());
+		return *Counters;
+	}
+
+	TArray<FGenericTypeStats> GetSnapshot() const
+	{
+		TArray<FGenericTypeStats> Snapshot;
+		{
+			FReadScopeLock ReadLock(Lock);
+			Snapshot.Reserve(Types.Num());
+			for (const auto& Pair : Types)
+			{
+				const FGenericTypeCounters& Counters = *Pair.Value;
+				FGenericTypeStats& Stats = Snapshot.AddDefaulted_GetRef();
+				Stats.TypeName = Counters.TypeName;
+				Stats.Sets = Counters.Sets.GetValue();
+				Stats.Gets = Counters.Gets.GetValue();
+				Stats.CacheHits = Counters.CacheHits.GetValue();
+				Stats.CacheMisses = Counters.CacheMisses.GetValue();
+				Stats.BytesStored = Counters.BytesStored.GetValue();
+				Stats.TextBytesParsed = Counters.TextBytesParsed.GetValue();
+			}
+		}
+		Snapshot.RemoveAll([](const FGenericTypeStats& Stats) { return Stats.Sets == 0 && Stats.Gets == 0; });
+		Snapshot.Sort([](const FGenericTypeStats& A, const FGenericTypeStats& B) { return A.Sets + A.Gets > B.Sets + B.Gets; });
+		return Snapshot;
+	}
+
+	void Reset()
+	{
+		FReadScopeLock ReadLock(Lock);
+		for (auto& Pair : Types)
+		{
+			FGenericTypeCounters& Counters = *Pair.Value;
+			Counters.Sets.Reset();
+			Counters.Gets.Reset();
+			Counters.CacheHits.Reset();
+			Counters.CacheMisses.Reset();
+			Counters.BytesStored.Reset();
+			Counters.TextBytesParsed.Reset();
+		}
+	}
+
+private:
+	FGenericStatsRegistry()
+	{
+		FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FGenericStatsRegistry::ResetKeys);
+	}
+
+	static FString GetTypeName(const FProperty* Property)
+	{
+		FString ExtendedType;
+		const FString Type = Property->GetCPPType(&ExtendedType);
+		return Type + ExtendedType;
+	}
+
+	static FString GetTypeName(const UScriptStruct* Struct)
+	{
+		return Struct->GetStructCPPName();
+	}
+
+	/** Property and struct addresses may be reused once their owner is collected, type entries stay */
+	void ResetKeys()
+	{
+		FWriteScopeLock WriteLock(Lock);
+		Keys.Reset();
+	}
+
+	mutable FRWLock Lock;
+	TMap<FString, TUniquePtr<FGenericTypeCounters>> Types;
+	TMap<const void*, FGenericTypeCounters*> Keys;
+};
+
+static void RecordSetCounters(FGenericTypeCounters& Counters, int64 BytesStored)
+{
+	Counters.Sets.Increment();
+	Counters.BytesStored.Add(BytesStored);
+}
+
+static void RecordGetCounters(FGenericTypeCounters& Counters, int64 TextBytesParsed, EGenericCacheResult CacheResult)
+{
+	Counters.Gets.Increment();
+	if (TextBytesParsed > 0) Counters.TextBytesParsed.Add(TextBytesParsed);
+	if (CacheResult == EGenericCacheResult::Hit) Counters.CacheHits.Increment();
+	else if (CacheResult == EGenericCacheResult::Miss) Counters.CacheMisses.Increment();
+}
+
+void FGenericStats::SetEnabled(bool bInEnabled)
+{
+	bEnabled = bInEnabled;
+}
+
+void FGenericStats::RecordSet(const FProperty* Property, int64 BytesStored)
+{
+	if (!Property) return;
+	RecordSetCounters(FGenericStatsRegistry::Get().Find(Property), BytesStored);
+}
+
+void FGenericStats::RecordSet(const UScriptStruct* Struct, int64 BytesStored)
+{
+	if (!Struct) return;
+	RecordSetCounters(FGenericStatsRegistry::Get().Find(Struct), BytesStored);
+}
+
+void FGenericStats::RecordGet(const FProperty* Property, int64 TextBytesParsed, EGenericCacheResult CacheResult)
+{
+	if (!Property) return;
+	RecordGetCounters(FGenericStatsRegistry::Get().Find(Property), TextBytesParsed, CacheResult);
+}
+
+void FGenericStats::RecordGet(const UScriptStruct* Struct, int64 TextBytesParsed, EGenericCacheResult CacheResult)
+{
+	if (!Struct) return;
+	RecordGetCounters(FGenericStatsRegistry::Get().Find(Struct), TextBytesParsed, CacheResult);
+}
+
+TArray<FGenericTypeStats> FGenericStats::GetSnapshot()
+{
+	return FGenericStatsRegistry::Get().GetSnapshot();
+}
+
+void FGenericStats::Reset()
+{
+	FGenericStatsRegistry::Get().Reset();
+}
+
+FString FGenericStats::ToCSV(const TArray<FGenericTypeStats>& Stats)
+{
+	FString Csv = TEXT("Type,Sets,Gets,CacheHits,CacheMisses,BytesStored,TextBytesParsed\n");
+	for (const FGenericTypeStats& Entry : Stats)
+	{
+		// Container type names contain commas
+		Csv += FString::Printf(TEXT("\"%s\",%lld,%lld,%lld,%lld,%lld,%lld\n"),
+			*Entry.TypeName, Entry.Sets, Entry.Gets, Entry.CacheHits, Entry.CacheMisses, Entry.BytesStored, Entry.TextBytesParsed);
+	}
+	return Csv;
+}
@@ -0,0 +1,81 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FAutoConsoleVariableRef;
+
+#ifndef GENERIC_STATS_ENABLED
+#define GENERIC_STATS_ENABLED (!UE_BUILD_SHIPPING)
+#endif
+
+/** Outcome of the FGeneric data cache for a Get */
+enum class EGenericCacheResult : uint8
+{
+	/** The value was read without going through the cache (plain data, cache disabled) */
+	None,
+	Hit,
+	Miss,
+};
+
+/** Traffic of one stored type through FGeneric */
+struct FGenericTypeStats
+{
+	/** C++ type name, including template arguments of containers */
+	FString TypeName;
+
+	int64 Sets = 0;
+	int64 Gets = 0;
+	int64 CacheHits = 0;
+	int64 CacheMisses = 0;
+
+	/** Bytes of plain data and exported text written by the recorded Sets */
+	int64 BytesStored = 0;
+
+	/** Bytes of text imported by the recorded Gets */
+	int64 TextBytesParsed = 0;
+};
+
+/**
+ * Global per-type statistics of FGeneric::Set/Get
+ *
+ * Recording is off by default and toggled at runtime with generic.stats.enable; while off, the cost is a
+ * single branch in Set and Get. Counters are grouped by the C++ type of the stored value, so every
+ * property of the same type shares one entry. Compiled out when GENERIC_STATS_ENABLED is 0.
+ * @see generic.stats, generic.stats.reset, generic.stats.csv
+ */
+class MAIDGAME_API FGenericStats
+{
+public:
+	FORCEINLINE static bool IsEnabled() { return bEnabled; }
+	static void SetEnabled(bool bInEnabled);
+
+	static void RecordSet(const FProperty* Property, int64 BytesStored);
+	static void RecordSet(const UScriptStruct* Struct, int64 BytesStored);
+	static void RecordGet(const FProperty* Property, int64 TextBytesParsed, EGenericCacheResult CacheResult);
+	static void RecordGet(const UScriptStruct* Struct, int64 TextBytesParsed, EGenericCacheResult CacheResult);
+
+	/** Get the recorded statistics, busiest types first */
+	static TArray<FGenericTypeStats> GetSnapshot();
+
+	/** Zero all counters, the registered types are kept */
+	static void Reset();
+
+	/** Format statistics as CSV with a header line */
+	static FString ToCSV(const TArray<FGenericTypeStats>& Stats);
+
+private:
+	static bool bEnabled;
+	static FAutoConsoleVariableRef CVarEnabled;
+};
+
+#if GENERIC_STATS_ENABLED
+#define GENERIC_STATS_RECORD_SET(Type, BytesStored) \
+	do { if (FGenericStats::IsEnabled()) FGenericStats::RecordSet(Type, BytesStored); } while (0)
+#define GENERIC_STATS_RECORD_GET(Type, TextBytesParsed, CacheResult) \
+	do { if (FGenericStats::IsEnabled()) FGenericStats::RecordGet(Type, TextBytesParsed, CacheResult); } while (0)
+#else
+#define GENERIC_STATS_RECORD_SET(Type, BytesStored)
+#define GENERIC_STATS_RECORD_GET(Type, TextBytesParsed, CacheResult)
+#endif
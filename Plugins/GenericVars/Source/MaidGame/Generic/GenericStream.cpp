@@ -0,0 +1,374 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#include "Generic/GenericStream.h"
+#include "Core/Logging/MaidLogs.h"
+#include "Async/Async.h"
+#include "HAL/Event.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+
+static int32 GGenericStreamChunkSize = 64 * 1024;
+static FAutoConsoleVariableRef CVarGenericStreamChunkSize(
+	TEXT("generic.stream.chunksize"),
+	GGenericStreamChunkSize,
+	TEXT("Payload bytes per chunk of generic streams opened afterwards."));
+
+static int32 GGenericStreamMaxQueuedChunks = 4;
+static FAutoConsoleVariableRef CVarGenericStreamMaxQueuedChunks(
+	TEXT("generic.stream.maxqueuedchunks"),
+	GGenericStreamMaxQueuedChunks,
+	TEXT("Chunks a background generic stream writer holds before adding values blocks."));
+
+namespace GenericStream
+{
+	static constexpr uint32 Magic = 0x52545347; // 'GSTR'
+	static constexpr uint32 ChunkMagic = 0x4B484347; // 'GCHK'
+	static constexpr int32 FormatVersion = 2;
+
+	/** Records hold raw TCHAR text and plain data in the byte order of the writer */
+	static constexpr uint8 CharSize = sizeof(TCHAR);
+	static constexpr uint8 LittleEndian = PLATFORM_LITTLE_ENDIAN ? 1 : 0;
+
+	/** Magic, record count, payload size, CRC and first record index */
+	static constexpr int32 ChunkHeaderSize = 4 * sizeof(int32) + sizeof(int64);
+	static constexpr int32 RecordHeaderSize = 2 * sizeof(int32);
+	static constexpr int32 RecordAlignment = 4;
+
+	/** Largest payload accepted from an archive of unknown size */
+	static constexpr int32 MaxPayloadSize = 256 * 1024 * 1024;
+
+	FORCEINLINE int32 ReadInt(const uint8* Data)
+	{
+		int32 Value = 0;
+		FMemory::Memcpy(&Value, Data, sizeof(Value));
+		return Value;
+	}
+
+	FORCEINLINE void WriteInt(uint8* Data, int32 Value)
+	{
+		FMemory::Memcpy(Data, &Value, sizeof(Value));
+	}
+}
+
+FGenericStreamWriter::FGenericStreamWriter(FArchive& InAr, bool bInBackground, int32 InChunkSize)
+	: Ar(InAr)
+	, ChunkSize(InChunkSize > 0 ? InChunkSize : FMath::Max(GGenericStreamChunkSize, 1024))
+	, bBackground(bInBackground)
+{
+	using namespace GenericStream;
+	check(Ar.IsSaving());
+
+	uint32 HeaderMagic = Magic;
+	int32 HeaderVersion = FormatVersion;
+	uint8 HeaderCharSize = CharSize;
+	uint8 HeaderLittleEndian = LittleEndian;
+	Ar << HeaderMagic << HeaderVersion << ChunkSize << HeaderCharSize << HeaderLittleEndian;
+
+	Chunk.Reserve(ChunkHeaderSize + ChunkSize);
+	Chunk.AddZeroed(ChunkHeaderSize);
+	if (bBackground)
+	{
+		ChunkWritten = FPlatformProcess::GetSynchEventFromPool(false);
+	}
+}
+
+FGenericStreamWriter::~FGenericStreamWriter()
+{
+	Close();
+	if (ChunkWritten)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(ChunkWritten);
+	}
+}
+
+void FGenericStreamWriter::Add(const FGeneric& Value)
+{
+	using namespace GenericStream;
+	check(!bClosed);
+
+	// Packed arguments hold runtime name and object handles, the record keeps its place but not the value
+	if (!ensureMsgf(!FGenericArgsView(Value).IsValid(), TEXT("Generic stream: packed arguments cannot be saved")))
+	{
+		Add(FGeneric::Null);
+		return;
+	}
+
+	const FString& Text = Value.GetStringData();
+	const int32 TextSize = Text.Len() * sizeof(TCHAR);
+	const int32 PlainSize = Value.GetPlainSize();
+	const int32 RecordSize = Align(RecordHeaderSize + TextSize + PlainSize, RecordAlignment);
+	if (ChunkRecords > 0 && Chunk.Num() - ChunkHeaderSize + RecordSize > ChunkSize)
+	{
+		FlushChunk();
+	}
+
+	// Zeroed so the padding is deterministic
+	const int32 Offset = Chunk.Num();
+	Chunk.AddZeroed(RecordSize);
+	uint8* Dest = Chunk.GetData() + Offset;
+	WriteInt(Dest, Text.Len());
+	WriteInt(Dest + sizeof(int32), PlainSize);
+	FMemory::Memcpy(Dest + RecordHeaderSize, *Text, TextSize);
+	FMemory::Memcpy(Dest + RecordHeaderSize + TextSize, Value.GetPlainData(), PlainSize);
+	++ChunkRecords;
+	++NumRecords;
+}
+
+void FGenericStreamWriter::FlushChunk()
+{
+	using namespace GenericStream;
+	if (ChunkRecords == 0) return;
+
+	uint8* Header = Chunk.GetData();
+	const int32 PayloadSize = Chunk.Num() - ChunkHeaderSize;
+	const uint32 Crc = FCrc::MemCrc32(Header + ChunkHeaderSize, PayloadSize);
+	FMemory::Memcpy(Header, &ChunkMagic, sizeof(uint32));
+	WriteInt(Header + sizeof(int32), ChunkRecords);
+	WriteInt(Header + 2 * sizeof(int32), PayloadSize);
+	FMemory::Memcpy(Header + 3 * sizeof(int32), &Crc, sizeof(uint32));
+	FMemory::Memcpy(Header + 4 * sizeof(int32), &ChunkFirstRecord, sizeof(int64));
+	ChunkFirstRecord += ChunkRecords;
+	ChunkRecords = 0;
+
+	if (!bBackground)
+	{
+		Ar.Serialize(Chunk.GetData(), Chunk.Num());
+		Chunk.Reset();
+		Chunk.AddZeroed(ChunkHeaderSize);
+		return;
+	}
+
+	// Bound the memory held by chunks the task has not written yet
+	const int32 MaxQueued = FMath::Max(GGenericStreamMaxQueuedChunks, 1);
+	while (NumQueued.load() >= MaxQueued)
+	{
+		ChunkWritten->Wait(10);
+	}
+
+	TArray<uint8> Sealed;
+	Sealed.Reserve(ChunkHeaderSize + ChunkSize);
+	Sealed.AddZeroed(ChunkHeaderSize);
+	Swap(Sealed, Chunk);
+	// A single task writes at a time, so chunks reach the archive in order
+	bool bStartTask = false;
+	{
+		FScopeLock Lock(&DrainLock);
+		Queued.Enqueue(MoveTemp(Sealed));
+		++NumQueued;
+		bStartTask = !bDraining;
+		bDraining = true;
+	}
+	if (bStartTask)
+	{
+		++NumTasks;
+		Async(EAsyncExecution::ThreadPool, [this]() { DrainChunks(); });
+	}
+}
+
+void FGenericStreamWriter::DrainChunks()
+{
+	for (;;)
+	{
+		TArray<uint8> Sealed;
+		while (Queued.Dequeue(Sealed))
+		{
+			Ar.Serialize(Sealed.GetData(), Sealed.Num());
+			--NumQueued;
+			ChunkWritten->Trigger();
+		}
+
+		// The task only stops once it sees the queue empty under the lock, so no chunk is left without a task
+		// and no second task ever dequeues while this one is running
+		FScopeLock Lock(&DrainLock);
+		if (Queued.IsEmpty())
+		{
+			bDraining = false;
+			break;
+		}
+	}
+	ChunkWritten->Trigger();
+	--NumTasks;
+}
+
+bool FGenericStreamWriter::Close()
+{
+	if (bClosed) return !Ar.IsError();
+	bClosed = true;
+
+	FlushChunk();
+	while (NumTasks.load() > 0)
+	{
+		ChunkWritten->Wait(10);
+	}
+	Chunk.Empty();
+	return !Ar.IsError();
+}
+
+FGenericStreamReader::FGenericStreamReader(FArchive& InAr)
+	: Ar(InAr)
+{
+	using namespace GenericStream;
+	check(Ar.IsLoading());
+
+	uint32 HeaderMagic = 0;
+	int32 HeaderVersion = 0;
+	int32 ChunkSize = 0;
+	uint8 HeaderCharSize = 0;
+	uint8 HeaderLittleEndian = 0;
+	Ar << HeaderMagic << HeaderVersion << ChunkSize << HeaderCharSize << HeaderLittleEndian;
+	if (Ar.IsError() || HeaderMagic != Magic || HeaderVersion != FormatVersion) return;
+	if (HeaderCharSize != CharSize || HeaderLittleEndian != LittleEndian)
+	{
+		UE_LOG(LogMAID, Warning, TEXT("Generic stream: written with %d-byte characters in %s byte order, cannot be read on this platform"),
+			HeaderCharSize, HeaderLittleEndian ? TEXT("little-endian") : TEXT("big-endian"));
+		return;
+	}
+
+	FirstChunkOffset = Ar.Tell();
+	NextChunkOffset = FirstChunkOffset;
+	ChunkPosition.Offset = FirstChunkOffset;
+}
+
+bool FGenericStreamReader::ReadChunkHeader(FChunkHeader& OutHeader)
+{
+	using namespace GenericStream;
+	if (Ar.AtEnd()) return false;
+
+	uint32 HeaderMagic = 0;
+	Ar << HeaderMagic << OutHeader.NumRecords << OutHeader.PayloadSize << OutHeader.Crc << OutHeader.FirstRecord;
+	if (Ar.IsError() || HeaderMagic != ChunkMagic || OutHeader.NumRecords <= 0 || OutHeader.PayloadSize < 0) return false;
+
+	const int64 TotalSize = Ar.TotalSize();
+	const int64 MaxSize = TotalSize >= 0 ? TotalSize - Ar.Tell() : MaxPayloadSize;
+	return OutHeader.PayloadSize <= MaxSize;
+}
+
+bool FGenericStreamReader::LoadChunk()
+{
+	Chunk.Reset();
+	ReadOffset = 0;
+	ChunkRecordsLeft = 0;
+	if (!IsValid() || bCorrupt) return false;
+
+	Ar.Seek(NextChunkOffset);
+	const int64 ChunkStart = NextChunkOffset;
+	FChunkHeader Header;
+	if (!ReadChunkHeader(Header)) return false;
+
+	ChunkPosition.Offset = ChunkStart;
+	ChunkPosition.RecordIndex = Header.FirstRecord;
+	RecordIndex = Header.FirstRecord;
+	NextChunkOffset = Ar.Tell() + Header.PayloadSize;
+
+	Chunk.SetNumUninitialized(Header.PayloadSize);
+	Ar.Serialize(Chunk.GetData(), Header.PayloadSize);
+	if (Ar.IsError() || FCrc::MemCrc32(Chunk.GetData(), Chunk.Num()) != Header.Crc)
+	{
+		Chunk.Reset();
+		bCorrupt = true;
+		return false;
+	}
+	ChunkRecordsLeft = Header.NumRecords;
+	return true;
+}
+
+bool FGenericStreamReader::ReadRecord(FGeneric* OutValue)
+{
+	using namespace GenericStream;
+	if (ReadOffset + RecordHeaderSize > Chunk.Num()) return false;
+
+	const uint8* Record = Chunk.GetData() + ReadOffset;
+	const int32 TextLen = ReadInt(Record);
+	const int32 PlainSize = ReadInt(Record + sizeof(int32));
+	const int64 TextSize = (int64)TextLen * sizeof(TCHAR);
+	if (TextLen < 0 || PlainSize < 0 || ReadOffset + RecordHeaderSize + TextSize + PlainSize > Chunk.Num()) return false;
+
+	if (OutValue)
+	{
+		// Clear keeps the buffers of the destination
+		OutValue->Clear();
+		if (TextLen > 0)
+		{
+			TArray<TCHAR>& Chars = OutValue->Data.GetCharArray();
+			Chars.SetNumUninitialized(TextLen + 1);
+			FMemory::Memcpy(Chars.GetData(), Record + RecordHeaderSize, TextSize);
+			Chars[TextLen] = TEXT('\0');
+		}
+		OutValue->PlainData.Append(Record + RecordHeaderSize + TextSize, PlainSize);
+		OutValue->Intern();
+	}
+
+	ReadOffset += Align(RecordHeaderSize + (int32)TextSize + PlainSize, RecordAlignment);
+	--ChunkRecordsLeft;
+	++RecordIndex;
+	return true;
+}
+
+bool FGenericStreamReader::Next(FGeneric& OutValue)
+{
+	if (ChunkRecordsLeft <= 0 && !LoadChunk()) return false;
+	if (ReadRecord(&OutValue)) return true;
+
+	// The checksum matched but the records do not fit the payload, the writer was broken
+	bCorrupt = true;
+	return false;
+}
+
+bool FGenericStreamReader::SkipChunk()
+{
+	if (!IsValid()) return false;
+
+	bCorrupt = false;
+	ChunkRecordsLeft = 0;
+	return LoadChunk();
+}
+
+FGenericStreamPosition FGenericStreamReader::GetChunkPosition() const
+{
+	if (ChunkRecordsLeft > 0 || bCorrupt) return ChunkPosition;
+
+	FGenericStreamPosition Position;
+	Position.Offset = NextChunkOffset;
+	Position.RecordIndex = RecordIndex;
+	return Position;
+}
+
+bool FGenericStreamReader::Seek(const FGenericStreamPosition& Position)
+{
+	if (!IsValid() || Position.Offset < FirstChunkOffset) return false;
+
+	Chunk.Reset();
+	ReadOffset = 0;
+	ChunkRecordsLeft = 0;
+	bCorrupt = false;
+	NextChunkOffset = Position.Offset;
+	ChunkPosition = Position;
+	RecordIndex = Position.RecordIndex;
+	return true;
+}
+
+bool FGenericStreamReader::SeekToRecord(int64 Index)
+{
+	if (!IsValid() || Index < 0) return false;
+
+	// Walk the chunk headers, the payloads on the way are never read
+	int64 ChunkStart = FirstChunkOffset;
+	for (;;)
+	{
+		Ar.Seek(ChunkStart);
+		FChunkHeader Header;
+		if (!ReadChunkHeader(Header)) return false;
+		if (Index < Header.FirstRecord + Header.NumRecords) break;
+		ChunkStart = Ar.Tell() + Header.PayloadSize;
+	}
+
+	FGenericStreamPosition Position;
+	Position.Offset = ChunkStart;
+	Seek(Position);
+	if (!LoadChunk()) return false;
+	while (RecordIndex < Index)
+	{
+		if (!ReadRecord(nullptr)) return false;
+	}
+	return true;
+}
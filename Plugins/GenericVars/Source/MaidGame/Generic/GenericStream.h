@@ -0,0 +1,166 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Generic/Generic.h"
+#include "Containers/Queue.h"
+#include <atomic>
+
+/** Start of a chunk of a generic stream and the index of its first record, where reading can resume */
+struct FGenericStreamPosition
+{
+	int64 Offset = INDEX_NONE;
+	int64 RecordIndex = 0;
+
+	FORCEINLINE bool IsValid() const { return Offset != INDEX_NONE; }
+};
+
+/**
+ * Writes a sequence of generic values to an archive as it is produced
+ *
+ * Values are appended as records to a chunk buffer of generic.stream.chunksize bytes, and each full chunk is
+ * written with its record count, the index of its first record and a CRC of its payload. Records never span
+ * chunks, a value larger than a chunk gets a chunk of its own. Only the chunks not yet written are held in
+ * memory, so a save of any length needs a few chunks of memory instead of the whole object graph.
+ *
+ * With bBackground set, full chunks are written by a thread pool task while the caller keeps adding values.
+ * At most generic.stream.maxqueuedchunks chunks wait for the task, Add blocks beyond that. The archive must
+ * not be touched by anyone else until Close returned.
+ *
+ * Like tagged serialization, records keep the text and plain data of the values but not their property.
+ * Text is stored as TCHAR and plain data in the byte order of the writer. The stream header records both,
+ * and a reader on a platform where either differs refuses the stream instead of misreading it.
+ *
+ * Example usage:
+ *   FGenericStreamWriter Writer(*FileWriter, true);
+ *   for (const FGeneric& Value : Values) Writer.Add(Value);
+ *   bool bSaved = Writer.Close();
+ */
+class MAIDGAME_API FGenericStreamWriter : public FNoncopyable
+{
+public:
+	/** @param InChunkSize - Payload bytes per chunk, generic.stream.chunksize when 0 or less */
+	explicit FGenericStreamWriter(FArchive& InAr, bool bInBackground = false, int32 InChunkSize = 0);
+
+	/** Closes the stream if Close was not called */
+	~FGenericStreamWriter();
+
+	/** Append a value, writing the current chunk first if the value does not fit */
+	void Add(const FGeneric& Value);
+
+	/**
+	 * Write the last chunk and wait for the background writes
+	 * @return False if the archive failed
+	 */
+	bool Close();
+
+	/** Number of values added */
+	FORCEINLINE int64 Num() const { return NumRecords; }
+
+private:
+	/** Seal the current chunk and write it, or hand it to the background task */
+	void FlushChunk();
+
+	/** Write queued chunks until the queue is empty, runs on a thread pool task */
+	void DrainChunks();
+
+	FArchive& Ar;
+	int32 ChunkSize = 0;
+	bool bBackground = false;
+	bool bClosed = false;
+
+	/** Records of the chunk being filled, preceded by room for the chunk header */
+	TArray<uint8> Chunk;
+	int32 ChunkRecords = 0;
+	int64 ChunkFirstRecord = 0;
+	int64 NumRecords = 0;
+
+	/** Sealed chunks waiting for the background task, in order */
+	TQueue<TArray<uint8>, EQueueMode::Spsc> Queued;
+	std::atomic<int32> NumQueued{ 0 };
+	std::atomic<int32> NumTasks{ 0 };
+
+	/** Guards handing the queue between tasks, bDraining is set while a task owns the consumer side */
+	FCriticalSection DrainLock;
+	bool bDraining = false;
+	FEvent* ChunkWritten = nullptr;
+};
+
+/**
+ * Reads a sequence of generic values written by FGenericStreamWriter, one chunk in memory at a time
+ *
+ * Each chunk is checked against its CRC before any of its records is returned. A corrupt chunk stops the
+ * reader until SkipChunk moves on to the next one, so the values of intact chunks can still be recovered.
+ * GetChunkPosition remembers where the current chunk starts, Seek resumes reading there later, and
+ * SeekToRecord finds a record by walking the chunk headers without reading the payloads on the way.
+ *
+ * Example usage:
+ *   FGenericStreamReader Reader(*FileReader);
+ *   FGeneric Value;
+ *   while (Reader.Next(Value)) Values.Add(Value);
+ */
+class MAIDGAME_API FGenericStreamReader : public FNoncopyable
+{
+public:
+	explicit FGenericStreamReader(FArchive& InAr);
+
+	/** Check if the archive holds a generic stream */
+	FORCEINLINE bool IsValid() const { return FirstChunkOffset != INDEX_NONE; }
+
+	/**
+	 * Read the next value, reusing the buffers of OutValue
+	 * @return False at the end of the stream or at a corrupt chunk
+	 */
+	bool Next(FGeneric& OutValue);
+
+	/** Check if reading stopped at a chunk whose payload does not match its checksum */
+	FORCEINLINE bool IsCorrupt() const { return bCorrupt; }
+
+	/**
+	 * Drop the rest of the current chunk, corrupt or not, and continue with the next one
+	 * @return False if there is no next chunk
+	 */
+	bool SkipChunk();
+
+	/** Index of the record the next call to Next returns */
+	FORCEINLINE int64 GetRecordIndex() const { return RecordIndex; }
+
+	/** Start of the chunk being read, or of the next one if no chunk is loaded */
+	FGenericStreamPosition GetChunkPosition() const;
+
+	/** Resume reading at a position returned by GetChunkPosition */
+	bool Seek(const FGenericStreamPosition& Position);
+
+	/** Resume reading at a record, skipping the chunks before it by their headers */
+	bool SeekToRecord(int64 Index);
+
+private:
+	struct FChunkHeader
+	{
+		int32 NumRecords = 0;
+		int32 PayloadSize = 0;
+		uint32 Crc = 0;
+		int64 FirstRecord = 0;
+	};
+
+	bool ReadChunkHeader(FChunkHeader& OutHeader);
+
+	/** Read and check the chunk at the archive position */
+	bool LoadChunk();
+
+	/** Move past the record at ReadOffset, filling OutValue if given */
+	bool ReadRecord(FGeneric* OutValue);
+
+	FArchive& Ar;
+	int64 FirstChunkOffset = INDEX_NONE;
+
+	/** Payload of the loaded chunk */
+	TArray<uint8> Chunk;
+	int32 ReadOffset = 0;
+	int32 ChunkRecordsLeft = 0;
+	FGenericStreamPosition ChunkPosition;
+	int64 NextChunkOffset = INDEX_NONE;
+	int64 RecordIndex = 0;
+	bool bCorrupt = false;
+};
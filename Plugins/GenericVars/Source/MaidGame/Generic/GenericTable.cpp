@@ -0,0 +1,346 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#include "Generic/GenericTable.h"
+#include "Core/Logging/MaidLogs.h"
+#include "Algo/BinarySearch.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/StringBuilder.h"
+#include "UObject/EnumProperty.h"
+#include "UObject/FieldPath.h"
+
+namespace GenericTable
+{
+	static constexpr uint32 Magic = 0x4C425447; // 'GTBL'
+	static constexpr int32 FormatVersion = 2;
+
+	/** Text and plain data are read in place, in the character size and byte order of the writer */
+	static constexpr uint8 CharSize = sizeof(TCHAR);
+	static constexpr uint8 LittleEndian = PLATFORM_LITTLE_ENDIAN ? 1 : 0;
+
+	/** Strings per type entry, the field path and the descriptor */
+	static constexpr int32 TypeEntryInts = 4;
+
+	/** Plain data is read in place, so it keeps the alignment of any struct it may hold */
+	static constexpr int32 PlainAlignment = 16;
+	static constexpr int32 StringAlignment = alignof(int32);
+}
+
+FGenericTable::FGenericTable() = default;
+
+FGenericTable::~FGenericTable()
+{
+	Close();
+}
+
+bool FGenericTable::Open(const TCHAR* Filename)
+{
+	Close();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+#if UE_VERSION_NEWER_THAN(5, 4, 0)
+	FOpenMappedResult Mapped = PlatformFile.OpenMappedEx(Filename);
+	if (Mapped.HasValue())
+	{
+		MappedHandle = Mapped.StealValue();
+	}
+#else
+	MappedHandle.Reset(PlatformFile.OpenMapped(Filename));
+#endif
+	if (MappedHandle)
+	{
+		MappedRegion.Reset(MappedHandle->MapRegion(0, MappedHandle->GetFileSize()));
+		if (MappedRegion && Attach(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize()))
+		{
+			return true;
+		}
+		Close();
+		return false;
+	}
+
+	// Platforms without file mapping read the table whole
+	TArray<uint8> Blob;
+	if (!FFileHelper::LoadFileToArray(Blob, Filename, FILEREAD_Silent)) return false;
+	return Open(MoveTemp(Blob));
+}
+
+bool FGenericTable::Open(TConstArrayView<uint8> Blob)
+{
+	Close();
+	if (Attach(Blob.GetData(), Blob.Num())) return true;
+	Close();
+	return false;
+}
+
+bool FGenericTable::Open(TArray<uint8>&& Blob)
+{
+	Close();
+	OwnedBlob = MoveTemp(Blob);
+	if (Attach(OwnedBlob.GetData(), OwnedBlob.Num())) return true;
+	Close();
+	return false;
+}
+
+void FGenericTable::Close()
+{
+	MappedRegion.Reset();
+	MappedHandle.Reset();
+	OwnedBlob.Empty();
+	Data = nullptr;
+	Size = 0;
+	Types.Reset();
+}
+
+bool FGenericTable::Attach(const uint8* InData, int64 InSize)
+{
+	using namespace GenericTable;
+	if (!InData || InSize < (int64)sizeof(FHeader) || !IsAligned(InData, PlainAlignment)) return false;
+
+	const FHeader& Header = *reinterpret_cast<const FHeader*>(InData);
+	if (Header.Magic != Magic && Header.Magic != BYTESWAP_ORDER32(Magic)) return false;
+	if (Header.CharSize != CharSize || Header.LittleEndian != LittleEndian)
+	{
+		UE_LOG(LogMAID, Warning, TEXT("Generic table: written with %d-byte characters in %s byte order, cannot be read on this platform"),
+			Header.CharSize, Header.LittleEndian ? TEXT("little-endian") : TEXT("big-endian"));
+		return false;
+	}
+	if (Header.Magic != Magic || Header.FormatVersion != FormatVersion || Header.Size != InSize) return false;
+	if (Header.NumRows < 0 || Header.NumTypes < 0) return false;
+	if (Header.TypesOffset < (int32)sizeof(FHeader) || Header.TypesOffset + (int64)Header.NumTypes * TypeEntryInts * sizeof(int32) > InSize) return false;
+	if (!IsAligned(Header.IndexOffset, alignof(FRow)) || Header.IndexOffset < (int32)sizeof(FHeader)
+		|| Header.IndexOffset + (int64)Header.NumRows * sizeof(FRow) > InSize) return false;
+
+	Data = InData;
+	Size = InSize;
+
+	// Types are few, resolving them is the only work done up front
+	const int32* TypeEntries = reinterpret_cast<const int32*>(Data + Header.TypesOffset);
+	Types.SetNumZeroed(Header.NumTypes);
+	for (int32 TypeIndex = 0; TypeIndex < Header.NumTypes; ++TypeIndex)
+	{
+		const int32* Entry = TypeEntries + TypeIndex * TypeEntryInts;
+		const TCHAR* TypePath = GetString(Entry[0], Entry[1]);
+		const TCHAR* Descriptor = GetString(Entry[2], Entry[3]);
+		if (!(TypePath && Descriptor)) return false;
+
+		Types[TypeIndex] = ResolveType(TypePath, Descriptor);
+		if (!Types[TypeIndex])
+		{
+			UE_LOG(LogMAID, Warning, TEXT("Generic table: type %s (%s) no longer exists, its rows are read without type"), TypePath, Descriptor);
+		}
+	}
+	return true;
+}
+
+FString FGenericTable::DescribeType(const FProperty* Type)
+{
+	const UObject* TypeObject = nullptr;
+	if (const FStructProperty* StructProp = CastField<FStructProperty>(Type)) TypeObject = StructProp->Struct;
+	else if (const FEnumProperty* EnumProp = CastField<FEnumProperty>(Type)) TypeObject = EnumProp->GetEnum();
+	else if (const FByteProperty* ByteProp = CastField<FByteProperty>(Type)) TypeObject = ByteProp->Enum;
+	else if (const FObjectPropertyBase* ObjectProp = CastField<FObjectPropertyBase>(Type)) TypeObject = ObjectProp->PropertyClass;
+
+	return FString::Printf(TEXT("%s %s %s %d"), *Type->GetClass()->GetName(), *Type->GetCPPType(),
+		TypeObject ? *TypeObject->GetPathName() : TEXT("None"), Type->GetSize());
+}
+
+const FProperty* FGenericTable::ResolveType(const TCHAR* TypePath, const TCHAR* Descriptor)
+{
+	// The declaring struct may have been changed since, the property is only a hint
+	TFieldPath<FProperty> FieldPath;
+	FieldPath.Generate(TypePath);
+	if (const FProperty* Property = FieldPath.Get(); Property && DescribeType(Property) == Descriptor)
+	{
+		return Property;
+	}
+
+	for (TFieldIterator<FProperty> It(FGenericPropJunkPrivate::StaticStruct()); It; ++It)
+	{
+		if (DescribeType(*It) == Descriptor) return *It;
+	}
+	return nullptr;
+}
+
+const TCHAR* FGenericTable::GetString(int32 Offset, int32 Len) const
+{
+	if (Offset < 0 || Len < 0 || !IsAligned(Offset, alignof(TCHAR))) return nullptr;
+	if (Offset + ((int64)Len + 1) * sizeof(TCHAR) > Size) return nullptr;
+
+	const TCHAR* String = reinterpret_cast<const TCHAR*>(Data + Offset);
+	return String[Len] == TEXT('\0') ? String : nullptr;
+}
+
+uint32 FGenericTable::HashKey(FStringView Key)
+{
+	// Names compare case-insensitively, so must their hashes
+	uint32 Hash = 0;
+	for (TCHAR Char : Key)
+	{
+		const TCHAR Upper = FChar::ToUpper(Char);
+		Hash = FCrc::MemCrc32(&Upper, sizeof(Upper), Hash);
+	}
+	return Hash;
+}
+
+int32 FGenericTable::Num() const
+{
+	return Data ? GetHeader().NumRows : 0;
+}
+
+FName FGenericTable::GetKey(int32 Index) const
+{
+	if (Index < 0 || Index >= Num()) return NAME_None;
+
+	const FRow& Row = GetRows()[Index];
+	const TCHAR* Key = GetString(Row.KeyOffset, Row.KeyLen);
+	return Key ? FName(Key) : NAME_None;
+}
+
+FGenericView FGenericTable::GetRow(int32 Index) const
+{
+	using namespace GenericTable;
+	if (Index < 0 || Index >= Num()) return FGenericView();
+
+	const FRow& Row = GetRows()[Index];
+	const TCHAR* Text = GetString(Row.TextOffset, Row.TextLen);
+	if (!Text) return FGenericView();
+	if (Row.PlainSize < 0 || Row.PlainOffset < 0 || !IsAligned(Row.PlainOffset, PlainAlignment) || (int64)Row.PlainOffset + Row.PlainSize > Size)
+	{
+		return FGenericView();
+	}
+
+	const FProperty* Type = Types.IsValidIndex(Row.TypeIndex) ? Types[Row.TypeIndex] : nullptr;
+	return FGenericView(Text, Row.TextLen, Data + Row.PlainOffset, Row.PlainSize, Type);
+}
+
+int32 FGenericTable::FindIndex(FName Key) const
+{
+	if (!Data) return INDEX_NONE;
+
+	TStringBuilder<NAME_SIZE> KeyString;
+	Key.AppendString(KeyString);
+	const uint32 Hash = HashKey(KeyString.ToView());
+
+	const FRow* Rows = GetRows();
+	const int32 NumRows = Num();
+	int32 Index = Algo::LowerBoundBy(TArrayView<const FRow>(Rows, NumRows), Hash, [](const FRow& Row) { return Row.KeyHash; });
+	for (; Index < NumRows && Rows[Index].KeyHash == Hash; ++Index)
+	{
+		const TCHAR* RowKey = GetString(Rows[Index].KeyOffset, Rows[Index].KeyLen);
+		if (RowKey && Rows[Index].KeyLen == KeyString.Len() && FCString::Strnicmp(RowKey, KeyString.GetData(), KeyString.Len()) == 0)
+		{
+			return Index;
+		}
+	}
+	return INDEX_NONE;
+}
+
+FGenericView FGenericTable::Find(FName Key) const
+{
+	return GetRow(FindIndex(Key));
+}
+
+void FGenericTable::Write(TArray<uint8>& OutData, const TMap<FName, FGeneric>& Rows)
+{
+	using namespace GenericTable;
+
+	struct FPendingRow
+	{
+		FString Key;
+		uint32 Hash = 0;
+		const FGeneric* Value = nullptr;
+		int32 TypeIndex = INDEX_NONE;
+	};
+
+	TArray<const FProperty*> TypeList;
+	TArray<FPendingRow> Pending;
+	Pending.Reserve(Rows.Num());
+	for (const TPair<FName, FGeneric>& Row : Rows)
+	{
+		FPendingRow& Entry = Pending.AddDefaulted_GetRef();
+		Entry.Key = Row.Key.ToString();
+		Entry.Hash = HashKey(Entry.Key);
+		Entry.Value = &Row.Value;
+
+		// Packed arguments hold runtime name and object handles, the row is written empty
+		if (!ensureMsgf(!FGenericArgsView(Row.Value).IsValid(), TEXT("Generic table: packed arguments in row %s cannot be saved"), *Entry.Key))
+		{
+			Entry.Value = &FGeneric::Null;
+		}
+		else if (const FProperty* Type = Row.Value.GetValueProperty())
+		{
+			Entry.TypeIndex = TypeList.AddUnique(Type);
+		}
+	}
+	// Ties are ordered by key so equal tables make equal blobs
+	Pending.Sort([](const FPendingRow& A, const FPendingRow& B) { return A.Hash != B.Hash ? A.Hash < B.Hash : A.Key < B.Key; });
+
+	// Zeroed so the padding is deterministic
+	OutData.Reset();
+	OutData.AddZeroed(sizeof(FHeader));
+	const int32 TypesOffset = OutData.Num();
+	OutData.AddZeroed(TypeList.Num() * TypeEntryInts * sizeof(int32));
+	const int32 IndexOffset = Align(OutData.Num(), alignof(FRow));
+	OutData.SetNumZeroed(IndexOffset + Pending.Num() * sizeof(FRow));
+
+	auto AppendString = [&OutData](const FString& String)
+	{
+		const int32 Offset = Align(OutData.Num(), StringAlignment);
+		OutData.SetNumZeroed(Offset + (String.Len() + 1) * sizeof(TCHAR));
+		FMemory::Memcpy(OutData.GetData() + Offset, *String, String.Len() * sizeof(TCHAR));
+		return Offset;
+	};
+
+	TArray<int32> TypeEntries;
+	for (const FProperty* Type : TypeList)
+	{
+		const FString TypePath = TFieldPath<FProperty>(const_cast<FProperty*>(Type)).ToString();
+		const FString Descriptor = DescribeType(Type);
+		TypeEntries.Add(AppendString(TypePath));
+		TypeEntries.Add(TypePath.Len());
+		TypeEntries.Add(AppendString(Descriptor));
+		TypeEntries.Add(Descriptor.Len());
+	}
+
+	TArray<FRow> Index;
+	Index.Reserve(Pending.Num());
+	for (const FPendingRow& Entry : Pending)
+	{
+		FRow& Row = Index.AddZeroed_GetRef();
+		Row.KeyHash = Entry.Hash;
+		Row.KeyOffset = AppendString(Entry.Key);
+		Row.KeyLen = Entry.Key.Len();
+		Row.TypeIndex = Entry.TypeIndex;
+		Row.TextOffset = AppendString(Entry.Value->GetStringData());
+		Row.TextLen = Entry.Value->GetStringData().Len();
+		Row.PlainSize = Entry.Value->GetPlainSize();
+		Row.PlainOffset = Align(OutData.Num(), PlainAlignment);
+		OutData.SetNumZeroed(Row.PlainOffset + Row.PlainSize);
+		FMemory::Memcpy(OutData.GetData() + Row.PlainOffset, Entry.Value->GetPlainData(), Row.PlainSize);
+	}
+	// The blob is mapped at a page boundary, its size keeps the alignment of the payloads
+	OutData.SetNumZeroed(Align(OutData.Num(), PlainAlignment));
+
+	FHeader Header;
+	FMemory::Memzero(Header);
+	Header.Magic = Magic;
+	Header.FormatVersion = FormatVersion;
+	Header.CharSize = CharSize;
+	Header.LittleEndian = LittleEndian;
+	Header.NumRows = Index.Num();
+	Header.NumTypes = TypeList.Num();
+	Header.TypesOffset = TypesOffset;
+	Header.IndexOffset = IndexOffset;
+	Header.Size = OutData.Num();
+	FMemory::Memcpy(OutData.GetData(), &Header, sizeof(Header));
+	FMemory::Memcpy(OutData.GetData() + TypesOffset, TypeEntries.GetData(), TypeEntries.Num() * sizeof(int32));
+	FMemory::Memcpy(OutData.GetData() + IndexOffset, Index.GetData(), Index.Num() * sizeof(FRow));
+}
+
+bool FGenericTable::WriteToFile(const TCHAR* Filename, const TMap<FName, FGeneric>& Rows)
+{
+	TArray<uint8> Blob;
+	Write(Blob, Rows);
+	return FFileHelper::SaveArrayToFile(Blob, Filename);
+}
@@ -0,0 +1,132 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Generic/GenericView.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Immutable table of named generic values, read in place from a memory-mapped file
+ *
+ * Loading a table of FGeneric rows through serialization allocates a string and an array per row. A table
+ * blob is laid out to be read where it lies instead: Open validates the header and resolves the type table,
+ * and rows are decoded through FGenericView straight from the mapping, so only the pages of rows actually
+ * read are ever touched.
+ *
+ * Layout, all offsets from the start of the blob:
+ *   Header   - magic 'GTBL', format version, TCHAR size and byte order, row and type counts, offsets of
+ *              the type table and index
+ *   Types    - int32 offset and length per type of two null-terminated strings: the field path its property
+ *              had when written, and a descriptor of the type itself (property class, C++ type, struct,
+ *              enum or class path, size). A type resolves to the property at the field path only while
+ *              that property still matches the descriptor, otherwise to a built-in property that does.
+ *   Index    - one FRow per row, sorted by key hash so Find is a binary search
+ *   Payloads - null-terminated key and text of each row, plain data aligned to 16 bytes
+ *
+ * Text and plain data are stored as the writer holds them in memory, a table only opens on platforms with
+ * the same TCHAR size and byte order.
+ *
+ * Example usage:
+ *   FGenericTable::WriteToFile(*Path, Rows);
+ *   FGenericTable Table;
+ *   if (Table.Open(*Path)) float Damage = Table.Find(TEXT("Sword")).As<float>();
+ */
+class MAIDGAME_API FGenericTable : public FNoncopyable
+{
+public:
+	FGenericTable();
+	~FGenericTable();
+
+	/**
+	 * Map a table file, or read it whole where the platform cannot map files
+	 * @return False if the file is missing or not a valid table
+	 */
+	bool Open(const TCHAR* Filename);
+
+	/** Read a table from a blob kept alive by the caller, such as bulk data of an asset */
+	bool Open(TConstArrayView<uint8> Blob);
+
+	/** Read a table from a blob owned by the table */
+	bool Open(TArray<uint8>&& Blob);
+
+	/** Unmap the table, views obtained from it become invalid */
+	void Close();
+
+	FORCEINLINE bool IsOpen() const { return Data != nullptr; }
+
+	/** Number of rows, in key hash order */
+	int32 Num() const;
+
+	FName GetKey(int32 Index) const;
+	FGenericView GetRow(int32 Index) const;
+
+	/** @return Index of the row with this key, INDEX_NONE if there is none */
+	int32 FindIndex(FName Key) const;
+
+	/** @return View of the row with this key, empty if there is none */
+	FGenericView Find(FName Key) const;
+
+	/** Bytes of the table blob */
+	FORCEINLINE int64 GetSize() const { return Size; }
+
+	/** Write a table blob holding the given rows */
+	static void Write(TArray<uint8>& OutData, const TMap<FName, FGeneric>& Rows);
+	static bool WriteToFile(const TCHAR* Filename, const TMap<FName, FGeneric>& Rows);
+
+private:
+	struct FHeader
+	{
+		uint32 Magic;
+		int32 FormatVersion;
+		uint8 CharSize;
+		uint8 LittleEndian;
+		uint16 Reserved;
+		int32 NumRows;
+		int32 NumTypes;
+		int32 TypesOffset;
+		int32 IndexOffset;
+		int64 Size;
+	};
+
+	struct FRow
+	{
+		uint32 KeyHash;
+		int32 KeyOffset;
+		int32 KeyLen;
+		int32 TypeIndex;
+		int32 TextOffset;
+		int32 TextLen;
+		int32 PlainOffset;
+		int32 PlainSize;
+	};
+
+	/** Check the header and the type table, resolve the types */
+	bool Attach(const uint8* InData, int64 InSize);
+
+	const FHeader& GetHeader() const { return *reinterpret_cast<const FHeader*>(Data); }
+	const FRow* GetRows() const { return reinterpret_cast<const FRow*>(Data + GetHeader().IndexOffset); }
+
+	/** Read a null-terminated string of known length, null if it does not fit the blob */
+	const TCHAR* GetString(int32 Offset, int32 Len) const;
+
+	static uint32 HashKey(FStringView Key);
+
+	/** Describe the type of a property by what it holds rather than where it is declared */
+	static FString DescribeType(const FProperty* Type);
+
+	/** Find the property a written type resolves to, null if none matches its descriptor anymore */
+	static const FProperty* ResolveType(const TCHAR* TypePath, const TCHAR* Descriptor);
+
+	TUniquePtr<IMappedFileHandle> MappedHandle;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	TArray<uint8> OwnedBlob;
+
+	const uint8* Data = nullptr;
+	int64 Size = 0;
+
+	/** Property of each type, null where no property matches the type anymore */
+	TArray<const FProperty*> Types;
+};
@@ -0,0 +1,70 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#include "Generic/GenericTrace.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/UnrealType.h"
+
+DEFINE_STAT(STAT_GenericSet);
+DEFINE_STAT(STAT_GenericGet);
+DEFINE_STAT(STAT_GenericExportText);
+DEFINE_STAT(STAT_GenericImportText);
+DEFINE_STAT(STAT_GenericIsPlain);
+DEFINE_STAT(STAT_GenericGetField);
+DEFINE_STAT(STAT_GenericSetField);
+DEFINE_STAT(STAT_GenericLoadSynchronous);
+DEFINE_STAT(STAT_GenericCacheHits);
+DEFINE_STAT(STAT_GenericCacheMisses);
+
+#if GENERIC_TRACE_ENABLED
+UE_TRACE_CHANNEL_DEFINE(GenericChannel);
+
+namespace GenericTrace
+{
+	struct FScopeNames
+	{
+		FRWLock Lock;
+		TMap<TPair<const TCHAR*, const FProperty*>, const TCHAR*> Names;
+
+		/** Every name handed out, never freed since trace scopes may still refer to them after a GC */
+		TSet<FString> Pool;
+
+		FScopeNames()
+		{
+			// Property addresses may be reused once their owner is collected
+			FCoreUObjectDelegates::GetPostGarbageCollect().AddLambda([this]()
+				{
+					FWriteScopeLock WriteLock(Lock);
+					Names.Reset();
+				});
+		}
+	};
+
+	const TCHAR* GetTypeScopeName(const TCHAR* Op, const FProperty* Property)
+	{
+		if (!Property) return Op;
+
+		static FScopeNames* ScopeNames = new FScopeNames();
+		const TPair<const TCHAR*, const FProperty*> Key(Op, Property);
+		{
+			FReadScopeLock ReadLock(ScopeNames->Lock);
+			if (const TCHAR* const* Name = ScopeNames->Names.Find(Key))
+			{
+				return *Name;
+			}
+		}
+
+		// The pool only grows by distinct type names, and FString buffers do not move when the set grows
+		const FString Name = FString::Printf(TEXT("%s %s"), Op, *Property->GetCPPType());
+		FWriteScopeLock WriteLock(ScopeNames->Lock);
+		// Adding an equal name would replace the pooled one and free a buffer still in use
+		const FString* Pooled = ScopeNames->Pool.Find(Name);
+		if (!Pooled)
+		{
+			Pooled = &ScopeNames->Pool[ScopeNames->Pool.Add(Name)];
+		}
+		ScopeNames->Names.Add(Key, **Pooled);
+		return **Pooled;
+	}
+}
+#endif
@@ -0,0 +1,62 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/EngineVersionComparison.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+/**
+ * Profiling hooks of FGeneric
+ *
+ * Cycle stats live in STATGROUP_Generic ("stat Generic"). Trace scopes are emitted on the dedicated
+ * "Generic" trace channel, so they cost nothing unless enabled with -trace=cpu,generic. On UE5 the
+ * Set/Get scopes are additionally named after the stored type ("Set FVector") for per-type breakdowns
+ * in Unreal Insights. Everything compiles out in shipping builds.
+ */
+#ifndef GENERIC_TRACE_ENABLED
+#define GENERIC_TRACE_ENABLED (!UE_BUILD_SHIPPING && CPUPROFILERTRACE_ENABLED)
+#endif
+
+DECLARE_STATS_GROUP(TEXT("Generic"), STATGROUP_Generic, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Set"), STAT_GenericSet, STATGROUP_Generic, MAIDGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Get"), STAT_GenericGet, STATGROUP_Generic, MAIDGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ExportText"), STAT_GenericExportText, STATGROUP_Generic, MAIDGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ImportText"), STAT_GenericImportText, STATGROUP_Generic, MAIDGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("IsPlain"), STAT_GenericIsPlain, STATGROUP_Generic, MAIDGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("GetField"), STAT_GenericGetField, STATGROUP_Generic, MAIDGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("SetField"), STAT_GenericSetField, STATGROUP_Generic, MAIDGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("LoadSynchronous"), STAT_GenericLoadSynchronous, STATGROUP_Generic, MAIDGAME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Cache Hits"), STAT_GenericCacheHits, STATGROUP_Generic, MAIDGAME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Cache Misses"), STAT_GenericCacheMisses, STATGROUP_Generic, MAIDGAME_API);
+
+#if GENERIC_TRACE_ENABLED
+UE_TRACE_CHANNEL_EXTERN(GenericChannel, MAIDGAME_API);
+
+namespace GenericTrace
+{
+	/** Scope name "<Op> <C++ type>" of a property, built once per property and valid for the rest of the session */
+	MAIDGAME_API const TCHAR* GetTypeScopeName(const TCHAR* Op, const FProperty* Property);
+}
+
+#define GENERIC_TRACE_SCOPE_PRIVATE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Generic##Name, GenericChannel)
+
+#if UE_VERSION_NEWER_THAN(5, 0, 0)
+/** Trace scope named after the stored type, only resolved while the Generic channel is enabled */
+#define GENERIC_TRACE_TYPE_SCOPE(Op, Property) \
+	TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL( \
+		UE_TRACE_CHANNELEXPR_IS_ENABLED(GenericChannel) ? GenericTrace::GetTypeScopeName(TEXT(#Op), Property) : TEXT(""), GenericChannel)
+#else
+#define GENERIC_TRACE_TYPE_SCOPE(Op, Property)
+#endif
+#else
+#define GENERIC_TRACE_SCOPE_PRIVATE(Name)
+#define GENERIC_TRACE_TYPE_SCOPE(Op, Property)
+#endif
+
+/** Cycle stat and trace scope around a step of FGeneric */
+#define GENERIC_TRACE_SCOPE(Name) SCOPE_CYCLE_COUNTER(STAT_Generic##Name); GENERIC_TRACE_SCOPE_PRIVATE(Name)
+
+#define GENERIC_STAT_INC(Stat) INC_DWORD_STAT(STAT_Generic##Stat)
@@ -0,0 +1,126 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#include "Generic/GenericView.h"
+#include "Generic/GenericFieldPath.h"
+#include "Generic/GenericTrace.h"
+#include "UObject/EnumProperty.h"
+
+namespace GenericView
+{
+	/** Read plain data of unknown type as a number, by its size like FGeneric::As does */
+	static bool GetPlainNumber(void* DestPropertyAddress, const FProperty* DestProperty, const uint8* PlainData, int32 PlainSize)
+	{
+		if (const FEnumProperty* EnumProp = CastField<FEnumProperty>(DestProperty))
+		{
+			DestProperty = EnumProp->GetUnderlyingProperty();
+		}
+		if (const FBoolProperty* BoolProp = CastField<FBoolProperty>(DestProperty))
+		{
+			bool bValue = false;
+			for (int32 Index = 0; Index < PlainSize && !bValue; ++Index) bValue = PlainData[Index] != 0;
+			BoolProp->SetPropertyValue(DestPropertyAddress, bValue);
+			return true;
+		}
+
+		const FNumericProperty* NumericProp = CastField<FNumericProperty>(DestProperty);
+		if (!NumericProp) return false;
+		if (NumericProp->IsFloatingPoint())
+		{
+			if (PlainSize == sizeof(float)) NumericProp->SetFloatingPointPropertyValue(DestPropertyAddress, *reinterpret_cast<const float*>(PlainData));
+			else if (PlainSize == sizeof(double)) NumericProp->SetFloatingPointPropertyValue(DestPropertyAddress, *reinterpret_cast<const double*>(PlainData));
+			else return false;
+			return true;
+		}
+		if (PlainSize == sizeof(int8)) NumericProp->SetIntPropertyValue(DestPropertyAddress, (int64)*reinterpret_cast<const int8*>(PlainData));
+		else if (PlainSize == sizeof(int16)) NumericProp->SetIntPropertyValue(DestPropertyAddress, (int64)*reinterpret_cast<const int16*>(PlainData));
+		else if (PlainSize == sizeof(int32)) NumericProp->SetIntPropertyValue(DestPropertyAddress, (int64)*reinterpret_cast<const int32*>(PlainData));
+		else if (PlainSize == sizeof(int64)) NumericProp->SetIntPropertyValue(DestPropertyAddress, *reinterpret_cast<const int64*>(PlainData));
+		else return false;
+		return true;
+	}
+}
+
+FGenericView::FGenericView(const FGeneric& Generic)
+	: Text(*Generic.GetStringData())
+	, TextLen(Generic.GetStringData().Len())
+	, PlainData((const uint8*)Generic.GetPlainData())
+	, PlainSize(Generic.GetPlainSize())
+	, Type(Generic.GetValueProperty())
+{
+}
+
+bool FGenericView::Get(void* DestPropertyAddress, const FProperty* DestProperty) const
+{
+	if (!(DestPropertyAddress && DestProperty)) return false;
+
+	if (PlainSize > 0)
+	{
+		// Nested and packed payloads are plain data too, but not a value of their property
+		if (Type && FGeneric::IsPlain(Type) && PlainSize >= Type->GetSize())
+		{
+			if (FGenericFieldPath::CopyValue(DestPropertyAddress, DestProperty, PlainData, Type)) return true;
+		}
+		else if (!Type && FGeneric::IsPlain(DestProperty))
+		{
+			// Numbers convert from the stored size, anything else is only copied into a type of the same size
+			if (DestProperty->IsA<FNumericProperty>() || DestProperty->IsA<FBoolProperty>() || DestProperty->IsA<FEnumProperty>())
+			{
+				if (GenericView::GetPlainNumber(DestPropertyAddress, DestProperty, PlainData, PlainSize)) return true;
+			}
+			else if (PlainSize == DestProperty->GetSize())
+			{
+				DestProperty->CopyCompleteValue(DestPropertyAddress, PlainData);
+				return true;
+			}
+		}
+		DestProperty->ClearValue(DestPropertyAddress);
+		return false;
+	}
+
+	DestProperty->ClearValue(DestPropertyAddress);
+	if (TextLen == 0) return false;
+
+	GENERIC_TRACE_SCOPE(ImportText);
+#if UE_VERSION_NEWER_THAN(5, 1, 0)
+	return DestProperty->ImportText_Direct(Text, DestPropertyAddress, nullptr, PPF_None, nullptr) != nullptr;
+#else
+	return DestProperty->ImportText(Text, DestPropertyAddress, PPF_None, nullptr, nullptr) != nullptr;
+#endif
+}
+
+bool FGenericView::GetStruct(const UScriptStruct* Struct, void* Dest) const
+{
+	if (PlainSize > 0)
+	{
+		const FStructProperty* StructType = CastField<FStructProperty>(Type);
+		const bool bSameStruct = StructType ? StructType->Struct == Struct : FGeneric::IsPlainStruct(Struct);
+		if (bSameStruct && PlainSize == Struct->GetStructureSize())
+		{
+			Struct->CopyScriptStruct(Dest, PlainData);
+			return true;
+		}
+		return false;
+	}
+	if (TextLen == 0) return false;
+
+	GENERIC_TRACE_SCOPE(ImportText);
+	return Struct->ImportText(Text, Dest, nullptr, PPF_None, nullptr, Struct->GetName()) != nullptr;
+}
+
+FGeneric FGenericView::ToGeneric() const
+{
+	FGeneric Value;
+	if (TextLen > 0)
+	{
+		Value.Data = FString(TextLen, Text);
+	}
+	Value.PlainData.Append(PlainData, PlainSize);
+	Value.ValueProperty = FGeneric::IsPersistentProperty(Type) ? Type : nullptr;
+#if WITH_EDITORONLY_DATA && WITH_EDITOR
+	if (Type)
+	{
+		Value.SetEditPinType(Type);
+	}
+#endif
+	return Value;
+}
@@ -0,0 +1,74 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Generic/Generic.h"
+
+/**
+ * Read-only view of a generic value stored elsewhere, such as a row of an FGenericTable
+ *
+ * The view points at exported text and plain data owned by someone else and decodes straight from there,
+ * nothing is copied until ToGeneric is called. Text must be null-terminated in memory. The view is only
+ * valid as long as the memory it points at.
+ *
+ * Nested generics and packed arguments are read with FGenericNestedView and FGenericArgsView over
+ * GetPlainData and GetPlainSize.
+ */
+class MAIDGAME_API FGenericView
+{
+public:
+	FGenericView() = default;
+	FGenericView(const TCHAR* InText, int32 InTextLen, const uint8* InPlainData, int32 InPlainSize, const FProperty* InType = nullptr)
+		: Text(InText), TextLen(InTextLen), PlainData(InPlainData), PlainSize(InPlainSize), Type(InType)
+	{
+	}
+
+	/** View the payload of a generic, valid until the generic is written */
+	explicit FGenericView(const FGeneric& Generic);
+
+	FORCEINLINE bool IsEmpty() const { return TextLen == 0 && PlainSize == 0; }
+
+	/** Exported text of the value, empty for plain data */
+	FORCEINLINE FStringView GetText() const { return FStringView(Text, TextLen); }
+
+	FORCEINLINE const uint8* GetPlainData() const { return PlainData; }
+	FORCEINLINE int32 GetPlainSize() const { return PlainSize; }
+
+	/** Property the value was written from, null if unknown */
+	FORCEINLINE const FProperty* GetType() const { return Type; }
+
+	/**
+	 * Decode the value into a destination address
+	 * Plain data is copied when the types match or converted between numbers, text is imported in place.
+	 * @return False if the value cannot be read as the destination type, which is then left cleared
+	 */
+	bool Get(void* DestPropertyAddress, const FProperty* DestProperty) const;
+
+	/** Copy the value into a generic that owns it */
+	FGeneric ToGeneric() const;
+
+	/** Decode the value as a type listed in GenericProperties.inl or a reflected struct */
+	template<typename CppType> CppType As() const
+	{
+		CppType Value = CppType();
+		if constexpr (TIsUStruct<CppType>)
+		{
+			GetStruct(CppType::StaticStruct(), &Value);
+		}
+		else
+		{
+			Get(&Value, FGenericPropJunkPrivate::Get(CppType()));
+		}
+		return Value;
+	}
+
+private:
+	bool GetStruct(const UScriptStruct* Struct, void* Dest) const;
+
+	const TCHAR* Text = TEXT("");
+	int32 TextLen = 0;
+	const uint8* PlainData = nullptr;
+	int32 PlainSize = 0;
+	const FProperty* Type = nullptr;
+};
@@ -0,0 +1,35 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "GenericPerfTypes.generated.h"
+
+/** Representative user struct measured by the MaidGame.Generic.Perf suite */
+USTRUCT()
+struct FGenericPerfStruct
+{
+	GENERATED_BODY()
+
+	UPROPERTY() FString Label;
+	UPROPERTY() int32 Count = 0;
+	UPROPERTY() FVector Location = FVector::ZeroVector;
+	UPROPERTY() TArray<FName> Tags;
+};
+
+/**
+ * Reflection host for the container types measured by the MaidGame.Generic.Perf suite
+ * @see FGenericPropJunkPrivate
+ */
+USTRUCT()
+struct FGenericPerfJunkPrivate
+{
+	GENERATED_BODY()
+
+	UPROPERTY() TMap<FName, int32> NameToInt;
+	UPROPERTY() TMap<FString, FVector> StringToVector;
+	UPROPERTY() TSet<FName> NameSet;
+	UPROPERTY() FGenericPerfStruct Struct;
+	UPROPERTY() TArray<FGenericPerfStruct> StructArray;
+};
@@ -0,0 +1,62 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Generic/GenericEvent.h"
+#include "Generic/GenericEventSubsystem.h"
+
+#include "GenericTestTypes.generated.h"
+
+/** Event handler recording what it receives, used by the MaidGame.Generic tests */
+UCLASS()
+class UGenericEventTestHandler : public UObject, public IGenericEventHandler
+{
+	GENERATED_BODY()
+
+public:
+	int32 NumEvents = 0;
+	FName LastEventName;
+	FGeneric LastArgs;
+
+	/** Calls that went through the reflection path, native handlers are expected to bypass it */
+	int32 NumProcessEvents = 0;
+
+	/** Dispatcher the handler unsubscribes itself from when it receives an event */
+	FGenericEventDispatcher* UnsubscribeOnEvent = nullptr;
+
+	virtual FGeneric HandleGenericEvent_Implementation(UObject* Source, FName EventName, const FGeneric& Args) override
+	{
+		++NumEvents;
+		LastEventName = EventName;
+		LastArgs = Args;
+		if (UnsubscribeOnEvent)
+		{
+			UnsubscribeOnEvent->UnsubscribeAll(this);
+		}
+		return FGeneric(NumEvents);
+	}
+
+	virtual void ProcessEvent(UFunction* Function, void* Parms) override
+	{
+		++NumProcessEvents;
+		Super::ProcessEvent(Function, Parms);
+	}
+};
+
+/** Event handler answering requests later, used by the MaidGame.Generic tests */
+UCLASS()
+class UGenericAsyncTestHandler : public UObject, public IGenericEventHandler
+{
+	GENERATED_BODY()
+
+public:
+	FGeneric PendingArgs;
+	FGenericResponder PendingResponder;
+
+	virtual void HandleGenericRequest(UObject* Source, FName EventName, const FGeneric& Args, const FGenericResponder& Responder) override
+	{
+		PendingArgs = Args;
+		PendingResponder = Responder;
+	}
+};
@@ -1,14 +1,34 @@
 ﻿// Copyright Liquid Fish. All Rights Reserved.
 
 #include "Generic/Generic.h"
+#include "Generic/GenericShape.h"
+#include "Generic/GenericInternPool.h"
+#include "Generic/GenericArena.h"
+#include "Generic/GenericDebugUtils.h"
+#include "Generic/GenericEventQueue.h"
+#include "Generic/GenericEventScheduler.h"
+#include "Generic/GenericStatics.h"
+#include "Generic/GenericNested.h"
+#include "Generic/GenericFieldPath.h"
+#include "Generic/GenericObserver.h"
+#include "Generic/GenericTable.h"
+#include "Generic/GenericStream.h"
+#include "GenericTestTypes.h"
 
 #if WITH_DEV_AUTOMATION_TESTS
 
 #include "Misc/AutomationTest.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
 #include "Tests/AutomationCommon.h"
 #include "AlphaBlend.h"
 #include "Animation/AnimationAsset.h"
 #include "Math/UnitConversion.h"
+#include "Async/ParallelFor.h"
+#include "Async/Async.h"
 
 /**
  * Comprehensive test suite for FGeneric container type
@@ -823,6 +843,917 @@ IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenericComprehensiveTest, "MaidGame.Generic",
 		TestEqual(TEXT("UObject* to path string"), ObjectAsString, TransientPackage->GetPathName());
 	}
 
+	// Test 29: Shape-shared Generic Bags
+	{
+		FGenericBag BagA;
+		FGenericBag BagB;
+		BagA.SetValue(TEXT("Health"), 100.f);
+		BagA.SetValue(TEXT("Name"), FString(TEXT("Alice")));
+		BagB.SetValue(TEXT("Health"), 50.f);
+		BagB.SetValue(TEXT("Name"), FString(TEXT("Bob")));
+
+		TestTrue(TEXT("Bags with identical key/type lists share one shape"), BagA.GetShape() == BagB.GetShape());
+		TestEqual(TEXT("Bag key count"), BagA.Num(), 2);
+
+		static const FGenericBagKey HealthKey(TEXT("Health"));
+		const float* HealthA = BagA.FindValue<float>(HealthKey);
+		const float* HealthB = BagB.FindValue<float>(HealthKey);
+		TestTrue(TEXT("Bag typed lookup"), HealthA && HealthB && *HealthA == 100.f && *HealthB == 50.f);
+		TestNull(TEXT("Bag lookup with mismatched type"), BagA.FindValue<int32>(HealthKey));
+
+		// The cached slot belongs to the shape of BagA, a bag with another key order must not use it
+		FGenericBag Reordered;
+		Reordered.SetValue(TEXT("Name"), FString(TEXT("Carol")));
+		Reordered.SetValue(TEXT("Health"), 25.f);
+		const float* HealthReordered = Reordered.FindValue<float>(HealthKey);
+		TestTrue(TEXT("Bag key cache across shapes"), HealthReordered && *HealthReordered == 25.f && *BagA.FindValue<float>(HealthKey) == 100.f);
+		TestEqual(TEXT("Bag string value"), *BagB.FindValue<FString>(TEXT("Name")), FString(TEXT("Bob")));
+
+		// Adding a key transitions to the cached child shape
+		const FGenericShape* ParentShape = BagA.GetShape();
+		BagA.SetValue(TEXT("Level"), 3);
+		BagB.SetValue(TEXT("Level"), 7);
+		TestTrue(TEXT("Transition shapes are shared"), BagA.GetShape() == BagB.GetShape());
+		TestTrue(TEXT("Transition parent"), BagA.GetShape()->GetParent() == ParentShape);
+
+		// Retyping, copying and removing keep values intact
+		FGenericBag BagC = BagA;
+		BagC.SetValue(TEXT("Health"), 75);
+		TestEqual(TEXT("Retyped bag value"), *BagC.FindValue<int32>(HealthKey), 75);
+		TestEqual(TEXT("Retyped bag keeps other values"), *BagC.FindValue<FString>(TEXT("Name")), FString(TEXT("Alice")));
+		TestEqual(TEXT("Copied bag is independent"), *BagA.FindValue<float>(HealthKey), 100.f);
+		TestTrue(TEXT("Bag remove"), BagC.Remove(TEXT("Name")) && !BagC.Contains(TEXT("Name")));
+		TestEqual(TEXT("Bag remove keeps other values"), *BagC.FindValue<int32>(TEXT("Level")), 3);
+
+		BagA.SetGeneric(TEXT("Payload"), FGeneric(FVector(1, 2, 3)));
+		const FGeneric* Payload = BagA.FindGeneric(TEXT("Payload"));
+		TestTrue(TEXT("Bag generic value"), Payload && Payload->As<FVector>() == FVector(1, 2, 3));
+	}
+
+	// Test 30: Content-addressed Payload Interning
+	{
+		IConsoleVariable* InternCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("generic.intern.enabled"));
+		const int32 PreviousValue = InternCVar ? InternCVar->GetInt() : 0;
+		if (InternCVar) InternCVar->Set(1, ECVF_SetByCode);
+
+		const FString SharedText = TEXT("A payload long enough to be worth interning");
+		const FGenericInternPool::FStats Before = FGenericInternPool::Get().GetStats();
+		FGeneric First(SharedText);
+		FGeneric Second(SharedText);
+		TestFalse(TEXT("Assignment does not intern"), First.IsInterned());
+		First.Intern();
+		Second.Intern();
+
+		TestTrue(TEXT("Interned payload"), First.IsInterned() && Second.IsInterned());
+		TestTrue(TEXT("Identical payloads share one buffer"), *First.GetStringData() == *Second.GetStringData());
+		TestTrue(TEXT("Intern pool reports the hit"), FGenericInternPool::Get().GetStats().Hits > Before.Hits);
+		TestEqual(TEXT("Interned value round trip"), Second.As<FString>(), SharedText);
+		TestTrue(TEXT("Interned values compare equal"), First == Second);
+
+		FTransform TestTransform(FRotator(10, 20, 30), FVector(1, 2, 3));
+		FGeneric PlainA(TestTransform);
+		FGeneric PlainB(TestTransform);
+		PlainA.Intern();
+		PlainB.Intern();
+		const FGeneric& ConstPlainA = PlainA;
+		const FGeneric& ConstPlainB = PlainB;
+		TestTrue(TEXT("Identical plain payloads share one buffer"), PlainA.IsInterned() && ConstPlainA.GetPlainData() == ConstPlainB.GetPlainData());
+		static_cast<FTransform*>(PlainB.GetMutablePlainData())->SetLocation(FVector(4, 5, 6));
+		TestFalse(TEXT("Writing plain data detaches from the shared payload"), PlainB.IsInterned());
+		TestTrue(TEXT("Detached write leaves other instances untouched"), PlainA.As<FTransform>().Equals(TestTransform));
+
+		const int32 PayloadsBefore = FGenericInternPool::Get().GetStats().UniquePayloads;
+		{
+			FGeneric Unique(FString(TEXT("A payload no other value holds, released with its last reference")));
+			Unique.Intern();
+			FGeneric Copy = Unique;
+			TestEqual(TEXT("Interning a new payload adds it to the pool"), FGenericInternPool::Get().GetStats().UniquePayloads, PayloadsBefore + 1);
+		}
+		TestEqual(TEXT("The last reference removes the payload from the pool"), FGenericInternPool::Get().GetStats().UniquePayloads, PayloadsBefore);
+
+		if (InternCVar) InternCVar->Set(PreviousValue, ECVF_SetByCode);
+	}
+
+	// Test 31: Arena-scoped Transient Values
+	{
+		const TArray<FString> TestStrings{ TEXT("Alpha"), TEXT("Beta"), TEXT("Gamma") };
+		FGeneric Escaped;
+		FGeneric Promoted;
+		const FProperty* StringsProp = nullptr;
+		{
+			FGenericArenaScope ArenaScope;
+			FGeneric Transient(TestStrings);
+			StringsProp = Transient.GetValueProperty();
+			TestTrue(TEXT("Arena backs the value cache"), FGenericArena::GetActive() && FGenericArena::GetActive()->GetUsedBytes() > 0);
+			TestEqual(TEXT("Arena-scoped value"), Transient.As<TArray<FString>>(), TestStrings);
+
+			Escaped = TestStrings;
+			const SIZE_T UsedBeforeCopy = FGenericArena::GetActive()->GetUsedBytes();
+			Promoted = Transient;
+			TestEqual(TEXT("Copy inside the scope takes no arena storage"), (int64)FGenericArena::GetActive()->GetUsedBytes(), (int64)UsedBeforeCopy);
+		}
+		TestNull(TEXT("Arena inactive after scope"), FGenericArena::GetActive());
+#if GENERIC_USING_CACHE
+		TestNotNull(TEXT("Copy keeps its cache promoted to the heap"), Promoted.FindCachedValue(StringsProp));
+		TestNull(TEXT("Value outliving its scope drops its arena cache"), Escaped.FindCachedValue(StringsProp));
+#endif
+		TestEqual(TEXT("Value outliving its arena scope"), Escaped.As<TArray<FString>>(), TestStrings);
+		TestEqual(TEXT("Copied value outliving its arena scope"), Promoted.As<TArray<FString>>(), TestStrings);
+
+		FGeneric Reassigned;
+		{
+			FGenericArenaScope ArenaScope;
+			Reassigned = FString(TEXT("Inside"));
+		}
+		Reassigned = FString(TEXT("Outside"));
+		TestEqual(TEXT("Reassigning after the arena scope"), Reassigned.As<FString>(), FString(TEXT("Outside")));
+	}
+
+	// Test 32: Same-type Overwrite
+	{
+		FGeneric Tracked = FVector(1, 2, 3);
+		const FGeneric& ConstTracked = Tracked;
+		const void* PlainBefore = ConstTracked.GetPlainData();
+		Tracked = FVector(4, 5, 6);
+		TestTrue(TEXT("Same-type plain overwrite keeps storage"), ConstTracked.GetPlainData() == PlainBefore);
+		TestEqual(TEXT("Same-type plain overwrite value"), Tracked.As<FVector>(), FVector(4, 5, 6));
+
+		FGeneric Counter = 1;
+		Counter = 2;
+		TestEqual(TEXT("Same-type integral overwrite"), Counter.As<int32>(), 2);
+		Counter = 3.5f;
+		TestEqual(TEXT("Type change after overwrite"), Counter.As<float>(), 3.5f);
+
+		FGeneric Label = FString(TEXT("A fairly long initial label"));
+		const TCHAR* TextBefore = *Label.GetStringData();
+		Label = FString(TEXT("Short label"));
+		TestTrue(TEXT("Same-type text overwrite keeps buffer"), *Label.GetStringData() == TextBefore);
+		TestEqual(TEXT("Same-type text overwrite value"), Label.As<FString>(), FString(TEXT("Short label")));
+		Label = FName(TEXT("NameValue"));
+		TestEqual(TEXT("Type change after text overwrite"), Label.As<FName>(), FName(TEXT("NameValue")));
+
+		// Types are compared, not property addresses, so another property of the same type overwrites too
+		FHitResult Hit;
+		Hit.BoneName = TEXT("A_Fairly_Long_Bone_Name");
+		Hit.MyBoneName = TEXT("Short_Bone");
+		const FProperty* BoneNameProp = FHitResult::StaticStruct()->FindPropertyByName(GET_MEMBER_NAME_CHECKED(FHitResult, BoneName));
+		const FProperty* MyBoneNameProp = FHitResult::StaticStruct()->FindPropertyByName(GET_MEMBER_NAME_CHECKED(FHitResult, MyBoneName));
+		FGeneric Bone;
+		Bone.Set(&Hit.BoneName, BoneNameProp);
+		TestTrue(TEXT("Property of a compiled-in type is kept"), Bone.GetValueProperty() == BoneNameProp);
+		const TCHAR* BoneTextBefore = *Bone.GetStringData();
+		Bone.Set(&Hit.MyBoneName, MyBoneNameProp);
+		TestTrue(TEXT("Same type through another property keeps buffer"), *Bone.GetStringData() == BoneTextBefore);
+		TestEqual(TEXT("Same type through another property value"), Bone.As<FName>(), Hit.MyBoneName);
+	}
+
+	// Test 33: Allocated Size Reporting
+	{
+		FGeneric Empty;
+		TestEqual(TEXT("Empty value owns no heap memory"), (int64)Empty.GetAllocatedSize(), (int64)0);
+
+		FGeneric Small = FVector(1, 2, 3);
+		TestTrue(TEXT("Plain value owns its bytes"), Small.GetAllocatedSize() >= sizeof(FVector));
+
+		TArray<FString> ManyStrings;
+		for (int32 i = 0; i < 64; ++i)
+		{
+			ManyStrings.Add(FString::Printf(TEXT("Element_%d"), i));
+		}
+		FGeneric Large(ManyStrings);
+		TestTrue(TEXT("Text value owns more than a plain value"), Large.GetAllocatedSize() > Small.GetAllocatedSize());
+
+		Large.Clear();
+		TestTrue(TEXT("Cleared value is empty"), Large.IsEmpty());
+	}
+
+	// Test 34: Interned Editor Pin Types
+#if WITH_EDITORONLY_DATA
+	{
+		FGeneric First = FVector(1, 2, 3);
+		FGeneric Third = FString(TEXT("Text"));
+		const int32 InternedBefore = FGenericPinTypeHandle::GetNumInterned();
+		FGeneric Second = FVector(4, 5, 6);
+		Third = FVector(7, 8, 9);
+
+		TestTrue(TEXT("Pin type is set"), First.IsValidPinType());
+		TestTrue(TEXT("Values of one type share a pin type entry"), &First.GetEditPinType() == &Second.GetEditPinType());
+		TestTrue(TEXT("Retyped value shares the pin type entry"), &First.GetEditPinType() == &Third.GetEditPinType());
+		TestEqual(TEXT("No pin type interned for a known type"), FGenericPinTypeHandle::GetNumInterned(), InternedBefore);
+
+		FEdGraphPinType PinType = First.GetEditPinType();
+		FGeneric Restored;
+		Restored.SetEditPinType(PinType);
+		TestTrue(TEXT("Pin type round trip through the table"), Restored.GetEditPinType() == PinType);
+
+		First.Clear();
+		TestFalse(TEXT("Cleared value has no pin type"), First.IsValidPinType());
+	}
+#endif
+
+	// Test 35: Allocation Counting
+#if GENERIC_ALLOC_TRACKING
+	{
+		FGeneric Tracked;
+		FGenericAllocCounts Before = FGeneric::GetThreadAllocCounts();
+		Tracked = FVector(1, 2, 3);
+		TestEqual(TEXT("First plain Set allocates its buffer"), (FGeneric::GetThreadAllocCounts() - Before).Set, 1);
+
+		Before = FGeneric::GetThreadAllocCounts();
+		for (int32 i = 0; i < 100; ++i)
+		{
+			Tracked = FVector(i, i, i);
+		}
+		Tracked = 3.0f;
+		Tracked = 4.0f;
+		TestEqual(TEXT("Plain Set reusing storage makes no allocations"), (FGeneric::GetThreadAllocCounts() - Before).Set, 0);
+
+		FGeneric Source = FVector(5, 6, 7);
+		Before = FGeneric::GetThreadAllocCounts();
+		TestEqual(TEXT("Tracked value round trip"), Source.As<FVector>(), FVector(5, 6, 7));
+		FGeneric Copied(Source);
+		FGeneric Moved(MoveTemp(Copied));
+		const FGenericAllocCounts Delta = FGeneric::GetThreadAllocCounts() - Before;
+		TestEqual(TEXT("Get makes no allocations"), Delta.Get, 0);
+		TestEqual(TEXT("Plain copy allocates one buffer"), Delta.Copy, 1);
+		TestEqual(TEXT("Move makes no allocations"), Delta.Move, 0);
+	}
+#endif
+
+	// Test 36: Per-type Statistics
+#if GENERIC_STATS_ENABLED
+	{
+		const bool bWasEnabled = FGenericStats::IsEnabled();
+		FGenericStats::SetEnabled(true);
+		FGenericStats::Reset();
+
+		FGeneric Counted = FString(TEXT("Counted"));
+		Counted = FString(TEXT("Counted again"));
+		TestEqual(TEXT("Counted value round trip"), Counted.As<FString>(), FString(TEXT("Counted again")));
+		FGeneric CountedInt = 42;
+		FGenericStats::SetEnabled(bWasEnabled);
+
+		const TArray<FGenericTypeStats> Stats = FGenericStats::GetSnapshot();
+		const FGenericTypeStats* StringStats = Stats.FindByPredicate([](const FGenericTypeStats& Entry) { return Entry.TypeName == TEXT("FString"); });
+		const FGenericTypeStats* IntStats = Stats.FindByPredicate([](const FGenericTypeStats& Entry) { return Entry.TypeName == TEXT("int32"); });
+		TestTrue(TEXT("String stats recorded"), StringStats != nullptr);
+		TestTrue(TEXT("Int stats recorded"), IntStats != nullptr);
+		if (StringStats && IntStats)
+		{
+			TestTrue(TEXT("String Sets counted"), StringStats->Sets >= 2);
+			TestTrue(TEXT("String Gets counted"), StringStats->Gets >= 1);
+			TestTrue(TEXT("String bytes stored"), StringStats->BytesStored > 0);
+			TestTrue(TEXT("Int Sets counted"), IntStats->Sets >= 1);
+		}
+		TestTrue(TEXT("Stats CSV has a header"), FGenericStats::ToCSV(Stats).StartsWith(TEXT("Type,Sets,Gets")));
+	}
+#endif
+
+	// Test 37: Type-aware Formatting
+	{
+		TStringBuilder<256> Formatted;
+		FormatGenericValue(Formatted, FGeneric(FVector(1, 2, 3)));
+		TestEqual(TEXT("Struct formatted as text"), FString(Formatted.ToString()), FString(TEXT("(X=1,Y=2,Z=3)")));
+
+		FGenericFormatOptions Json;
+		Json.Style = EGenericFormatStyle::Json;
+		Formatted.Reset();
+		FormatGenericValue(Formatted, FGeneric(FVector(1, 2, 3)), Json);
+		TestEqual(TEXT("Struct formatted as JSON"), FString(Formatted.ToString()), FString(TEXT("{\"X\":1,\"Y\":2,\"Z\":3}")));
+
+		TArray<int32> Numbers;
+		for (int32 i = 0; i < 10; ++i) Numbers.Add(i);
+		FGenericFormatOptions Truncated;
+		Truncated.MaxElements = 3;
+		Formatted.Reset();
+		FormatGenericValue(Formatted, FGeneric(Numbers), Truncated);
+		TestEqual(TEXT("Large array truncated"), FString(Formatted.ToString()), FString(TEXT("[0, 1, 2, +7 more]")));
+
+		Formatted.Reset();
+		FormatGenericValue(Formatted, FGeneric(FString(TEXT("Say \"hi\""))), Json);
+		TestEqual(TEXT("String escaped"), FString(Formatted.ToString()), FString(TEXT("\"Say \\\"hi\\\"\"")));
+
+		FGenericFormatOptions Short;
+		Short.MaxLength = 8;
+		Formatted.Reset();
+		FormatGenericValue(Formatted, FGeneric(FString::ChrN(100, TEXT('a'))), Short);
+		TestTrue(TEXT("Output bounded"), Formatted.Len() <= Short.MaxLength + 4 && FString(Formatted.ToString()).EndsWith(TEXT("...")));
+	}
+
+	// Test 38: Event Dispatch
+	{
+		FGenericEventDispatcher Dispatcher;
+		UGenericEventTestHandler* First = NewObject<UGenericEventTestHandler>();
+		UGenericEventTestHandler* Second = NewObject<UGenericEventTestHandler>();
+		UGenericEventTestHandler* Wildcard = NewObject<UGenericEventTestHandler>();
+
+		AddExpectedError(TEXT("does not implement GenericEventHandler"), EAutomationExpectedErrorFlags::Contains, 1);
+		TestFalse(TEXT("Non-handler rejected"), Dispatcher.Subscribe(TEXT("Damage"), GetTransientPackage()));
+		TestTrue(TEXT("Handler subscribed"), Dispatcher.Subscribe(TEXT("Damage"), First));
+		Dispatcher.Subscribe(TEXT("Damage"), First);
+		Dispatcher.Subscribe(TEXT("Damage"), Second);
+		Dispatcher.Subscribe(NAME_None, Wildcard);
+		TestEqual(TEXT("Duplicate subscription ignored"), Dispatcher.GetNumSubscribers(TEXT("Damage")), 2);
+
+		TestEqual(TEXT("Broadcast reaches named and wildcard subscribers"), Dispatcher.Broadcast(nullptr, TEXT("Damage"), FGeneric(5)), 3);
+		TestEqual(TEXT("Handler received args"), First->LastArgs.As<int32>(), 5);
+		TestEqual(TEXT("Wildcard received event name"), Wildcard->LastEventName, FName(TEXT("Damage")));
+		TestEqual(TEXT("Unrelated event only reaches wildcard"), Dispatcher.Broadcast(nullptr, TEXT("Heal"), FGeneric::Null), 1);
+
+		Second->UnsubscribeOnEvent = &Dispatcher;
+		TestEqual(TEXT("Unsubscribing during dispatch keeps the current event"), Dispatcher.Broadcast(nullptr, TEXT("Damage"), FGeneric(1)), 3);
+		TestEqual(TEXT("Unsubscribed handler skipped afterwards"), Dispatcher.Broadcast(nullptr, TEXT("Damage"), FGeneric(2)), 2);
+		TestEqual(TEXT("Unsubscribed handler removed"), Dispatcher.GetNumSubscribers(TEXT("Damage")), 1);
+
+		Second->UnsubscribeOnEvent = nullptr;
+		const int32 NumBefore = Second->NumEvents;
+		TestEqual(TEXT("Send reaches an unsubscribed handler"), FGenericEventDispatcher::Send(Second, nullptr, TEXT("Direct"), FGeneric::Null).As<int32>(), NumBefore + 1);
+	}
+
+	// Test 39: Native Event Handlers
+	{
+		FGenericEventDispatcher Dispatcher;
+		TestFalse(TEXT("Native handler class has no Blueprint override"), FGenericEventDispatcher::HasBlueprintOverride(UGenericEventTestHandler::StaticClass()));
+
+		int32 NativeCalls = 0;
+		int32 LastValue = 0;
+		const FDelegateHandle Handle = Dispatcher.SubscribeNative(TEXT("Score"), FGenericEventDelegate::CreateLambda(
+			[&NativeCalls, &LastValue](UObject* Source, FName EventName, const FGeneric& Args)
+			{
+				++NativeCalls;
+				LastValue = Args.As<int32>();
+			}));
+		TestTrue(TEXT("Native subscription returns a handle"), Handle.IsValid());
+
+		UGenericEventTestHandler* Handler = NewObject<UGenericEventTestHandler>();
+		Dispatcher.Subscribe(TEXT("Score"), Handler);
+		TestEqual(TEXT("Delegates and objects are both invoked"), Dispatcher.Broadcast(nullptr, TEXT("Score"), FGeneric(7)), 2);
+		TestEqual(TEXT("Delegate received args by reference"), LastValue, 7);
+		TestEqual(TEXT("Native object handler invoked directly"), Handler->LastArgs.As<int32>(), 7);
+		TestEqual(TEXT("Native object handler bypasses ProcessEvent"), Handler->NumProcessEvents, 0);
+
+		Dispatcher.UnsubscribeNative(TEXT("Score"), Handle);
+		Dispatcher.Broadcast(nullptr, TEXT("Score"), FGeneric(8));
+		TestEqual(TEXT("Unsubscribed delegate not invoked"), NativeCalls, 1);
+		TestEqual(TEXT("Only the object handler remains"), Dispatcher.GetNumSubscribers(TEXT("Score")), 1);
+	}
+
+	// Test 40: Multi-producer Event Queue
+	{
+		FGenericEventQueue Queue(4);
+		TestEqual(TEXT("Capacity rounded to a power of two"), Queue.GetCapacity(), 4);
+		for (int32 i = 0; i < 6; ++i)
+		{
+			Queue.EnqueueBroadcast(nullptr, TEXT("Tick"), FGeneric(i));
+		}
+		TestEqual(TEXT("Full ring spills into overflow"), Queue.GetStats().Overflowed, (int64)2);
+		TestEqual(TEXT("Queued events counted"), Queue.Num(), 6);
+
+		TArray<int32> Received;
+		auto Collect = [&Received](const FGenericQueuedEvent& Event) { Received.Add(Event.Args.As<int32>()); };
+		TestEqual(TEXT("Drain respects the batch size"), Queue.Drain(3, Collect), 3);
+		TestEqual(TEXT("Drain delivers the rest"), Queue.Drain(0, Collect), 3);
+		TestEqual(TEXT("Single producer order kept"), Received, TArray<int32>({ 0, 1, 2, 3, 4, 5 }));
+
+		// A handler draining again gets the events after its own, never its own a second time
+		Received.Reset();
+		for (int32 i = 0; i < 3; ++i)
+		{
+			Queue.EnqueueBroadcast(nullptr, TEXT("Tick"), FGeneric(i));
+		}
+		TFunction<void(const FGenericQueuedEvent&)> Reentrant = [&Received, &Queue, &Reentrant](const FGenericQueuedEvent& Event)
+		{
+			Received.Add(Event.Args.As<int32>());
+			Queue.Drain(1, Reentrant);
+		};
+		Queue.Drain(1, Reentrant);
+		TestEqual(TEXT("Re-entrant drain delivers each event once"), Received, TArray<int32>({ 0, 1, 2 }));
+
+		FGenericEventQueue Shared(256);
+		std::atomic<int64> Expected{ 0 };
+		ParallelFor(1000, [&Shared, &Expected](int32 Index)
+			{
+				Shared.EnqueueSend(nullptr, nullptr, TEXT("Work"), FGeneric(Index));
+				Expected.fetch_add(Index);
+			});
+		int64 Sum = 0;
+		const int32 NumDrained = Shared.Drain(0, [&Sum](const FGenericQueuedEvent& Event) { Sum += Event.Args.As<int32>(); });
+		TestEqual(TEXT("Every concurrent event delivered once"), NumDrained, 1000);
+		TestEqual(TEXT("Concurrent payloads intact"), Sum, Expected.load());
+
+		Shared.EnqueueSend(nullptr, nullptr, TEXT("Pending"), FGeneric(1));
+		Shared.Close();
+		Shared.EnqueueSend(nullptr, nullptr, TEXT("Late"), FGeneric(2));
+		TestTrue(TEXT("Closed queue"), Shared.IsClosed());
+		TestEqual(TEXT("Closed queue drops pending and late events"), Shared.Num(), 0);
+	}
+
+	// Test 41: Scheduled Events on the Timing Wheel
+	{
+		FGenericEventScheduler Scheduler(0.25f);
+		TArray<FName> Fired;
+		auto Collect = [&Fired](const FGenericQueuedEvent& Event) { Fired.Add(Event.EventName); };
+
+		Scheduler.Schedule(1.0f, nullptr, nullptr, TEXT("Near"), FGeneric(1));
+		Scheduler.Schedule(100.0f, nullptr, nullptr, TEXT("Far"), FGeneric(2));
+		Scheduler.Schedule(20000.0f, nullptr, nullptr, TEXT("VeryFar"), FGeneric(3), true);
+		FGenericEventTimerHandle Cancelled = Scheduler.Schedule(2.0f, nullptr, nullptr, TEXT("Cancelled"), FGeneric(4));
+		TestEqual(TEXT("Pending events counted"), Scheduler.Num(), 4);
+		TestTrue(TEXT("Cancel pending event"), Scheduler.Cancel(Cancelled));
+		TestFalse(TEXT("Cancel twice"), Scheduler.Cancel(Cancelled));
+		TestFalse(TEXT("Cancelled handle no longer scheduled"), Scheduler.IsScheduled(Cancelled));
+
+		TestEqual(TEXT("Nothing due before the delay"), Scheduler.Advance(0.75f, Collect), 0);
+		TestEqual(TEXT("Due at the delay"), Scheduler.Advance(0.25f, Collect), 1);
+		TestEqual(TEXT("Cascaded from the second wheel"), Scheduler.Advance(99.0f, Collect), 1);
+		TestEqual(TEXT("Cascaded from the third wheel"), Scheduler.Advance(19900.0f, Collect), 1);
+		TestEqual(TEXT("Fired in deadline order"), Fired, TArray<FName>({ TEXT("Near"), TEXT("Far"), TEXT("VeryFar") }));
+		TestEqual(TEXT("No event left"), Scheduler.Num(), 0);
+
+		// Handlers cancel events of their own batch and schedule new ones
+		FGenericEventTimerHandle Second;
+		int32 NumDelivered = 0;
+		auto Deliver = [&](const FGenericQueuedEvent& Event)
+			{
+				++NumDelivered;
+				if (Event.EventName == TEXT("First"))
+				{
+					Scheduler.Cancel(Second);
+					Scheduler.Schedule(0.25f, nullptr, nullptr, TEXT("Follow"), Event.Args);
+				}
+			};
+		Scheduler.Schedule(0.5f, nullptr, nullptr, TEXT("First"), FGeneric(5));
+		Second = Scheduler.Schedule(0.5f, nullptr, nullptr, TEXT("Second"), FGeneric(6));
+		Scheduler.Schedule(0.5f, nullptr, nullptr, TEXT("First"), FGeneric(7));
+		TestEqual(TEXT("Cancelled within its batch"), Scheduler.Advance(0.5f, Deliver), 2);
+		TestEqual(TEXT("Rescheduled from a handler"), Scheduler.Num(), 2);
+		TestEqual(TEXT("Follow-up events fired"), Scheduler.Advance(0.25f, Deliver), 2);
+		TestEqual(TEXT("Every delivered event counted"), NumDelivered, 4);
+	}
+
+	// Test 42: Parallel Broadcast to Thread-safe Handlers
+	{
+		FGenericEventDispatcher Dispatcher;
+		TArray<UGenericEventTestHandler*> Handlers;
+		for (int32 i = 0; i < 200; ++i)
+		{
+			UGenericEventTestHandler* Handler = Handlers.Add_GetRef(NewObject<UGenericEventTestHandler>());
+			Dispatcher.Subscribe(TEXT("Process"), Handler, true);
+		}
+		UGenericEventTestHandler* GameThreadHandler = NewObject<UGenericEventTestHandler>();
+		Dispatcher.Subscribe(TEXT("Process"), GameThreadHandler);
+		int32 DelegateCalls = 0;
+		Dispatcher.SubscribeNative(TEXT("Process"), FGenericEventDelegate::CreateLambda(
+			[&DelegateCalls](UObject* Source, FName EventName, const FGeneric& Args) { ++DelegateCalls; }));
+
+		TArray<FGenericEventResult> Results;
+		TestEqual(TEXT("Every handler invoked"), Dispatcher.BroadcastParallel(nullptr, TEXT("Process"), FGeneric(FString(TEXT("Payload"))), &Results), 202);
+		TestEqual(TEXT("One result per object handler"), Results.Num(), 201);
+		TestTrue(TEXT("Game thread handler result last"), Results.Last().Handler == GameThreadHandler);
+		TestEqual(TEXT("Delegate called on the game thread"), DelegateCalls, 1);
+
+		bool bAllReceived = true;
+		for (int32 i = 0; i < Handlers.Num(); ++i)
+		{
+			bAllReceived &= Handlers[i]->NumEvents == 1 && Handlers[i]->LastArgs.As<FString>() == TEXT("Payload");
+			bAllReceived &= Results[i].Handler == Handlers[i] && Results[i].Value.As<int32>() == 1;
+		}
+		TestTrue(TEXT("Thread-safe handlers received the shared args once"), bAllReceived);
+
+		Dispatcher.Broadcast(nullptr, TEXT("Process"), FGeneric::Null);
+		TestEqual(TEXT("Plain broadcast still calls thread-safe handlers"), Handlers[0]->NumEvents, 2);
+	}
+
+	// Test 43: Asynchronous Requests
+	{
+		UGenericEventTestHandler* SyncHandler = NewObject<UGenericEventTestHandler>();
+		UGenericAsyncTestHandler* AsyncHandler = NewObject<UGenericAsyncTestHandler>();
+
+		TFuture<FGeneric> Immediate = FGenericEventDispatcher::Request(SyncHandler, nullptr, TEXT("Query"), FGeneric(1));
+		TestTrue(TEXT("Synchronous handler answers at once"), Immediate.IsReady() && Immediate.Get().As<int32>() == 1);
+
+		TFuture<FGeneric> Later = FGenericEventDispatcher::Request(AsyncHandler, nullptr, TEXT("Query"), FGeneric(2));
+		TestFalse(TEXT("Request pending until answered"), Later.IsReady());
+		TestEqual(TEXT("Handler copied the args"), AsyncHandler->PendingArgs.As<int32>(), 2);
+		TestTrue(TEXT("Answer completes the request"), AsyncHandler->PendingResponder.Complete(FGeneric(42)));
+		TestFalse(TEXT("Only the first answer counts"), AsyncHandler->PendingResponder.Complete(FGeneric(43)));
+		TestTrue(TEXT("Answer received"), Later.IsReady() && Later.Get().As<int32>() == 42);
+
+		TFuture<FGeneric> Dropped = FGenericEventDispatcher::Request(AsyncHandler, nullptr, TEXT("Query"), FGeneric(3));
+		AsyncHandler->PendingResponder.Reset();
+		TestTrue(TEXT("Dropped request completes with Null"), Dropped.IsReady() && Dropped.Get().IsEmpty());
+
+		FGenericEventDispatcher Dispatcher;
+		Dispatcher.Subscribe(TEXT("Query"), SyncHandler);
+		Dispatcher.Subscribe(TEXT("Query"), AsyncHandler);
+		Dispatcher.Subscribe(NAME_None, SyncHandler);
+		TFuture<TArray<FGeneric>> All = Dispatcher.RequestAll(nullptr, TEXT("Query"), FGeneric(4));
+		TestFalse(TEXT("Fan-out waits for every handler"), All.IsReady());
+
+		FGenericResponder Responder = AsyncHandler->PendingResponder;
+		AsyncHandler->PendingResponder.Reset();
+		Async(EAsyncExecution::ThreadPool, [Responder]() { Responder.Complete(FGeneric(FString(TEXT("Async")))); }).Wait();
+		TestTrue(TEXT("Fan-out completes from a worker answer"), All.IsReady());
+		const TArray<FGeneric>& Answers = All.Get();
+		TestEqual(TEXT("One answer per handler"), Answers.Num(), 3);
+		TestEqual(TEXT("Answers in subscription order"), Answers[1].As<FString>(), FString(TEXT("Async")));
+	}
+
+	// Test 44: Packed Argument Lists
+	{
+		UGenericEventTestHandler* Instigator = NewObject<UGenericEventTestHandler>();
+		FGenericArgs Args = FGenericArgs::Make(7, 2.5f, FString(TEXT("Hello")));
+		Args.Add(TEXT("Damage"), 12.5).Add(TEXT("Instigator"), Instigator).Add(TEXT("Where"), FVector(1, 2, 3));
+		TestEqual(TEXT("Args count"), Args.Num(), 6);
+		TestEqual(TEXT("Positional int"), Args.Get<int32>(0), 7);
+		TestEqual(TEXT("Positional string"), Args.Get<FString>(2), FString(TEXT("Hello")));
+		TestEqual(TEXT("Named double"), Args.Get<double>(TEXT("Damage")), 12.5);
+		TestEqual(TEXT("Numeric conversion"), Args.Get<int32>(TEXT("Damage")), 12);
+		TestTrue(TEXT("Named object"), Args.Get<UGenericEventTestHandler*>(TEXT("Instigator")) == Instigator);
+		TestEqual(TEXT("Named vector"), Args.Get<FVector>(TEXT("Where")), FVector(1, 2, 3));
+		TestEqual(TEXT("Missing name reads default"), Args.Get<int32>(TEXT("Missing")), 0);
+		TestEqual(TEXT("Arg type"), Args.View().GetType(1), EGenericArgType::Float);
+
+		FGeneric Payload(Args);
+		TestTrue(TEXT("Args stored as plain data"), Payload.GetStringData().IsEmpty() && Payload.GetPlainSize() == Args.GetBuffer().Num());
+		FGenericArgsView View(Payload);
+		TestEqual(TEXT("View reads the payload in place"), View.Get<FString>(2), FString(TEXT("Hello")));
+		TestEqual(TEXT("View finds named args"), View.IndexOf(TEXT("Where")), 5);
+		TestTrue(TEXT("Args round-trip through FGeneric"), Payload.As<FGenericArgs>() == Args);
+		TestTrue(TEXT("Copied payload keeps the args"), FGeneric(Payload).As<FGenericArgs>() == Args);
+
+		TestEqual(TEXT("View of other payload is empty"), FGenericArgsView(FGeneric(5)).Num(), 0);
+		const uint8 Garbage[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+		FGenericArgs Invalid;
+		Invalid.SetBuffer(Garbage, sizeof(Garbage));
+		TestEqual(TEXT("Invalid buffer reads as empty"), Invalid.Num(), 0);
+
+		FGenericArgs Blueprint;
+		UGenericStatics::AddArgInt(Blueprint, NAME_None, 3);
+		UGenericStatics::AddArgName(Blueprint, TEXT("Tag"), TEXT("Fire"));
+		TestEqual(TEXT("Blueprint read by index"), UGenericStatics::GetArgAsInt(Blueprint, NAME_None, 0), 3);
+		TestEqual(TEXT("Blueprint read by name"), UGenericStatics::GetArgAsString(Blueprint, TEXT("Tag"), 0), FString(TEXT("Fire")));
+		TestTrue(TEXT("Blueprint conversion"), UGenericStatics::GenericToArgs(UGenericStatics::ArgsToGeneric(Blueprint)) == Blueprint);
+	}
+
+	// Test 45: Nested Generics
+	{
+		TArray<FGeneric> Inner = { FGeneric(1), FGeneric(FString(TEXT("Two \"quoted\""))), FGeneric(FVector(1, 2, 3)) };
+		FGeneric Outer(Inner);
+		TestTrue(TEXT("Nested generics stored without text"), Outer.GetStringData().IsEmpty());
+		TArray<FGeneric> Decoded = Outer.As<TArray<FGeneric>>();
+		TestEqual(TEXT("Nested count"), Decoded.Num(), 3);
+		TestTrue(TEXT("Nested values round-trip"), Decoded == Inner);
+
+		FGenericNestedView View(Outer);
+		TestEqual(TEXT("View count"), View.Num(), 3);
+		TestEqual(TEXT("View decodes one element"), View.Get(1).As<FString>(), FString(TEXT("Two \"quoted\"")));
+		TestTrue(TEXT("Out of range reads Null"), View.Get(3).IsEmpty());
+
+		// Each level adds a record header, not a layer of escaping
+		FGeneric Deep = FGeneric::MakeNested(Outer);
+		const int32 FirstLevel = Deep.GetPlainSize() - Outer.GetPlainSize();
+		for (int32 Level = 0; Level < 8; ++Level)
+		{
+			Deep = FGeneric::MakeNested(Deep);
+		}
+		TestEqual(TEXT("Payload grows linearly with depth"), Deep.GetPlainSize(), Outer.GetPlainSize() + FirstLevel * 9);
+
+		FGeneric Unwrapped = Deep;
+		for (int32 Level = 0; Level < 9; ++Level)
+		{
+			TestEqual(TEXT("Each level holds one value"), FGenericNestedView(Unwrapped).Num(), 1);
+			Unwrapped = Unwrapped.As<FGeneric>();
+		}
+		TestTrue(TEXT("Innermost value unwrapped"), Unwrapped == Outer);
+
+		const FGeneric Wrapped = FGeneric::MakeNested(Outer);
+		FGenericNestedView Lazy = FGenericNestedView(Wrapped).GetNested(0);
+		TestEqual(TEXT("Inner records viewed without decoding"), Lazy.Get(2).As<FVector>(), FVector(1, 2, 3));
+
+		TestEqual(TEXT("Plain value holds no nested generics"), FGenericNestedView(FGeneric(5)).Num(), 0);
+		TestEqual(TEXT("Empty array nests"), FGeneric(TArray<FGeneric>()).As<TArray<FGeneric>>().Num(), 0);
+		TestEqual(TEXT("Blueprint nested count"), UGenericStatics::GetNumNested(Outer), 3);
+		TestEqual(TEXT("Blueprint nested element"), UGenericStatics::GetNestedAt(Outer, 0).As<int32>(), 1);
+	}
+
+	// Test 46: Compiled Field Paths
+	{
+		const FGenericFieldPath TranslationX = FGenericFieldPath::Find(TBaseStructure<FTransform>::Get(), TEXT("Translation.X"));
+		TestTrue(TEXT("Path resolved"), TranslationX.IsValid());
+		TestEqual(TEXT("Path chain"), TranslationX.GetChain().Num(), 2);
+		TestFalse(TEXT("Unknown member"), FGenericFieldPath(TBaseStructure<FTransform>::Get(), TEXT("Translation.W")).IsValid());
+		TestFalse(TEXT("Member of a non-struct"), FGenericFieldPath(TBaseStructure<FTransform>::Get(), TEXT("Translation.X.Y")).IsValid());
+
+		// Plain struct, read and patched in the stored bytes
+		FGeneric Transform = FTransform(FRotator::ZeroRotator, FVector(1, 2, 3));
+		TestEqual(TEXT("Plain field read"), Transform.GetField<float>(TranslationX), 1.0f);
+		TestTrue(TEXT("Plain field write"), Transform.SetField(TranslationX, 10.0f));
+		TestEqual(TEXT("Plain field written in place"), Transform.As<FTransform>().GetTranslation(), FVector(10, 2, 3));
+		TestFalse(TEXT("Field of another type"), Transform.SetField(TranslationX, FString(TEXT("X"))));
+		TestFalse(TEXT("Path into another struct"), FGeneric(FVector(1, 2, 3)).SetField(TranslationX, 1.0f));
+
+		// Text payload, decoded into a temporary. Set would cache the decoded struct, a loaded value has no cache
+		FHitResult Hit;
+		Hit.Distance = 5.0f;
+		Hit.Location = FVector(4, 5, 6);
+		const FGeneric HitSource(Hit);
+		TArray<uint8> HitBytes;
+		{
+			FMemoryWriter Ar(HitBytes);
+			FGenericStreamWriter Writer(Ar);
+			Writer.Add(HitSource);
+			Writer.Close();
+		}
+		FGeneric HitGeneric;
+		{
+			FMemoryReader Ar(HitBytes);
+			FGenericStreamReader Reader(Ar);
+			TestTrue(TEXT("Text value loaded"), Reader.Next(HitGeneric));
+		}
+		TestNull(TEXT("Loaded value has no decoded cache"), HitGeneric.FindCachedValue(HitSource.GetValueProperty()));
+		const FGenericFieldPath Distance = FGenericFieldPath::Find(FHitResult::StaticStruct(), TEXT("Distance"));
+		const FGenericFieldPath LocationY = FGenericFieldPath::Find(FHitResult::StaticStruct(), TEXT("Location.Y"));
+		TestEqual(TEXT("Text field read"), HitGeneric.GetField<float>(Distance), 5.0f);
+		TestEqual(TEXT("Inherited member read"), HitGeneric.GetField<int32>(LocationY), 5);
+		TestNull(TEXT("Field reads leave no cache"), HitGeneric.FindCachedValue(HitSource.GetValueProperty()));
+		TestTrue(TEXT("Text field write"), HitGeneric.SetField(Distance, 42.0f));
+		TestEqual(TEXT("Text field written"), HitGeneric.As<FHitResult>().Distance, 42.0f);
+		TestEqual(TEXT("Other fields kept"), HitGeneric.As<FHitResult>().Location, FVector(4, 5, 6));
+		TestEqual(TEXT("Cached path"), FGenericFieldPath::Find(FHitResult::StaticStruct(), TEXT("Distance")).GetOffset(), Distance.GetOffset());
+	}
+
+	// Test 47: Patches between Values
+	{
+		FTransform Before(FRotator(10, 20, 30), FVector(1, 2, 3), FVector(1, 1, 1));
+		FTransform After = Before;
+		After.SetTranslation(FVector(1, 2, 30));
+		const FGeneric From(Before);
+		const FGeneric To(After);
+
+		FGenericPatch Patch = FGenericPatch::Diff(From, To);
+		TestFalse(TEXT("Patch records the change"), Patch.IsEmpty());
+		TestTrue(TEXT("Patch smaller than the value"), Patch.GetPayloadSize() < To.GetPlainSize());
+		FGeneric Replica = From;
+		TestTrue(TEXT("Patch applies to its base"), Patch.Apply(Replica));
+		TestTrue(TEXT("Patched plain value"), Replica == To);
+		TestFalse(TEXT("Patch refuses another value"), Patch.Apply(Replica));
+		TestTrue(TEXT("Refused target unchanged"), Replica == To);
+		TestTrue(TEXT("Equal values make an empty patch"), FGenericPatch::Diff(To, To).IsEmpty());
+
+		const FGeneric Long(FString(TEXT("The quick brown fox jumps over the lazy dog")));
+		const FGeneric Edited(FString(TEXT("The quick red fox jumps over the lazy dog")));
+		FGenericPatch TextPatch = FGenericPatch::Diff(Long, Edited);
+		TestTrue(TEXT("Text patch carries the changed span"), TextPatch.GetPayloadSize() < (int32)(Edited.GetStringData().Len() * sizeof(TCHAR)));
+		FGeneric TextReplica = Long;
+		TestTrue(TEXT("Text patch applies"), TextPatch.Apply(TextReplica));
+		TestEqual(TEXT("Patched text value"), TextReplica.As<FString>(), FString(TEXT("The quick red fox jumps over the lazy dog")));
+
+		FGeneric Retyped = FGeneric(7);
+		TestTrue(TEXT("Patch across types"), FGenericPatch::Diff(Retyped, Long).Apply(Retyped));
+		TestTrue(TEXT("Patched to the other type"), Retyped == Long);
+		FGeneric Blueprint = From;
+		TestTrue(TEXT("Blueprint patch"), UGenericStatics::ApplyGenericPatch(Blueprint, UGenericStatics::MakeGenericPatch(From, To)) && Blueprint == To);
+
+		// Types are compared by value, not by the property that wrote them
+		FHitResult Hit;
+		FGeneric BoneA;
+		FGeneric BoneB;
+		BoneA.Set(&Hit.BoneName, FHitResult::StaticStruct()->FindPropertyByName(GET_MEMBER_NAME_CHECKED(FHitResult, BoneName)));
+		BoneB.Set(&Hit.MyBoneName, FHitResult::StaticStruct()->FindPropertyByName(GET_MEMBER_NAME_CHECKED(FHitResult, MyBoneName)));
+		TestTrue(TEXT("Same type through two properties"), FGenericPatch::HoldSameType(BoneA, BoneB));
+		const FGeneric UnknownA;
+		const FGeneric UnknownB;
+		TestFalse(TEXT("Unknown types never match"), FGenericPatch::HoldSameType(UnknownA, UnknownB));
+	}
+
+	// Test 48: Version Stamps and Dirty Slots
+	{
+		FGeneric Value(1);
+		const uint32 Initial = Value.GetVersion();
+		Value = 2;
+		TestTrue(TEXT("In place assign bumps the version"), Value.GetVersion() != Initial);
+		const uint32 AfterAssign = Value.GetVersion();
+		TestEqual(TEXT("Read value"), Value.As<int32>(), 2);
+		TestEqual(TEXT("Reads keep the version"), Value.GetVersion(), AfterAssign);
+		Value = FString(TEXT("Text"));
+		TestTrue(TEXT("Retyping bumps the version"), Value.GetVersion() != AfterAssign);
+		const uint32 AfterRetype = Value.GetVersion();
+		Value.Clear();
+		TestTrue(TEXT("Clear bumps the version"), Value.GetVersion() != AfterRetype);
+		const uint32 AfterClear = Value.GetVersion();
+		Value = FGeneric(FVector(1, 2, 3));
+		TestTrue(TEXT("Assignment bumps the version"), Value.GetVersion() != AfterClear);
+
+		FGeneric Transform = FTransform(FRotator::ZeroRotator, FVector(1, 2, 3));
+		const uint32 BeforeField = Transform.GetVersion();
+		Transform.SetField(FGenericFieldPath::Find(TBaseStructure<FTransform>::Get(), TEXT("Translation.X")), 5.0f);
+		TestTrue(TEXT("Field write bumps the version"), Transform.GetVersion() != BeforeField);
+		const uint32 BeforeRead = Transform.GetVersion();
+		Transform.GetPlainData();
+		TestEqual(TEXT("Reading plain data keeps the version"), Transform.GetVersion(), BeforeRead);
+		Transform.GetMutablePlainData();
+		TestTrue(TEXT("Mutable plain data access bumps the version"), Transform.GetVersion() != BeforeRead);
+
+		FGenericBag Bag;
+		static const FGenericBagKey HealthKey(TEXT("Health"));
+		static const FGenericBagKey NameKey(TEXT("Name"));
+		Bag.SetValue(HealthKey, 100.f);
+		Bag.SetValue(NameKey, FString(TEXT("Alice")));
+		TestTrue(TEXT("Written slots are dirty"), Bag.IsDirty(HealthKey) && Bag.IsDirty(NameKey));
+		Bag.ClearDirty();
+		const uint32 BagVersion = Bag.GetVersion();
+		TestFalse(TEXT("Clean after ClearDirty"), Bag.IsDirty(HealthKey) || Bag.IsDirty(NameKey));
+		Bag.SetValue(HealthKey, 50.f);
+		TestTrue(TEXT("Only the written slot is dirty"), Bag.IsDirty(HealthKey) && !Bag.IsDirty(NameKey));
+		TestTrue(TEXT("Bag write bumps the version"), Bag.GetVersion() != BagVersion);
+		Bag.ClearDirty();
+		Bag.SetValue(TEXT("Mana"), 10);
+		TestTrue(TEXT("Dirty bits survive a reshape"), Bag.IsDirty(TEXT("Mana")) && !Bag.IsDirty(HealthKey) && !Bag.IsDirty(NameKey));
+		TestEqual(TEXT("One bit per slot"), Bag.GetDirtySlots().Num(), Bag.Num());
+		Bag.ClearDirty();
+		*Bag.FindValue<FString>(NameKey) = TEXT("Bob");
+		TestTrue(TEXT("Mutable access marks dirty"), Bag.IsDirty(NameKey));
+		TestEqual(TEXT("Blueprint version"), UGenericStatics::GetVersion(Value), (int32)Value.GetVersion());
+	}
+
+	// Test 49: Observable Bags
+	{
+		FGenericObservableBag Stats;
+		int32 HealthCalls = 0;
+		int32 AllCalls = 0;
+		TArray<FName> LastKeys;
+		Stats.Subscribe({ TEXT("Health") }, FGenericBagChangedDelegate::CreateLambda([&HealthCalls](const FGenericObservableBag&, TArrayView<const FName>) { ++HealthCalls; }));
+		const FDelegateHandle AllHandle = Stats.Subscribe({}, FGenericBagChangedDelegate::CreateLambda([&AllCalls, &LastKeys](const FGenericObservableBag&, TArrayView<const FName> Keys)
+		{
+			++AllCalls;
+			LastKeys = TArray<FName>(Keys.GetData(), Keys.Num());
+		}));
+
+		for (int32 Index = 0; Index < 10; ++Index)
+		{
+			Stats.SetValue(TEXT("Health"), 100.f - Index);
+		}
+		Stats.SetValue(TEXT("Name"), FString(TEXT("Alice")));
+		TestEqual(TEXT("Writes are not delivered immediately"), AllCalls, 0);
+		TestEqual(TEXT("One call per listener"), Stats.Flush(), 2);
+		TestEqual(TEXT("Key listener called once"), HealthCalls, 1);
+		TestEqual(TEXT("Batch holds every changed key"), LastKeys.Num(), 2);
+		TestEqual(TEXT("Nothing left to deliver"), Stats.Flush(), 0);
+
+		Stats.SetValue(TEXT("Name"), FString(TEXT("Bob")));
+		Stats.Flush();
+		TestEqual(TEXT("Unwatched key skips the listener"), HealthCalls, 1);
+		TestEqual(TEXT("Watched key delivered"), AllCalls, 2);
+
+		Stats.Remove(TEXT("Health"));
+		Stats.Flush();
+		TestEqual(TEXT("Removal delivered"), HealthCalls, 2);
+
+		Stats.Unsubscribe(AllHandle);
+		TestEqual(TEXT("Listener removed"), Stats.GetNumListeners(), 1);
+		Stats.SetValue(TEXT("Name"), FString(TEXT("Carol")));
+		Stats.Flush();
+		TestEqual(TEXT("Removed listener not called"), AllCalls, 2);
+	}
+
+	// Test 50: Read-Only Tables
+	{
+		TMap<FName, FGeneric> Rows;
+		Rows.Add(TEXT("Damage"), FGeneric(12.5f));
+		Rows.Add(TEXT("Name"), FGeneric(FString(TEXT("Sword"))));
+		Rows.Add(TEXT("Offset"), FGeneric(FVector(1, 2, 3)));
+		Rows.Add(TEXT("Grip"), FGeneric(FTransform(FRotator(0, 90, 0), FVector(4, 5, 6))));
+		Rows.Add(TEXT("Empty"), FGeneric());
+
+		TArray<uint8> Blob;
+		FGenericTable::Write(Blob, Rows);
+		TArray<uint8> Again;
+		FGenericTable::Write(Again, Rows);
+		TestTrue(TEXT("Equal tables make equal blobs"), Blob == Again);
+
+		FGenericTable Table;
+		TestTrue(TEXT("Table opened"), Table.Open(MoveTemp(Blob)));
+		TestEqual(TEXT("Table rows"), Table.Num(), 5);
+		TestEqual(TEXT("Plain row read in place"), Table.Find(TEXT("Damage")).As<float>(), 12.5f);
+		TestEqual(TEXT("Row converted to another number"), Table.Find(TEXT("Damage")).As<double>(), 12.5);
+		TestEqual(TEXT("Text row read in place"), Table.Find(TEXT("Name")).As<FString>(), FString(TEXT("Sword")));
+		TestEqual(TEXT("Struct row read in place"), Table.Find(TEXT("Offset")).As<FVector>(), FVector(1, 2, 3));
+		TestEqual(TEXT("Keys are case-insensitive"), Table.Find(TEXT("offset")).As<FVector>(), FVector(1, 2, 3));
+		TestTrue(TEXT("Row keeps its type"), Table.Find(TEXT("Damage")).GetType() == Rows[TEXT("Damage")].GetValueProperty());
+		TestTrue(TEXT("Row copied to a generic"), Table.Find(TEXT("Grip")).ToGeneric() == Rows[TEXT("Grip")]);
+		TestTrue(TEXT("Empty row"), Table.Find(TEXT("Empty")).IsEmpty() && Table.FindIndex(TEXT("Empty")) != INDEX_NONE);
+		TestEqual(TEXT("Missing row"), Table.FindIndex(TEXT("Missing")), INDEX_NONE);
+		for (int32 Index = 0; Index < Table.Num(); ++Index)
+		{
+			TestEqual(TEXT("Every key found"), Table.FindIndex(Table.GetKey(Index)), Index);
+		}
+
+		TArray<uint8> Corrupt;
+		FGenericTable::Write(Corrupt, Rows);
+		Corrupt.RemoveAt(Corrupt.Num() - 16, 16);
+		FGenericTable Truncated;
+		TestFalse(TEXT("Truncated table refused"), Truncated.Open(MoveTemp(Corrupt)));
+
+		TArray<uint8> WideChars;
+		FGenericTable::Write(WideChars, Rows);
+		WideChars[2 * sizeof(int32)] = sizeof(TCHAR) * 2;
+		FGenericTable OtherPlatform;
+		AddExpectedError(TEXT("cannot be read on this platform"), EAutomationExpectedErrorFlags::Contains, 1);
+		TestFalse(TEXT("Table of another character size refused"), OtherPlatform.Open(MoveTemp(WideChars)));
+
+		const FString Filename = FPaths::CreateTempFilename(*FPaths::ProjectSavedDir(), TEXT("GenericTable"), TEXT(".bin"));
+		TestTrue(TEXT("Table written to file"), FGenericTable::WriteToFile(*Filename, Rows));
+		{
+			FGenericTable Mapped;
+			TestTrue(TEXT("Table file opened"), Mapped.Open(*Filename));
+			TestEqual(TEXT("Mapped row"), Mapped.Find(TEXT("Grip")).As<FTransform>().GetTranslation(), FVector(4, 5, 6));
+		}
+		IFileManager::Get().Delete(*Filename);
+
+		const FGeneric Source(FVector(7, 8, 9));
+		TestEqual(TEXT("View of a generic"), FGenericView(Source).As<FVector>(), FVector(7, 8, 9));
+
+		const int16 Untyped = -300;
+		const FGenericView UntypedView(TEXT(""), 0, (const uint8*)&Untyped, sizeof(Untyped));
+		TestEqual(TEXT("Untyped plain data converts by its size"), UntypedView.As<int32>(), -300);
+		TestEqual(TEXT("Untyped plain data is not copied into another type"), UntypedView.As<FIntPoint>(), FIntPoint::ZeroValue);
+	}
+
+	// Test 51: Streamed Sequences
+	{
+		auto MakeValue = [](int32 Index)
+		{
+			return Index % 7 == 0 ? FGeneric(FString::Printf(TEXT("Value %d"), Index)) : FGeneric(Index);
+		};
+		auto MatchesValue = [&MakeValue](const FGeneric& Value, int32 Index)
+		{
+			return Value == MakeValue(Index);
+		};
+		const int32 NumValues = 2000;
+
+		TArray<uint8> Bytes;
+		{
+			FMemoryWriter Ar(Bytes);
+			FGenericStreamWriter Writer(Ar, false, 1024);
+			for (int32 Index = 0; Index < NumValues; ++Index)
+			{
+				Writer.Add(MakeValue(Index));
+			}
+			TestTrue(TEXT("Stream closed"), Writer.Close());
+			TestEqual(TEXT("Values added"), Writer.Num(), (int64)NumValues);
+		}
+
+		TArray<uint8> BackgroundBytes;
+		{
+			FMemoryWriter Ar(BackgroundBytes);
+			FGenericStreamWriter Writer(Ar, true, 1024);
+			for (int32 Index = 0; Index < NumValues; ++Index)
+			{
+				Writer.Add(MakeValue(Index));
+			}
+		}
+		TestTrue(TEXT("Background writes make the same stream"), Bytes == BackgroundBytes);
+
+		{
+			FMemoryReader Ar(Bytes);
+			FGenericStreamReader Reader(Ar);
+			TestTrue(TEXT("Stream recognized"), Reader.IsValid());
+			FGeneric Value;
+			int32 NumRead = 0;
+			bool bAllMatch = true;
+			while (Reader.Next(Value))
+			{
+				bAllMatch &= MatchesValue(Value, NumRead++);
+			}
+			TestEqual(TEXT("Every value read"), NumRead, NumValues);
+			TestTrue(TEXT("Values read back"), bAllMatch);
+			TestFalse(TEXT("Clean end"), Reader.IsCorrupt());
+
+			TestTrue(TEXT("Seek to a record"), Reader.SeekToRecord(1234));
+			const FGenericStreamPosition Position = Reader.GetChunkPosition();
+			TestTrue(TEXT("Record after seek"), Reader.Next(Value) && MatchesValue(Value, 1234));
+			TestTrue(TEXT("Position at a chunk boundary"), Position.IsValid() && Position.RecordIndex <= 1234);
+			Reader.Next(Value);
+			Reader.Next(Value);
+			TestTrue(TEXT("Resume at the chunk"), Reader.Seek(Position));
+			TestTrue(TEXT("First record of the chunk"), Reader.Next(Value) && MatchesValue(Value, (int32)Position.RecordIndex));
+		}
+
+		// Damage the first record of the first chunk
+		Bytes[40] ^= 0xFF;
+		{
+			FMemoryReader Ar(Bytes);
+			FGenericStreamReader Reader(Ar);
+			FGeneric Value;
+			TestFalse(TEXT("Corrupt chunk not read"), Reader.Next(Value));
+			TestTrue(TEXT("Corruption reported"), Reader.IsCorrupt());
+			TestTrue(TEXT("Next chunk reached"), Reader.SkipChunk());
+			const int32 FirstIntact = (int32)Reader.GetRecordIndex();
+			TestTrue(TEXT("Values after the corrupt chunk"), FirstIntact > 0 && Reader.Next(Value) && MatchesValue(Value, FirstIntact));
+		}
+	}
+
 	// Final summary
 	AddInfo(TEXT("FGeneric comprehensive test completed successfully"));
 	return true;
@@ -0,0 +1,313 @@
+// Copyright Liquid Fish. All Rights Reserved.
+
+#include "Generic/Generic.h"
+#include "GenericPerfTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+
+static int32 GGenericPerfIterations = 2000;
+static FAutoConsoleVariableRef CVarGenericPerfIterations(
+	TEXT("generic.perf.iterations"),
+	GGenericPerfIterations,
+	TEXT("Iterations per operation in the MaidGame.Generic.Perf automation test."));
+
+static FString GGenericPerfBaseline;
+static FAutoConsoleVariableRef CVarGenericPerfBaseline(
+	TEXT("generic.perf.baseline"),
+	GGenericPerfBaseline,
+	TEXT("Baseline CSV for MaidGame.Generic.Perf. Empty uses Config/GenericPerfBaseline.csv of the project when present."));
+
+static float GGenericPerfTolerance = 1.5f;
+static FAutoConsoleVariableRef CVarGenericPerfTolerance(
+	TEXT("generic.perf.tolerance"),
+	GGenericPerfTolerance,
+	TEXT("Factor over the baseline time per operation at which MaidGame.Generic.Perf fails."));
+
+static int32 GGenericPerfWriteBaseline = 0;
+static FAutoConsoleVariableRef CVarGenericPerfWriteBaseline(
+	TEXT("generic.perf.writebaseline"),
+	GGenericPerfWriteBaseline,
+	TEXT("Overwrite the MaidGame.Generic.Perf baseline with the measured results instead of comparing."));
+
+namespace GenericPerf
+{
+	/** Differences below this are timer noise rather than regressions */
+	static constexpr double NoiseFloorNs = 20.0;
+
+	/** Side effect sink keeping the measured operations from being optimized away */
+	static volatile uint64 GSink = 0;
+	FORCENOINLINE static void Consume(uint64 Value) { GSink = GSink ^ Value; }
+
+	struct FResult
+	{
+		FString Case;
+		FString Op;
+		int32 Iterations = 0;
+		double NsPerOp = 0.0;
+	};
+
+	class FRunner
+	{
+	public:
+		explicit FRunner(int32 InIterations) : Iterations(FMath::Max(InIterations, 1)) {}
+
+		template<typename FuncType>
+		void Time(const FString& Case, const TCHAR* Op, FuncType&& Func)
+		{
+			for (int32 i = 0; i < FMath::Min(Iterations, 16); ++i)
+			{
+				Func();
+			}
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			for (int32 i = 0; i < Iterations; ++i)
+			{
+				Func();
+			}
+			const uint64 EndCycles = FPlatformTime::Cycles64();
+
+			FResult& Result = Results.AddDefaulted_GetRef();
+			Result.Case = Case;
+			Result.Op = Op;
+			Result.Iterations = Iterations;
+			Result.NsPerOp = (double)(EndCycles - StartCycles) * FPlatformTime::GetSecondsPerCycle64() * 1e9 / Iterations;
+		}
+
+		const int32 Iterations;
+		TArray<FResult> Results;
+	};
+
+	template<typename T> static void MakeSample(T& Out)
+	{
+		if constexpr (std::is_trivially_copyable_v<T>)
+		{
+			FMemory::Memzero(&Out, sizeof(T));
+		}
+	}
+	static void MakeSample(bool& Out) { Out = true; }
+	static void MakeSample(FString& Out) { Out = TEXT("Generic benchmark payload"); }
+	static void MakeSample(FName& Out) { Out = TEXT("GenericBenchmarkName"); }
+	static void MakeSample(UObject*& Out) { Out = GetTransientPackage(); }
+	static void MakeSample(TSubclassOf<UObject>& Out) { Out = UObject::StaticClass(); }
+	static void MakeSample(TSoftObjectPtr<UObject>& Out) { Out = GetTransientPackage(); }
+	static void MakeSample(TSoftClassPtr<UObject>& Out) { Out = UObject::StaticClass(); }
+	static void MakeSample(FTransform& Out) { Out = FTransform(FRotator(10, 20, 30), FVector(1, 2, 3)); }
+	static void MakeSample(FGenericPerfStruct& Out)
+	{
+		Out.Label = TEXT("Generic benchmark struct");
+		Out.Count = 42;
+		Out.Location = FVector(1, 2, 3);
+		Out.Tags = { TEXT("Alpha"), TEXT("Beta"), TEXT("Gamma") };
+	}
+	template<typename T> static void MakeSample(TArray<T>& Out)
+	{
+		Out.SetNum(16);
+		for (T& Element : Out)
+		{
+			MakeSample(Element);
+		}
+	}
+	static void MakeSample(TMap<FName, int32>& Out)
+	{
+		for (int32 i = 0; i < 16; ++i)
+		{
+			Out.Add(FName(TEXT("Key"), i), i);
+		}
+	}
+	static void MakeSample(TMap<FString, FVector>& Out)
+	{
+		for (int32 i = 0; i < 16; ++i)
+		{
+			Out.Add(FString::Printf(TEXT("Key_%d"), i), FVector(i, i, i));
+		}
+	}
+	static void MakeSample(TSet<FName>& Out)
+	{
+		for (int32 i = 0; i < 16; ++i)
+		{
+			Out.Add(FName(TEXT("Element"), i));
+		}
+	}
+
+	/** Operations shared by every stored type */
+	static void TimeCommon(FRunner& Runner, const FString& Case, const FGeneric& Generic)
+	{
+		const FGeneric Other = Generic;
+		Runner.Time(Case, TEXT("Copy"), [&]() { FGeneric Copy(Generic); Consume(Copy.IsEmpty()); });
+
+		FGeneric MoveA = Generic;
+		FGeneric MoveB;
+		Runner.Time(Case, TEXT("Move"), [&]() { MoveB = MoveTemp(MoveA); MoveA = MoveTemp(MoveB); });
+
+		Runner.Time(Case, TEXT("Hash"), [&]() { Consume(GetTypeHash(Generic)); });
+		Runner.Time(Case, TEXT("Equality"), [&]() { Consume(Generic == Other); });
+	}
+
+	/** Time a type reachable through the typed FGeneric assignment and As<> */
+	template<typename CppType>
+	static void TimeTyped(FRunner& Runner, const FString& Case, const FProperty* Property)
+	{
+		CppType Value;
+		MakeSample(Value);
+
+		FGeneric Generic;
+		Runner.Time(Case, TEXT("Set"), [&]() { Generic = Value; });
+
+		CppType Out = Value;
+		Runner.Time(Case, TEXT("Get"), [&]() { Generic.Get(&Out, Property); });
+		Runner.Time(Case, TEXT("As"), [&]() { const CppType Result = Generic.As<CppType>(); Consume(sizeof(Result)); });
+
+		TimeCommon(Runner, Case, Generic);
+	}
+
+	/** Time a type only reachable through its property */
+	template<typename CppType>
+	static void TimeProperty(FRunner& Runner, const FString& Case, const FProperty* Property)
+	{
+		CppType Value;
+		MakeSample(Value);
+
+		FGeneric Generic;
+		Runner.Time(Case, TEXT("Set"), [&]() { Generic.Set(&Value, Property); });
+
+		CppType Out = Value;
+		Runner.Time(Case, TEXT("Get"), [&]() { Generic.Get(&Out, Property); });
+
+		TimeCommon(Runner, Case, Generic);
+	}
+
+	static FString FormatCsv(const TArray<FResult>& Results)
+	{
+		FString Csv = TEXT("Case,Op,Iterations,NsPerOp\n");
+		for (const FResult& Result : Results)
+		{
+			Csv += FString::Printf(TEXT("\"%s\",%s,%d,%.2f\n"), *Result.Case, *Result.Op, Result.Iterations, Result.NsPerOp);
+		}
+		return Csv;
+	}
+
+	static FString FormatJson(const TArray<FResult>& Results)
+	{
+		FString Json = TEXT("{\n\t\"results\": [\n");
+		for (int32 i = 0; i < Results.Num(); ++i)
+		{
+			const FResult& Result = Results[i];
+			Json += FString::Printf(TEXT("\t\t{ \"case\": \"%s\", \"op\": \"%s\", \"iterations\": %d, \"nsPerOp\": %.2f }%s\n"),
+				*Result.Case, *Result.Op, Result.Iterations, Result.NsPerOp, i + 1 < Results.Num() ? TEXT(",") : TEXT(""));
+		}
+		Json += TEXT("\t]\n}\n");
+		return Json;
+	}
+
+	/** Parse a CSV written by FormatCsv into "Case/Op" -> ns per op */
+	static TMap<FString, double> ParseBaseline(const FString& Csv)
+	{
+		TMap<FString, double> Baseline;
+		TArray<FString> Lines;
+		Csv.ParseIntoArrayLines(Lines);
+		for (int32 i = 1; i < Lines.Num(); ++i)
+		{
+			// Case names may contain commas, so split from the end
+			FString CaseOpIterations, CaseOp, Case, Op, Iterations, NsPerOp;
+			if (Lines[i].Split(TEXT(","), &CaseOpIterations, &NsPerOp, ESearchCase::CaseSensitive, ESearchDir::FromEnd)
+				&& CaseOpIterations.Split(TEXT(","), &CaseOp, &Iterations, ESearchCase::CaseSensitive, ESearchDir::FromEnd)
+				&& CaseOp.Split(TEXT(","), &Case, &Op, ESearchCase::CaseSensitive, ESearchDir::FromEnd))
+			{
+				Baseline.Add(Case.TrimQuotes() + TEXT("/") + Op, FCString::Atod(*NsPerOp));
+			}
+		}
+		return Baseline;
+	}
+}
+
+/**
+ * Timing suite for FGeneric, reporting nanoseconds per operation
+ *
+ * Measures Set, Get, As, copy, move, hash and equality for every type of GenericProperties.inl plus maps,
+ * sets and user structs. Results are written to Saved/Automation/GenericPerf as CSV and JSON. When a
+ * baseline CSV is found (generic.perf.baseline), any operation slower than baseline * generic.perf.tolerance
+ * fails the test. Runs headless, e.g.
+ *   UnrealEditor-Cmd <Project> -nullrhi -unattended -ExecCmds="Automation RunTests MaidGame.Generic.Perf;Quit"
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenericPerfTest, "MaidGame.Generic.Perf",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+	bool FGenericPerfTest::RunTest(const FString& Parameters)
+{
+	using namespace GenericPerf;
+	FRunner Runner(GGenericPerfIterations);
+
+	// Types of GenericProperties.inl
+	{
+#pragma push_macro("GENERIC_PROPERTY")
+#pragma push_macro("GENERIC_PROPERTY_OBJECT")
+#define GENERIC_PROPERTY(CppType, Name) \
+		TimeTyped<CppType>(Runner, TEXT(#CppType), FGenericPropJunkPrivate::Get(CppType()));
+#define GENERIC_PROPERTY_OBJECT(CppType, Name) \
+		TimeTyped<CppType>(Runner, TEXT(#CppType), FGenericPropJunkPrivate::Get(static_cast<CppType>(nullptr)));
+		// END DEFINE GENERIC_PROPERTY
+#include "Generic/GenericProperties.inl"
+#pragma pop_macro("GENERIC_PROPERTY")
+#pragma pop_macro("GENERIC_PROPERTY_OBJECT")
+	}
+
+	// Containers and user structs
+	{
+		const UScriptStruct* JunkStruct = FGenericPerfJunkPrivate::StaticStruct();
+		TimeProperty<TMap<FName, int32>>(Runner, TEXT("TMap<FName, int32>"),
+			JunkStruct->FindPropertyByName(GET_MEMBER_NAME_CHECKED(FGenericPerfJunkPrivate, NameToInt)));
+		TimeProperty<TMap<FString, FVector>>(Runner, TEXT("TMap<FString, FVector>"),
+			JunkStruct->FindPropertyByName(GET_MEMBER_NAME_CHECKED(FGenericPerfJunkPrivate, StringToVector)));
+		TimeProperty<TSet<FName>>(Runner, TEXT("TSet<FName>"),
+			JunkStruct->FindPropertyByName(GET_MEMBER_NAME_CHECKED(FGenericPerfJunkPrivate, NameSet)));
+		TimeProperty<TArray<FGenericPerfStruct>>(Runner, TEXT("TArray<FGenericPerfStruct>"),
+			JunkStruct->FindPropertyByName(GET_MEMBER_NAME_CHECKED(FGenericPerfJunkPrivate, StructArray)));
+		TimeTyped<FGenericPerfStruct>(Runner, TEXT("FGenericPerfStruct"),
+			JunkStruct->FindPropertyByName(GET_MEMBER_NAME_CHECKED(FGenericPerfJunkPrivate, Struct)));
+	}
+
+	// Reports
+	const FString OutputDir = FPaths::AutomationDir() / TEXT("GenericPerf");
+	const FString Csv = FormatCsv(Runner.Results);
+	FFileHelper::SaveStringToFile(Csv, *(OutputDir / TEXT("GenericPerf.csv")));
+	FFileHelper::SaveStringToFile(FormatJson(Runner.Results), *(OutputDir / TEXT("GenericPerf.json")));
+	AddInfo(FString::Printf(TEXT("Generic perf: %d measurements written to %s"), Runner.Results.Num(), *OutputDir));
+
+	// Regression gate
+	const FString BaselinePath = GGenericPerfBaseline.IsEmpty()
+		? FPaths::ProjectConfigDir() / TEXT("GenericPerfBaseline.csv")
+		: GGenericPerfBaseline;
+	if (GGenericPerfWriteBaseline)
+	{
+		TestTrue(TEXT("Write perf baseline"), FFileHelper::SaveStringToFile(Csv, *BaselinePath));
+		AddInfo(FString::Printf(TEXT("Generic perf: baseline written to %s"), *BaselinePath));
+		return true;
+	}
+
+	FString BaselineCsv;
+	if (!FFileHelper::LoadFileToString(BaselineCsv, *BaselinePath))
+	{
+		AddInfo(FString::Printf(TEXT("Generic perf: no baseline at %s, regression gate skipped"), *BaselinePath));
+		return true;
+	}
+
+	const TMap<FString, double> Baseline = ParseBaseline(BaselineCsv);
+	const double Tolerance = FMath::Max((double)GGenericPerfTolerance, 1.0);
+	for (const FResult& Result : Runner.Results)
+	{
+		const double* BaselineNs = Baseline.Find(Result.Case + TEXT("/") + Result.Op);
+		if (BaselineNs && Result.NsPerOp > *BaselineNs * Tolerance && Result.NsPerOp - *BaselineNs > NoiseFloorNs)
+		{
+			AddError(FString::Printf(TEXT("Generic perf regression: %s %s takes %.2f ns/op, baseline %.2f ns/op"),
+				*Result.Case, *Result.Op, Result.NsPerOp, *BaselineNs));
+		}
+	}
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS